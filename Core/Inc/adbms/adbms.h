@@ -20,6 +20,8 @@
 #define NUM_PACK_AUX_VOLTAGES       10
 #define NUM_PACK_RD_AUX_VOLTAGES    6
 
+#define NUM_COMM_BYTES              3
+
 #define REGISTER_BYTE0      0
 #define REGISTER_BYTE1      1
 #define REGISTER_BYTE2      2
@@ -27,6 +29,8 @@
 #define REGISTER_BYTE4      4
 #define REGISTER_BYTE5      5
 
+#define STATUS_CHANGED_PACK_MONITOR     (1UL << 31)
+
 #define DEVICE_ID_MASK      0x0E
 #define CELL_MONITOR_ID     0x06
 #define PACK_MONITOR_ID     0x0C
@@ -56,6 +60,18 @@ typedef enum
     COMPARE_THRESHOLD_25_mV,
     COMPARE_THRESHOLD_40_mV
 } COMPARISON_THRESHOLD_E;
+
+typedef enum
+{
+    LPCM_PERIOD_1_S = 0,
+    LPCM_PERIOD_2_S,
+    LPCM_PERIOD_4_S,
+    LPCM_PERIOD_8_S,
+    LPCM_PERIOD_12_S,
+    LPCM_PERIOD_16_S,
+    LPCM_PERIOD_32_S,
+    LPCM_PERIOD_60_S
+} LPCM_PERIOD_E;
 typedef enum
 {
     AUX_SOAK_DISABLED =     0x0,
@@ -285,6 +301,39 @@ typedef enum
     NUM_PACK_ADCS
 } PACK_ADC_TYPE_E;
 
+typedef enum
+{
+    STATUS_GROUP_A = 0,
+    STATUS_GROUP_B,
+    STATUS_GROUP_C,
+    STATUS_GROUP_D,
+    STATUS_GROUP_E,
+    NUM_STATUS_GROUPS
+} STATUS_REGISTER_GROUP_E;
+
+// Initial COMM control codes, sent before each data byte
+typedef enum
+{
+    ICOM_I2C_BLANK = 0x0,
+    ICOM_I2C_STOP = 0x1,
+    ICOM_I2C_START = 0x6,
+    ICOM_I2C_NO_TRANSMIT = 0x7,
+    ICOM_SPI_CSB_LOW = 0x8,
+    ICOM_SPI_CSB_HIGH = 0x9,
+    ICOM_SPI_CSB_FALLING_EDGE = 0xA,
+    ICOM_SPI_NO_TRANSMIT = 0xF
+} COMM_ICOM_E;
+
+// Final COMM control codes, sent after each data byte
+typedef enum
+{
+    FCOM_I2C_MASTER_ACK = 0x0,
+    FCOM_I2C_MASTER_NACK = 0x8,
+    FCOM_I2C_MASTER_NACK_STOP = 0x9,
+    FCOM_SPI_CSB_LOW = 0x0,
+    FCOM_SPI_CSB_HIGH = 0x9
+} COMM_FCOM_E;
+
 /* ==================================================================== */
 /* ============================== STRUCTS============================== */
 /* ==================================================================== */
@@ -384,8 +433,9 @@ typedef struct __attribute__((packed))
 
 typedef struct __attribute__((packed))
 {
-    uint8_t cellUnderVoltageFault[NUM_CELLS_PER_CELL_MONITOR];
-    uint8_t cellOverVoltageFault[NUM_CELLS_PER_CELL_MONITOR];
+    // Bit n set when cell n crossed the config B threshold
+    uint16_t cellUnderVoltageFlags;
+    uint16_t cellOverVoltageFlags;
     uint8_t oscillatorCounter;
 } ADBMS_StatusDCellMonitor;
 
@@ -407,6 +457,58 @@ typedef struct __attribute__((packed))
 } ADBMS_StatusECellMonitor;
 
 typedef struct __attribute__((packed))
+{
+    // Byte 0
+    LPCM_PERIOD_E monitoringPeriod : 3;
+    uint8_t manualHeartbeat : 1;
+    uint8_t heartbeatDirection : 1;
+    uint8_t bottomDevice : 1;
+    uint8_t reserved1 : 2;
+
+    // Byte 1
+    uint8_t numDevices;
+
+    // Byte 2-3
+    uint16_t cellMonitorMask;
+
+    // Byte 4-5
+    uint16_t gpioMonitorMask : 10;
+    uint16_t reserved2 : 6;
+} ADBMS_LpcmConfigCellMonitor;
+
+typedef struct
+{
+    float cellUnderVoltage;
+    float cellOverVoltage;
+    float cellDeltaVoltage;
+    float gpioUnderVoltage;
+    float gpioOverVoltage;
+    float gpioDeltaVoltage;
+} ADBMS_LpcmThresholdCellMonitor;
+
+typedef struct __attribute__((packed))
+{
+    // Byte 0
+    uint8_t cellUnderVoltage : 1;
+    uint8_t cellOverVoltage : 1;
+    uint8_t cellDelta : 1;
+    uint8_t gpioUnderVoltage : 1;
+    uint8_t gpioOverVoltage : 1;
+    uint8_t gpioDelta : 1;
+    uint8_t heartbeatFault : 1;
+    uint8_t reserved1 : 1;
+} ADBMS_LpcmFlagsCellMonitor;
+
+typedef struct
+{
+    COMM_ICOM_E initialControl[NUM_COMM_BYTES];
+    uint8_t data[NUM_COMM_BYTES];
+    COMM_FCOM_E finalControl[NUM_COMM_BYTES];
+} ADBMS_CommCellMonitor;
+
+// Register groups are packed images of the device registers
+// Data containers are left unpacked so float members stay word aligned
+typedef struct
 {
     ADBMS_ConfigACellMonitor configGroupA;
     ADBMS_ConfigBCellMonitor configGroupB;
@@ -417,20 +519,26 @@ typedef struct __attribute__((packed))
     ADBMS_StatusDCellMonitor statusGroupD;
     ADBMS_StatusECellMonitor statusGroupE;
 
-    float cellVoltage[NUM_CELLS_PER_CELL_MONITOR];
+    // Redundant results are only compared by the diagnostics, the published results are in ADBMS_VoltageData and ADBMS_AuxData
     float redundantCellVoltage[NUM_CELLS_PER_CELL_MONITOR];
-
-    float auxVoltage[NUM_CELL_MONITOR_GPIO];
     float reduntantAuxVoltage[NUM_CELL_MONITOR_GPIO];
 
-    float hvSupplyVoltage;
-    float switch1Voltage;
-
     float dischargePWM[NUM_CELLS_PER_CELL_MONITOR];
 
     uint8_t serialId[REGISTER_SIZE_BYTES];
     uint8_t retentionRegister[REGISTER_SIZE_BYTES];
 
+    // Low power cell monitoring
+    ADBMS_LpcmConfigCellMonitor lpcmConfig;
+    ADBMS_LpcmThresholdCellMonitor lpcmThreshold;
+    ADBMS_LpcmFlagsCellMonitor lpcmFlags;
+
+    // I2C/SPI pass-through, written before STCOMM and holding received bytes after RDCOMM
+    ADBMS_CommCellMonitor commGroup;
+
+    // Raw copy of the last status register frames, used to skip decoding unchanged groups
+    uint8_t statusRegisterMirror[NUM_STATUS_GROUPS][REGISTER_SIZE_BYTES];
+
 } ADBMS_CellMonitorData;
 
 typedef struct __attribute__((packed))
@@ -612,7 +720,7 @@ typedef struct __attribute__((packed))
 
 } ADBMS_StatusEPackMonitor;
 
-typedef struct __attribute__((packed))
+typedef struct
 {
     float overCurrentAdc1;
     float overCurrentAdc2;
@@ -621,7 +729,7 @@ typedef struct __attribute__((packed))
     float overCurrentAdc3Min;
 } ADBMS_OvercurrentStatusPackMonitor;
 
-typedef struct __attribute__((packed))
+typedef struct
 {
     ADBMS_ConfigAPackMonitor configGroupA;
     ADBMS_ConfigBPackMonitor configGroupB;
@@ -632,6 +740,22 @@ typedef struct __attribute__((packed))
     ADBMS_StatusDPackMonitor statusGroupD;
     ADBMS_StatusEPackMonitor statusGroupE;
 
+    float redundantAuxVoltage[NUM_PACK_RD_AUX_VOLTAGES];
+
+    uint8_t serialId[REGISTER_SIZE_BYTES];
+
+    // Raw copy of the last status register frames, used to skip decoding unchanged groups
+    uint8_t statusRegisterMirror[NUM_STATUS_GROUPS][REGISTER_SIZE_BYTES];
+} ADBMS_PackMonitorData;
+
+// Results of the cell voltage reads, the pack monitor current and battery voltage registers are read alongside
+typedef struct
+{
+    float cellVoltage[NUM_CELLS_PER_CELL_MONITOR];
+} ADBMS_VoltageCellMonitor;
+
+typedef struct
+{
     int32_t currentAdc1uV;
     int32_t currentAdc2uV;
 
@@ -644,22 +768,55 @@ typedef struct __attribute__((packed))
     int32_t batteryVoltageAccumulator1uV;
     int32_t batteryVoltageAccumulator2uV;
 
+    ADBMS_OvercurrentStatusPackMonitor overcurrentStatusGroup;
+} ADBMS_VoltagePackMonitor;
+
+typedef struct
+{
+    ADBMS_VoltagePackMonitor packMonitor;
+    ADBMS_VoltageCellMonitor cellMonitor[8];
+} ADBMS_VoltageData;
+
+// Results of the aux voltage reads
+typedef struct
+{
+    float auxVoltage[NUM_CELL_MONITOR_GPIO];
+
+    float hvSupplyVoltage;
+    float switch1Voltage;
+} ADBMS_AuxCellMonitor;
+
+typedef struct
+{
     float auxVoltage[NUM_PACK_AUX_VOLTAGES];
-    float redundantAuxVoltage[NUM_PACK_RD_AUX_VOLTAGES];
 
     float referenceVoltage;
     float redundantReferenceVoltage;
+} ADBMS_AuxPackMonitor;
 
-    ADBMS_OvercurrentStatusPackMonitor overcurrentStatusGroup;
-
-    uint8_t serialId[REGISTER_SIZE_BYTES];
-} ADBMS_PackMonitorData;
+typedef struct
+{
+    ADBMS_AuxPackMonitor packMonitor;
+    ADBMS_AuxCellMonitor cellMonitor[8];
+} ADBMS_AuxData;
 
 typedef struct
 {
     ADBMS_PackMonitorData packMonitor;
     ADBMS_CellMonitorData cellMonitor[8];
     CHAIN_INFO_S chainInfo;
+
+    // Conversion results are decoded into the buffers these point at, so the owner can double buffer them
+    // Everything else here is device state that carries over from one read to the next
+    ADBMS_VoltageData *voltageData;
+    ADBMS_AuxData *auxData;
+
+    // Per status group bitmask of devices whose register bytes changed on the last read
+    // Bit n is set for cell monitor n, STATUS_CHANGED_PACK_MONITOR is set for the pack monitor
+    uint32_t statusGroupChanged[NUM_STATUS_GROUPS];
+
+    // Per status group bitmask, in chain order, of frames whose mirror holds a good read
+    uint32_t statusMirrorValid[NUM_STATUS_GROUPS];
 } ADBMS_BatteryData;
 
 /* ==================================================================== */
@@ -698,6 +855,8 @@ TRANSACTION_STATUS_E clearAllVoltageRegisters(ADBMS_BatteryData *adbmsData);
 
 TRANSACTION_STATUS_E clearAllFlags(ADBMS_BatteryData *adbmsData);
 
+TRANSACTION_STATUS_E clearCellAdcMismatchFlags(ADBMS_BatteryData *adbmsData);
+
 TRANSACTION_STATUS_E readSerialId(ADBMS_BatteryData *adbmsData);
 
 TRANSACTION_STATUS_E writePwmRegisters(ADBMS_BatteryData *adbmsData);
@@ -712,10 +871,16 @@ TRANSACTION_STATUS_E writeConfigA(ADBMS_BatteryData * adbmsData);
 
 TRANSACTION_STATUS_E readConfigA(ADBMS_BatteryData *adbmsData);
 
+uint8_t encodeOvercurrentThreshold(float thresholdMv, OVERCURRENT_GAIN_CONTROL_SETTING_E gainSetting);
+
 TRANSACTION_STATUS_E writeConfigB(ADBMS_BatteryData *adbmsData);
 
 TRANSACTION_STATUS_E readConfigB(ADBMS_BatteryData *adbmsData);
 
+TRANSACTION_STATUS_E verifyConfigBThresholds(ADBMS_BatteryData *adbmsData, uint32_t *mismatchMask);
+
+void invalidateStatusMirror(ADBMS_BatteryData *adbmsData);
+
 TRANSACTION_STATUS_E readStatusA(ADBMS_BatteryData *adbmsData);
 
 TRANSACTION_STATUS_E readStatusB(ADBMS_BatteryData *adbmsData);
@@ -726,6 +891,14 @@ TRANSACTION_STATUS_E readStatusD(ADBMS_BatteryData *adbmsData);
 
 TRANSACTION_STATUS_E readStatusE(ADBMS_BatteryData *adbmsData);
 
+TRANSACTION_STATUS_E readCellOvUvFlags(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E clearCellOvUvFlags(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E readOvercurrentFaults(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E clearOvercurrentFaults(ADBMS_BatteryData *adbmsData);
+
 TRANSACTION_STATUS_E readCellVoltages(ADBMS_BatteryData *adbmsData, CELL_VOLTAGE_TYPE_E cellVoltageType);
 
 TRANSACTION_STATUS_E readRedundantCellVoltages(ADBMS_BatteryData *adbmsData);
@@ -734,4 +907,30 @@ TRANSACTION_STATUS_E readAuxVoltages(ADBMS_BatteryData * adbmsData);
 
 TRANSACTION_STATUS_E readRedundantAuxVoltages(ADBMS_BatteryData * adbmsData);
 
+TRANSACTION_STATUS_E readPackCurrent(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E readPackCurrentAccumulators(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E readPackLinkVoltages(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E enableLpcm(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E disableLpcm(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E sendLpcmHeartbeat(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E writeLpcmConfig(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E writeLpcmThresholds(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E readLpcmFlags(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E clearLpcmFlags(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E writeCommRegisters(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E startCommTransfer(ADBMS_BatteryData *adbmsData);
+
+TRANSACTION_STATUS_E readCommRegisters(ADBMS_BatteryData *adbmsData);
+
 #endif /* INC_ADBMS_H_ */
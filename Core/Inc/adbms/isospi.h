@@ -118,6 +118,16 @@ void activatePort(uint32_t numDevs, PORT_E port, uint32_t usDelay);
  */
 TRANSACTION_STATUS_E commandChain(uint16_t command, CHAIN_INFO_S *chainInfo, COMMAND_TYPE_E commandType);
 
+/**
+ * @brief Send a command on the device daisy chain followed by extra clock cycles
+ * @param command Command code to send
+ * @param chainInfo Chain data struct
+ * @param commandType The type of command to determine which devices will recognize the command
+ * @param numClockBytes Number of dummy bytes clocked after the command
+ * @return Transaction status error code
+ */
+TRANSACTION_STATUS_E clockedCommandChain(uint16_t command, CHAIN_INFO_S *chainInfo, COMMAND_TYPE_E commandType, uint32_t numClockBytes);
+
 /**
  * @brief Write to device registers on the device daisy chain
  * @param command Command code to send
@@ -24,6 +24,13 @@
 #define UNDERVOLTAGE_FAULT_ALERT_SET_TIME_MS      5000
 #define UNDERVOLTAGE_FAULT_ALERT_CLEAR_TIME_MS    5000
 
+// The on chip comparators check every conversion, only a few cycles of debounce are needed
+#define HARDWARE_OVERVOLTAGE_FAULT_ALERT_SET_TIME_MS      100
+#define HARDWARE_OVERVOLTAGE_FAULT_ALERT_CLEAR_TIME_MS    5000
+
+#define HARDWARE_UNDERVOLTAGE_FAULT_ALERT_SET_TIME_MS     100
+#define HARDWARE_UNDERVOLTAGE_FAULT_ALERT_CLEAR_TIME_MS   5000
+
 #define MAX_CELL_IMBALANCE_V                      0.1f
 #define CELL_IMBALANCE_ALERT_SET_TIME_MS          1000
 #define CELL_IMBALANCE_ALERT_CLEAR_TIME_MS        1000
@@ -57,6 +64,9 @@
 #define PACK_OVERCURRENT_FAULT_ALERT_SET_TIME_MS   500
 #define PACK_OVERCURRENT_FAULT_ALERT_CLEAR_TIME_MS 500
 
+#define OPEN_WIRE_ALERT_SET_TIME_MS     1000
+#define OPEN_WIRE_ALERT_CLEAR_TIME_MS   1000
+
 
 
 
@@ -0,0 +1,122 @@
+#ifndef INC_BURST_CAPTURE_H_
+#define INC_BURST_CAPTURE_H_
+
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+#include "telemetryTask.h"
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+// Ring buffer memory, one frame per telemetry cycle
+// A full rate cycle fits the current samples as taken, slower cycles are decimated to fit, must be even
+#define BURST_CAPTURE_NUM_FRAMES            24
+#define BURST_CURRENT_SAMPLES_PER_FRAME     40
+
+// Default capture window around the trigger frame
+#define BURST_DEFAULT_PRE_TRIGGER_FRAMES    15
+#define BURST_DEFAULT_POST_TRIGGER_FRAMES   8
+
+// Frames handed out per drain call, the drain task period sets the drain rate
+#define BURST_DRAIN_FRAMES_PER_CALL         1
+
+// Compact sample scaling
+#define BURST_CELL_VOLTAGE_LSB_V            0.0002f
+#define BURST_PACK_VOLTAGE_LSB_V            0.1f
+#define BURST_CURRENT_LSB_A                 0.1f
+#define BURST_TEMP_LSB_C                    0.1f
+
+/* ==================================================================== */
+/* ========================= ENUMERATED TYPES========================== */
+/* ==================================================================== */
+
+typedef enum
+{
+    BURST_TRIGGER_OVERCURRENT = 0,
+    BURST_TRIGGER_CELL_SAG,
+    BURST_TRIGGER_ALERT,
+    BURST_TRIGGER_MANUAL,
+    NUM_BURST_TRIGGERS
+} BURST_TRIGGER_E;
+
+typedef enum
+{
+    BURST_TEMP_MAX_CELL = 0,
+    BURST_TEMP_MIN_CELL,
+    BURST_TEMP_SHUNT_ELEMENT,
+    BURST_TEMP_PACK_MON_BOARD,
+    NUM_BURST_TEMPS
+} BURST_TEMP_E;
+
+typedef enum
+{
+    BURST_CAPTURE_ARMED = 0,
+    BURST_CAPTURE_TRIGGERED,
+    BURST_CAPTURE_FROZEN
+} BURST_CAPTURE_STATE_E;
+
+/* ==================================================================== */
+/* ============================== STRUCTS============================== */
+/* ==================================================================== */
+
+typedef struct
+{
+    // Bit n enables the trigger BURST_TRIGGER_E n
+    uint32_t triggerMask;
+
+    // Frames kept before and after the trigger frame, clamped to the ring size
+    uint32_t preTriggerFrames;
+    uint32_t postTriggerFrames;
+
+    // Current spike and cell voltage sag between consecutive frames that trigger a capture
+    float overcurrentThresA;
+    float cellSagThresV;
+} Burst_Capture_Config_S;
+
+// One telemetry cycle of compact int16 samples, scaled by the BURST_*_LSB defines
+// Each current sample is the largest magnitude of currentSampleDecimation consecutive sampler readings
+typedef struct
+{
+    uint32_t timeUs;
+    uint32_t numCurrentSamples;
+    uint32_t currentSampleDecimation;
+    int16_t packCurrent[BURST_CURRENT_SAMPLES_PER_FRAME];
+    int16_t packVoltage;
+    int16_t temp[NUM_BURST_TEMPS];
+    int16_t cellVoltage[NUM_CELLS_IN_ACCUMULATOR];
+} Burst_Frame_S;
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DECLARATIONS =================== */
+/* ==================================================================== */
+
+/*!
+    @brief   Replace the trigger and window configuration, taken by the telemetry task on its next armed cycle
+    @param   config - New configuration
+    @returns True if the configuration was accepted, false if its window does not fit the ring
+*/
+bool configureBurstCapture(const Burst_Capture_Config_S *config);
+
+/*!
+    @brief   Record one telemetry cycle into the ring and evaluate the triggers
+    @param   taskData - Telemetry data of the cycle just completed
+*/
+void updateBurstCapture(telemetryTaskData_S *taskData);
+
+/*!
+    @brief   Request a capture on the next telemetry cycle
+*/
+void triggerBurstCapture(void);
+
+/*!
+    @brief   Copy out the next frame of a frozen capture, oldest first, and re-arm once the last is taken
+    @param   frame - Frame to copy into
+    @param   trigger - Trigger that froze the capture
+    @param   frameIndex - Index of the frame in the capture, the trigger frame is index 0
+    @returns True if a frame was copied, false if no capture is frozen
+*/
+bool drainBurstCapture(Burst_Frame_S *frame, BURST_TRIGGER_E *trigger, int32_t *frameIndex);
+
+#endif /* INC_BURST_CAPTURE_H_ */
@@ -0,0 +1,84 @@
+#ifndef INC_COMM_PASSTHROUGH_H_
+#define INC_COMM_PASSTHROUGH_H_
+
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+#include "telemetryTask.h"
+#include "adbms/adbms.h"
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+#define COMM_MAX_TRANSACTION_BYTES  32      // At most 32, one bit per byte in the repeated START mask
+#define COMM_QUEUE_LENGTH           4
+
+/* ==================================================================== */
+/* ========================= ENUMERATED TYPES========================== */
+/* ==================================================================== */
+
+typedef enum
+{
+    COMM_BUS_I2C = 0,
+    COMM_BUS_SPI
+} COMM_BUS_E;
+
+typedef enum
+{
+    COMM_TRANSACTION_IDLE = 0,
+    COMM_TRANSACTION_QUEUED,
+    COMM_TRANSACTION_ACTIVE,
+    COMM_TRANSACTION_COMPLETE,
+    COMM_TRANSACTION_FAILED
+} COMM_TRANSACTION_STATE_E;
+
+/* ==================================================================== */
+/* ============================== STRUCTS============================== */
+/* ==================================================================== */
+
+typedef struct
+{
+    COMM_BUS_E bus;
+
+    // Bytes up to numWriteBytes are written by the master, I2C bytes after that are read from the slave
+    uint8_t txData[COMM_MAX_TRANSACTION_BYTES];
+    uint8_t rxData[COMM_MAX_TRANSACTION_BYTES];
+    uint32_t numWriteBytes;
+    uint32_t numBytes;
+
+    // I2C only, bit n issues a repeated START before byte n, which is then written as the slave address
+    // A register write followed by a read is {addr W, reg, addr R, reads...} with numWriteBytes 2 and bit 2 set
+    uint32_t repeatedStartMask;
+
+    // Owned by the pass-through engine while queued or active
+    uint32_t bytesTransferred;
+    volatile COMM_TRANSACTION_STATE_E state;
+} Comm_Transaction_S;
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DECLARATIONS =================== */
+/* ==================================================================== */
+
+/*!
+    @brief   Queue an I2C or SPI transaction on the GPIO master of a cell monitor
+    @param   cellMonitorIndex - Index of the cell monitor in the chain
+    @param   transaction - Caller owned transaction, must stay valid until it completes or fails
+    @returns True if the transaction was queued, false if the queue is full or the transaction is invalid
+*/
+bool queueCommTransaction(uint32_t cellMonitorIndex, Comm_Transaction_S *transaction);
+
+/*!
+    @brief   Run queued pass-through transactions for every cell monitor in shared chain transfers
+    @param   adbmsData - Battery data struct holding the chain info
+    @param   budgetUs - Time budget in microseconds, transfers resume next call once exceeded
+    @returns Transaction status error code
+*/
+TRANSACTION_STATUS_E runCommPassthrough(ADBMS_BatteryData *adbmsData, uint32_t budgetUs);
+
+/*!
+    @brief   Fail all active and queued transactions, used when the chain is reinitialized
+*/
+void resetCommPassthrough(void);
+
+#endif /* INC_COMM_PASSTHROUGH_H_ */
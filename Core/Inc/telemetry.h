@@ -12,6 +12,15 @@
 /* ==================================================================== */
 
 TRANSACTION_STATUS_E updateBatteryTelemetry(telemetryTaskData_S *taskData);
+uint32_t getTelemetryWakeDelayMs();
+uint32_t getTelemetryPeriodMs();
+bool telemetryWakeRequested();
+uint32_t getTelemetryDataAgeUs(telemetryTaskData_S *taskData);
+uint32_t sampleHighRateCurrent();
+uint32_t getCurrentSamples(Current_Sample_S *samples, uint32_t maxSamples, uint32_t *readIndex);
+bool getCurrentAtTime(uint32_t timeUs, float *current);
+uint32_t getPrechargeCompleteCount(uint32_t *completeTimeUs);
+uint32_t getBatteryVoltageData(ADBMS_VoltageData *voltageData);
 
 
 #endif /* INC_TELEMETRY_H_ */
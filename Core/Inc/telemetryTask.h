@@ -17,6 +17,23 @@
 #define NUM_PACK_MON_IN_ACCUMULATOR 1
 #define NUM_CELL_MON_IN_ACCUMULATOR 8
 #define NUM_DEVICES_IN_ACCUMULATOR  (NUM_PACK_MON_IN_ACCUMULATOR + NUM_CELL_MON_IN_ACCUMULATOR)
+#define NUM_CELLS_IN_ACCUMULATOR    (NUM_CELL_MON_IN_ACCUMULATOR * NUM_CELLS_PER_CELL_MONITOR)
+
+// Command blocks in the telemetry cycle table
+#define NUM_TELEMETRY_COMMAND_BLOCKS    15
+
+// Activity adaptive rate, each level doubles the cycle period
+#define TELEMETRY_RATE_MAX_LEVEL    3
+
+// High rate pack current sampling while the read registers are released between cycles
+// The telemetry task sleeps on the microsecond one shot between samples
+#define HIGH_RATE_CURRENT_PERIOD_US     1000
+
+// Pack current samples taken over one cycle at the slowest rate
+#define MAX_CURRENT_SAMPLES_PER_CYCLE   (((TELEMETRY_TASK_PERIOD_MS << TELEMETRY_RATE_MAX_LEVEL) * 1000) / HIGH_RATE_CURRENT_PERIOD_US)
+
+// Pack current samples kept between read cycles, must be a power of two and hold a full slow cycle
+#define CURRENT_SAMPLE_BUFFER_SIZE  256
 
 // Use this to configure the order of the daisychain in the accumulator
 // BMB0 is the first BMB connected to PORT A, assign the desired segment index here
@@ -43,28 +60,76 @@ typedef enum
 typedef enum
 {
     REDUNDANT_ADC_DIAG_STATE = 0,
-    BALANCING_DIAG_STATE,
     OPEN_WIRE_EVEN_DIAG_STATE,
     OPEN_WIRE_ODD_DIAG_STATE,
+    AUX_OPEN_WIRE_PULL_DOWN_DIAG_STATE,
+    AUX_OPEN_WIRE_PULL_UP_DIAG_STATE,
     NUM_ADC_DIAG_STATES
 } ADC_DIAG_STATE_E;
 
+typedef enum
+{
+    RATE_GROUP_CELL_VOLTAGE = 0,
+    RATE_GROUP_TEMPERATURE,
+    RATE_GROUP_STATUS,
+    RATE_GROUP_DIAGNOSTICS,
+    NUM_RATE_GROUPS
+} RATE_GROUP_E;
+
+typedef enum
+{
+    CURRENT_CHANNEL_1 = 0,
+    CURRENT_CHANNEL_2,
+    NUM_CURRENT_CHANNELS
+} CURRENT_CHANNEL_E;
+
+typedef enum
+{
+    PRECHARGE_IDLE = 0,
+    PRECHARGE_ARMED,
+    PRECHARGE_ACTIVE,
+    PRECHARGE_COMPLETE
+} PRECHARGE_STATE_E;
+
 /* ==================================================================== */
 /* ============================== STRUCTS ============================= */
 /* ==================================================================== */
 
+// Per cell data for the whole chain is stored as contiguous arrays so that the statistics
+// and conversion passes stream linearly. Index with CELL_INDEX(bmb, cell)
 typedef struct
 {
     // Cell voltage array
-    float cellVoltage[NUM_CELLS_PER_CELL_MONITOR];
-    SENSOR_STATUS_E cellVoltageStatus[NUM_CELLS_PER_CELL_MONITOR];
+    float cellVoltage[NUM_CELLS_IN_ACCUMULATOR];
+
+    // Cell temp array
+    float cellTemp[NUM_CELLS_IN_ACCUMULATOR];
+
+    // Start of the aux conversion each cell temp came from, htim5 microseconds
+    uint32_t cellTempSampleTimeUs[NUM_CELLS_IN_ACCUMULATOR];
+
+    // Sense status arrays
+    SENSOR_STATUS_E cellVoltageStatus[NUM_CELLS_IN_ACCUMULATOR];
+    SENSOR_STATUS_E cellTempStatus[NUM_CELLS_IN_ACCUMULATOR];
 
     // Balancing switch closed
-    bool cellBalancingActive[NUM_CELLS_PER_CELL_MONITOR];
+    bool cellBalancingActive[NUM_CELLS_IN_ACCUMULATOR];
 
-    // Cell temp array
-    float cellTemp[NUM_CELLS_PER_CELL_MONITOR];
-    SENSOR_STATUS_E cellTempStatus[NUM_CELLS_PER_CELL_MONITOR];
+    // On chip C-ADC vs S-ADC comparison exceeded threshold
+    bool cellAdcMismatch[NUM_CELLS_IN_ACCUMULATOR];
+
+    // Read back S-ADC voltage disagreed with the C-ADC voltage on consecutive reads
+    bool cellAdcFault[NUM_CELLS_IN_ACCUMULATOR];
+
+    // Open wire diagnostic results for the cell sense and thermistor inputs
+    bool cellOpenWire[NUM_CELLS_IN_ACCUMULATOR];
+    bool cellTempOpenWire[NUM_CELLS_IN_ACCUMULATOR];
+} Cell_Array_S;
+
+typedef struct
+{
+    // End of the conversion the snapshot cell voltages came from, htim5 microseconds
+    uint32_t snapshotTimeUs;
 
     // Board temp
     float boardTemp;
@@ -90,6 +155,9 @@ typedef struct
     float referenceResistorVoltage;
     SENSOR_STATUS_E referenceResistorVoltageStatus;
 
+    // Hardware OV/UV comparator flags, bit n set when cell n crossed a fault threshold
+    uint16_t cellOverVoltageFlags;
+    uint16_t cellUnderVoltageFlags;
 
     // Cell monitor local voltage statistics
     float maxCellVoltage;
@@ -115,6 +183,27 @@ typedef struct
     float packCurrent;
     SENSOR_STATUS_E packCurrentStatus;
 
+    // End of the conversion or accumulation window the pack current came from, htim5 microseconds
+    uint32_t currentSampleTimeUs;
+
+    // Current ADC fusion, channel 1 minus channel 2 divergence after filtering and the status of each channel
+    float currentChannelDivergence;
+    SENSOR_STATUS_E currentChannelStatus[NUM_CURRENT_CHANNELS];
+
+    // Largest current magnitude seen by the high rate sampler since the last cycle, signed
+    float peakPackCurrent;
+
+    // Precharge monitoring from the high rate link voltage samples
+    PRECHARGE_STATE_E prechargeState;
+    float prechargeTimeConstantMs;
+    float prechargeTimeRemainingMs;
+    uint32_t prechargeCompleteTimeUs;
+
+    // Hardware overcurrent comparator faults
+    bool overcurrent1Fault;
+    bool overcurrent2Fault;
+    bool overcurrent3Fault;
+
     // Pack voltage
     float packVoltage;
     SENSOR_STATUS_E packVoltageStatus;
@@ -186,6 +275,9 @@ typedef struct
     
     /// Calculated values
 
+    // Predicted shunt resistive element temp from the shunt thermal model
+    float shuntElementTemp;
+
     // Temperature adjusted shunt resistance
     float shuntResistanceMicroOhms;
 
@@ -197,6 +289,10 @@ typedef struct
     uint32_t nextQualifiedPhaseCount;
     float adcConversionTimeMS;
 
+    // Conversion period fit quality, RMS timer residual of the inliers and the fraction of points kept
+    float adcPhaseFitResidualUs;
+    float adcPhaseFitConfidence;
+
     // SOC and SOE data
     Soc_S socData;
 
@@ -204,11 +300,54 @@ typedef struct
     int32_t packEnergyMilliJoules;
 } Pack_Monitor_S;
 
+// One high rate pack current sample, currents in amps
+typedef struct
+{
+    uint32_t timeUs;
+    float instantCurrent;
+    float accumulatedCurrent;
+} Current_Sample_S;
+
+// How often one diagnostic test completes a full pass over the chain
+typedef struct
+{
+    uint32_t lastCompleteTick;
+    uint32_t coverageIntervalMs;
+    uint32_t numPasses;
+} Diagnostic_Coverage_S;
+
+// Bus time spent by one rate group in the cycles it was scheduled
+typedef struct
+{
+    uint32_t worstCaseTimeUs;
+    float averageTimeUs;
+    uint32_t numRuns;
+} Rate_Group_Timing_S;
+
+// Cost of command counter error retries on one command block
+typedef struct
+{
+    uint32_t numRetries;
+    uint32_t numStepsRetried;
+} Command_Block_Retry_S;
+
+// Cycle time against the telemetry period and optional work pushed to later cycles
+typedef struct
+{
+    uint32_t lastCycleTimeUs;
+    uint32_t worstCycleTimeUs;
+    uint32_t numOverruns;
+    uint32_t numDeferredBlocks;
+} Cycle_Budget_S;
 
 typedef struct
 {
     bool chainInitialized;
 
+    // Chain is parked in low power cell monitoring mode
+    bool lpcmParked;
+
+    Cell_Array_S cells;
 	Cell_Monitor_S bmb[NUM_CELL_MON_IN_ACCUMULATOR];
     SENSOR_STATUS_E bmbStatus[NUM_CELL_MON_IN_ACCUMULATOR];
 
@@ -218,8 +357,36 @@ typedef struct
     bool balancingEnabled;
     float balancingFloor;
 
+    // Time discharge was muted before the last snapshot
+    uint32_t balancingSettleTimeUs;
+
     CHAIN_INFO_S chainInfo;
 
+    // Per rate group execution time
+    Rate_Group_Timing_S rateGroupTiming[NUM_RATE_GROUPS];
+
+    // Per command block retry cost, indexed in cycle table order
+    Command_Block_Retry_S commandBlockRetry[NUM_TELEMETRY_COMMAND_BLOCKS];
+
+    // Cycle budget governor results
+    Cycle_Budget_S cycleBudget;
+
+    // Per diagnostic test coverage
+    Diagnostic_Coverage_S diagnosticCoverage[NUM_ADC_DIAG_STATES];
+
+    // Time from the end of the conversion window the primary telemetry came from to its read back
+    // Consumers get the age at their own read time from getTelemetryDataAgeUs
+    uint32_t dataAgeUs;
+
+    // Telemetry cycle period chosen by the activity adaptive rate controller
+    uint32_t telemetryPeriodMs;
+
+    // Start of the aux conversion the last temperature readings came from, htim5 microseconds
+    uint32_t auxSampleTimeUs;
+
+    // Time the thermistor mux settled before the alternate half was converted
+    uint32_t tempMuxSettleTimeUs;
+
     float cellSumVoltage;
 
     float maxCellVoltage;
@@ -243,6 +410,12 @@ typedef struct
 
 } telemetryTaskData_S;
 
+/* ==================================================================== */
+/* ============================== MACROS ============================== */
+/* ==================================================================== */
+
+#define CELL_INDEX(bmb, cell)   (((bmb) * NUM_CELLS_PER_CELL_MONITOR) + (cell))
+
 /* ==================================================================== */
 /* =================== GLOBAL FUNCTION DECLARATIONS =================== */
 /* ==================================================================== */
@@ -180,6 +180,8 @@
 #define CELL_OV_UV_MASK         0x00000FFF
 #define CELL_OV_UV_BITS         12
 
+#define LPCM_DELTA_MAX_VALUE    (CELL_OV_UV_MASK * CELL_MON_OV_UV_GAIN)
+
 #define DTM_ENABLE              0x80
 #define DTM_LONG_RANGE_ENABLE   0x40
 #define DTM_TIME_MASK           0x3F
@@ -201,6 +203,21 @@
 
 #define OVERCURRENT_GAIN1       5.0f
 #define OVERCURRENT_GAIN2       2.5f
+#define OVERCURRENT_THRES_MASK  0x7F
+
+// Config B bytes 0-2 hold the OV/UV thresholds on the cell monitors and the OC thresholds on the pack monitor
+#define CONFIG_B_THRESHOLD_BYTES    3
+
+// Overcurrent fault bits in pack monitor status C bytes 0 and 1
+#define OVERCURRENT_FAULT_BYTES 2
+
+// COMM register encoding, each data byte is framed by a 4 bit initial and final control code
+#define COMM_NIBBLE_BITS        4
+#define COMM_NIBBLE_MASK        0x0F
+#define COMM_BYTES_PER_DATA     2
+
+// STCOMM needs 24 clock cycles per data byte to shift out the COMM register
+#define COMM_CLOCK_BYTES        ((NUM_COMM_BYTES * 24) / BITS_IN_BYTE)
 
 // Configuration register group A encoding
 #define REFON_BIT       7
@@ -217,6 +234,12 @@
 #define PACK_MON_COUNTER2_BIT       5
 #define PACK_MON_COUNTER1_MASK      0x1F
 
+// Status register mirror compare masks for bytes 0-3 and bytes 4-5
+#define STATUS_COMPARE_LOW_ALL          0xFFFFFFFF
+#define STATUS_COMPARE_HIGH_ALL         0xFFFF
+#define STATUS_COMPARE_LOW_NO_COUNTER   0x0000FFFF  // Ignore the conversion counter in bytes 2-3
+#define STATUS_COMPARE_HIGH_NO_OSC      0x00FF      // Ignore the free running oscillator counter in byte 5
+
 // Time for ADBMS device to wake
 #define TIME_WAKE_US            500
 
@@ -264,9 +287,151 @@ static const uint16_t auxVoltageCode[NUM_AUXV_REGISTERS] =
 
 static const uint16_t redundantAuxVoltageCode[NUM_AUXV_REGISTERS] =
 {
-    RDAUXA, RDAUXB, RDAUXC, RDAUXD
+    RDRAXA, RDRAXB, RDRAXC, RDRAXD
 };
 
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DECLARATIONS ==================== */
+/* ==================================================================== */
+
+static uint32_t getValidFrameMask(ADBMS_BatteryData *adbmsData, TRANSACTION_STATUS_E status);
+static bool updateStatusMirror(ADBMS_BatteryData *adbmsData, STATUS_REGISTER_GROUP_E statusGroup, uint8_t *mirror, uint8_t *registerData, uint32_t validFrames, uint32_t lowMask, uint16_t highMask);
+static void encodeCellOvUvThresholds(uint8_t *deviceRegister, float underVoltage, float overVoltage);
+static void encodeLpcmThresholds(uint8_t *deviceRegister, float underVoltage, float overVoltage, float deltaVoltage);
+static void decodeCellOvUvFlags(uint8_t *statRegister, ADBMS_StatusDCellMonitor *statusGroupD);
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+static uint32_t getValidFrameMask(ADBMS_BatteryData *adbmsData, TRANSACTION_STATUS_E status)
+{
+    uint32_t numDevs = adbmsData->chainInfo.numDevs;
+    uint32_t allFrames = (1UL << numDevs) - 1;
+
+    if(status == TRANSACTION_SUCCESS)
+    {
+        return allFrames;
+    }
+    else if((status == TRANSACTION_CHAIN_BREAK_ERROR) && (adbmsData->chainInfo.chainStatus == MULTIPLE_CHAIN_BREAK))
+    {
+        // Only the devices reachable from each port were read, the rest of the buffer is still zeroed
+        uint32_t portAFrames = (1UL << adbmsData->chainInfo.availableDevices[PORTA]) - 1;
+        uint32_t portBFrames = allFrames & ~((1UL << (numDevs - adbmsData->chainInfo.availableDevices[PORTB])) - 1);
+        return (portAFrames | portBFrames) & allFrames;
+    }
+
+    // Any other failure leaves the buffer zeroed or partially filled
+    return 0;
+}
+
+static bool updateStatusMirror(ADBMS_BatteryData *adbmsData, STATUS_REGISTER_GROUP_E statusGroup, uint8_t *mirror, uint8_t *registerData, uint32_t validFrames, uint32_t lowMask, uint16_t highMask)
+{
+    // Frames are laid out in chain order in the transaction buffer
+    uint32_t frameBit = 1UL << ((uint32_t)(registerData - transactionBuffer) / REGISTER_SIZE_BYTES);
+
+    // Never mirror or decode a frame that failed its PEC or was not reached
+    if(!(validFrames & frameBit))
+    {
+        return false;
+    }
+
+    uint32_t newLow;
+    uint32_t oldLow;
+    uint16_t newHigh;
+    uint16_t oldHigh;
+
+    // Compare the 6 byte register as one word and one half word
+    memcpy(&newLow, registerData, sizeof(newLow));
+    memcpy(&oldLow, mirror, sizeof(oldLow));
+    memcpy(&newHigh, registerData + REGISTER_BYTE4, sizeof(newHigh));
+    memcpy(&oldHigh, mirror + REGISTER_BYTE4, sizeof(oldHigh));
+
+    bool changed = (!(adbmsData->statusMirrorValid[statusGroup] & frameBit)) || ((newLow ^ oldLow) & lowMask) || ((newHigh ^ oldHigh) & highMask);
+
+    if(changed)
+    {
+        memcpy(mirror, registerData, REGISTER_SIZE_BYTES);
+        adbmsData->statusMirrorValid[statusGroup] |= frameBit;
+    }
+
+    return changed;
+}
+
+static void encodeCellOvUvThresholds(uint8_t *deviceRegister, float underVoltage, float overVoltage)
+{
+    if(underVoltage < MIN_OV_UV_VALUE)
+    {
+        underVoltage = MIN_OV_UV_VALUE;
+    }
+    else if(underVoltage > MAX_OV_UV_VALUE)
+    {
+        underVoltage = MAX_OV_UV_VALUE;
+    }
+
+    if(overVoltage < MIN_OV_UV_VALUE)
+    {
+        overVoltage = MIN_OV_UV_VALUE;
+    }
+    else if(overVoltage > MAX_OV_UV_VALUE)
+    {
+        overVoltage = MAX_OV_UV_VALUE;
+    }
+
+    // 12 bit under voltage code in bits 0-11 and over voltage code in bits 12-23
+    uint32_t underVoltageSetting = CONVERT_FLOAT_TO_REGISTER(underVoltage, CELL_MON_OV_UV_GAIN, CELL_MON_OV_UV_OFFSET) & CELL_OV_UV_MASK;
+    uint32_t overVoltageSetting = CONVERT_FLOAT_TO_REGISTER(overVoltage, CELL_MON_OV_UV_GAIN, CELL_MON_OV_UV_OFFSET) & CELL_OV_UV_MASK;
+    uint32_t thresholdSettings = underVoltageSetting | (overVoltageSetting << CELL_OV_UV_BITS);
+
+    deviceRegister[REGISTER_BYTE0] = (uint8_t)(thresholdSettings);
+    deviceRegister[REGISTER_BYTE1] = (uint8_t)(thresholdSettings >> BITS_IN_BYTE);
+    deviceRegister[REGISTER_BYTE2] = (uint8_t)(thresholdSettings >> (2 * BITS_IN_BYTE));
+}
+
+static void encodeLpcmThresholds(uint8_t *deviceRegister, float underVoltage, float overVoltage, float deltaVoltage)
+{
+    if(deltaVoltage < 0.0f)
+    {
+        deltaVoltage = 0.0f;
+    }
+    else if(deltaVoltage > LPCM_DELTA_MAX_VALUE)
+    {
+        deltaVoltage = LPCM_DELTA_MAX_VALUE;
+    }
+
+    // Under and over voltage thresholds share the encoding of the configuration B thresholds
+    encodeCellOvUvThresholds(deviceRegister, underVoltage, overVoltage);
+
+    // Delta threshold is an unsigned 12 bit value with no offset
+    uint16_t deltaSetting = CONVERT_FLOAT_TO_REGISTER(deltaVoltage, CELL_MON_OV_UV_GAIN, 0.0f) & CELL_OV_UV_MASK;
+
+    deviceRegister[REGISTER_BYTE3] = (uint8_t)(deltaSetting);
+    deviceRegister[REGISTER_BYTE4] = (uint8_t)(deltaSetting >> BITS_IN_BYTE);
+    deviceRegister[REGISTER_BYTE5] = 0;
+}
+
+static void decodeCellOvUvFlags(uint8_t *statRegister, ADBMS_StatusDCellMonitor *statusGroupD)
+{
+    uint32_t cellFault0 = (uint32_t)statRegister[REGISTER_BYTE0];
+    uint32_t cellFault1 = ((uint32_t)statRegister[REGISTER_BYTE1]) << (BITS_IN_BYTE);
+    uint32_t cellFault2 = ((uint32_t)statRegister[REGISTER_BYTE2]) << (BITS_IN_BYTE * 2);
+    uint32_t cellFault3 = ((uint32_t)statRegister[REGISTER_BYTE3]) << (BITS_IN_BYTE * 3);
+
+    uint32_t cellFaultMask = (cellFault0) | (cellFault1) | (cellFault2) | (cellFault3);
+
+    // UV and OV flags are interleaved, even bits are UV and odd bits are OV
+    uint16_t underVoltage = 0;
+    uint16_t overVoltage = 0;
+    for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+    {
+        underVoltage |= (uint16_t)(((cellFaultMask >> (j * 2)) & 0x00000001) << j);
+        overVoltage |= (uint16_t)(((cellFaultMask >> ((j * 2) + 1)) & 0x00000001) << j);
+    }
+
+    statusGroupD->cellUnderVoltageFlags = underVoltage;
+    statusGroupD->cellOverVoltageFlags = overVoltage;
+}
+
 /* ==================================================================== */
 /* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
 /* ==================================================================== */
@@ -416,6 +581,30 @@ TRANSACTION_STATUS_E clearAllFlags(ADBMS_BatteryData *adbmsData)
     return status;
 }
 
+TRANSACTION_STATUS_E clearCellAdcMismatchFlags(ADBMS_BatteryData *adbmsData)
+{
+    memset(transactionBuffer, 0x00, (adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES));
+
+    uint8_t *cellMonitorDataBuffer;
+    if(adbmsData->chainInfo.packMonitorPort == PORTA)
+    {
+        cellMonitorDataBuffer = transactionBuffer + REGISTER_SIZE_BYTES;
+    }
+    else
+    {
+        cellMonitorDataBuffer = transactionBuffer;
+    }
+
+    // Only clear the C-ADC vs S-ADC mismatch bits in status C, leave the pack monitor flags untouched
+    for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
+    {
+        cellMonitorDataBuffer[(i * REGISTER_SIZE_BYTES) + REGISTER_BYTE0] = 0xFF;
+        cellMonitorDataBuffer[(i * REGISTER_SIZE_BYTES) + REGISTER_BYTE1] = 0xFF;
+    }
+
+    return writeChain(CLRFLAG, &adbmsData->chainInfo, SHARED_COMMAND, transactionBuffer);
+}
+
 TRANSACTION_STATUS_E readSerialId(ADBMS_BatteryData *adbmsData)
 {
     memset(transactionBuffer, 0x00, adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES);
@@ -685,6 +874,25 @@ TRANSACTION_STATUS_E readConfigA(ADBMS_BatteryData *adbmsData)
     return status;
 }
 
+uint8_t encodeOvercurrentThreshold(float thresholdMv, OVERCURRENT_GAIN_CONTROL_SETTING_E gainSetting)
+{
+    float gain = (gainSetting) ? (OVERCURRENT_GAIN2) : (OVERCURRENT_GAIN1);
+
+    if(thresholdMv <= 0.0f)
+    {
+        return 0;
+    }
+
+    // Round to the nearest code and clamp to the 7 bit threshold field
+    uint32_t thresholdSetting = (uint32_t)((thresholdMv / gain) + 0.5f);
+    if(thresholdSetting > OVERCURRENT_THRES_MASK)
+    {
+        thresholdSetting = OVERCURRENT_THRES_MASK;
+    }
+
+    return (uint8_t)thresholdSetting;
+}
+
 TRANSACTION_STATUS_E writeConfigB(ADBMS_BatteryData *adbmsData)
 {
     uint8_t *packMonitorDataBuffer;
@@ -706,34 +914,7 @@ TRANSACTION_STATUS_E writeConfigB(ADBMS_BatteryData *adbmsData)
     {
         uint8_t *deviceRegister = cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES);
 
-        float underVoltageThresh = adbmsData->cellMonitor[i].configGroupB.undervoltageThreshold;
-        float overVoltageThresh = adbmsData->cellMonitor[i].configGroupB.overvoltageThreshold;
-
-        if(underVoltageThresh < MIN_OV_UV_VALUE)
-        {
-            underVoltageThresh = MIN_OV_UV_VALUE;
-        }
-        else if(underVoltageThresh > MAX_OV_UV_VALUE)
-        {
-            underVoltageThresh = MAX_OV_UV_VALUE;
-        }
-
-        if(overVoltageThresh < MIN_OV_UV_VALUE)
-        {
-            overVoltageThresh = MIN_OV_UV_VALUE;
-        }
-        else if(overVoltageThresh > MAX_OV_UV_VALUE)
-        {
-            overVoltageThresh = MAX_OV_UV_VALUE;
-        }
-
-        uint32_t underVoltageSetting = CONVERT_FLOAT_TO_REGISTER(underVoltageThresh, CELL_MON_OV_UV_GAIN, CELL_MON_OV_UV_OFFSET) & CELL_OV_UV_MASK;
-        uint32_t overVoltageSetting = CONVERT_FLOAT_TO_REGISTER(overVoltageThresh, CELL_MON_OV_UV_GAIN, CELL_MON_OV_UV_OFFSET) & CELL_OV_UV_MASK;
-        uint32_t cellThresholdSettings = underVoltageSetting | (overVoltageSetting << CELL_OV_UV_BITS);
-
-        deviceRegister[REGISTER_BYTE0] = (uint8_t)(cellThresholdSettings);
-        deviceRegister[REGISTER_BYTE1] = (uint8_t)(cellThresholdSettings >> BITS_IN_BYTE);
-        deviceRegister[REGISTER_BYTE2] = (uint8_t)(cellThresholdSettings >> (2 * BITS_IN_BYTE));
+        encodeCellOvUvThresholds(deviceRegister, adbmsData->cellMonitor[i].configGroupB.undervoltageThreshold, adbmsData->cellMonitor[i].configGroupB.overvoltageThreshold);
 
         uint32_t dischargeTimeout = adbmsData->cellMonitor[i].configGroupB.dischargeTimeoutMinutes;
         uint8_t dischargeTimerSetting = 0;
@@ -757,6 +938,9 @@ TRANSACTION_STATUS_E writeConfigB(ADBMS_BatteryData *adbmsData)
                 {
                     dischargeTimerSetting |= (uint8_t)(DTM_LONG_RANGE_MAX /  DTM_LONG_RANGE_STEP);
                 }
+
+                // Report the rounded timeout actually programmed so the caller can track the expiry
+                adbmsData->cellMonitor[i].configGroupB.dischargeTimeoutMinutes = ((dischargeTimerSetting & DTM_TIME_MASK) * DTM_LONG_RANGE_STEP);
             }
         }
 
@@ -836,6 +1020,49 @@ TRANSACTION_STATUS_E readConfigB(ADBMS_BatteryData *adbmsData)
     return status;
 }
 
+TRANSACTION_STATUS_E verifyConfigBThresholds(ADBMS_BatteryData *adbmsData, uint32_t *mismatchMask)
+{
+    memset(transactionBuffer, 0x00, adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES);
+
+    TRANSACTION_STATUS_E status = readChain(RDCFGB, &adbmsData->chainInfo, transactionBuffer);
+
+    uint32_t packMonitorFrame = (adbmsData->chainInfo.packMonitorPort == PORTA) ? (0) : (adbmsData->chainInfo.numDevs - 1);
+    uint32_t cellMonitorFrame = (adbmsData->chainInfo.packMonitorPort == PORTA) ? (1) : (0);
+    uint32_t validFrames = getValidFrameMask(adbmsData, status);
+
+    // Only the threshold bytes are compared, the discharge timer and GPIO fields read back live state
+    // Mismatches use the bit layout of the status changed masks
+    uint8_t expectedRegister[REGISTER_SIZE_BYTES];
+    *mismatchMask = 0;
+
+    if((validFrames & (1UL << packMonitorFrame)) && memcmp(transactionBuffer + (packMonitorFrame * REGISTER_SIZE_BYTES), &adbmsData->packMonitor.configGroupB, CONFIG_B_THRESHOLD_BYTES))
+    {
+        *mismatchMask |= STATUS_CHANGED_PACK_MONITOR;
+    }
+
+    for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
+    {
+        uint32_t frame = cellMonitorFrame + i;
+        encodeCellOvUvThresholds(expectedRegister, adbmsData->cellMonitor[i].configGroupB.undervoltageThreshold, adbmsData->cellMonitor[i].configGroupB.overvoltageThreshold);
+
+        if((validFrames & (1UL << frame)) && memcmp(transactionBuffer + (frame * REGISTER_SIZE_BYTES), expectedRegister, CONFIG_B_THRESHOLD_BYTES))
+        {
+            *mismatchMask |= (1UL << i);
+        }
+    }
+
+    return status;
+}
+
+
+void invalidateStatusMirror(ADBMS_BatteryData *adbmsData)
+{
+    for(uint32_t i = 0; i < NUM_STATUS_GROUPS; i++)
+    {
+        adbmsData->statusMirrorValid[i] = 0;
+        adbmsData->statusGroupChanged[i] = 0;
+    }
+}
 
 TRANSACTION_STATUS_E readStatusA(ADBMS_BatteryData *adbmsData)
 {
@@ -856,16 +1083,31 @@ TRANSACTION_STATUS_E readStatusA(ADBMS_BatteryData *adbmsData)
         packMonitorDataBuffer = transactionBuffer + ((adbmsData->chainInfo.numDevs - 1) * REGISTER_SIZE_BYTES);
     }
 
-    adbmsData->packMonitor.statusGroupA.referenceVoltage1P25 = CONVERT_SIGNED_16_BIT_REGISTER(packMonitorDataBuffer, PACK_MON_VREF1P25_GAIN, PACK_MON_VREF1P25_OFFSET);
-    adbmsData->packMonitor.statusGroupA.dieTemp1 = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_DIE_TEMP1_GAIN, PACK_MON_DIE_TEMP1_OFFSET);
-    adbmsData->packMonitor.statusGroupA.regulatorVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VREG_GAIN, PACK_MON_VREG_OFFSET);
+    uint32_t validFrames = getValidFrameMask(adbmsData, status);
+    uint32_t changedMask = 0;
+
+    if(updateStatusMirror(adbmsData, STATUS_GROUP_A, adbmsData->packMonitor.statusRegisterMirror[STATUS_GROUP_A], packMonitorDataBuffer, validFrames, STATUS_COMPARE_LOW_ALL, STATUS_COMPARE_HIGH_ALL))
+    {
+        adbmsData->packMonitor.statusGroupA.referenceVoltage1P25 = CONVERT_SIGNED_16_BIT_REGISTER(packMonitorDataBuffer, PACK_MON_VREF1P25_GAIN, PACK_MON_VREF1P25_OFFSET);
+        adbmsData->packMonitor.statusGroupA.dieTemp1 = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_DIE_TEMP1_GAIN, PACK_MON_DIE_TEMP1_OFFSET);
+        adbmsData->packMonitor.statusGroupA.regulatorVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VREG_GAIN, PACK_MON_VREG_OFFSET);
+        changedMask |= STATUS_CHANGED_PACK_MONITOR;
+    }
 
     for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
     {
-        adbmsData->cellMonitor[i].statusGroupA.referenceVoltage = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
-        adbmsData->cellMonitor[i].statusGroupA.dieTemp = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES) + (VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_DIE_TEMP_GAIN, CELL_MON_DIE_TEMP_OFFSET);
+        uint8_t *statRegister = cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES);
+
+        if(updateStatusMirror(adbmsData, STATUS_GROUP_A, adbmsData->cellMonitor[i].statusRegisterMirror[STATUS_GROUP_A], statRegister, validFrames, STATUS_COMPARE_LOW_ALL, STATUS_COMPARE_HIGH_ALL))
+        {
+            adbmsData->cellMonitor[i].statusGroupA.referenceVoltage = CONVERT_SIGNED_16_BIT_REGISTER(statRegister, CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
+            adbmsData->cellMonitor[i].statusGroupA.dieTemp = CONVERT_SIGNED_16_BIT_REGISTER((statRegister + (VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_DIE_TEMP_GAIN, CELL_MON_DIE_TEMP_OFFSET);
+            changedMask |= (1UL << i);
+        }
     }
 
+    adbmsData->statusGroupChanged[STATUS_GROUP_A] = changedMask;
+
     return status;
 }
 
@@ -888,17 +1130,32 @@ TRANSACTION_STATUS_E readStatusB(ADBMS_BatteryData *adbmsData)
         packMonitorDataBuffer = transactionBuffer + ((adbmsData->chainInfo.numDevs - 1) * REGISTER_SIZE_BYTES);
     }
 
-    adbmsData->packMonitor.statusGroupB.supplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER(packMonitorDataBuffer, PACK_MON_VDD_GAIN, PACK_MON_VDD_OFFSET);
-    adbmsData->packMonitor.statusGroupB.digitalSupplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VDIG_GAIN, PACK_MON_VDIG_OFFSET);
-    adbmsData->packMonitor.statusGroupB.groundPadVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_EPAD_GAIN, PACK_MON_EPAD_OFFSET);
+    uint32_t validFrames = getValidFrameMask(adbmsData, status);
+    uint32_t changedMask = 0;
+
+    if(updateStatusMirror(adbmsData, STATUS_GROUP_B, adbmsData->packMonitor.statusRegisterMirror[STATUS_GROUP_B], packMonitorDataBuffer, validFrames, STATUS_COMPARE_LOW_ALL, STATUS_COMPARE_HIGH_ALL))
+    {
+        adbmsData->packMonitor.statusGroupB.supplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER(packMonitorDataBuffer, PACK_MON_VDD_GAIN, PACK_MON_VDD_OFFSET);
+        adbmsData->packMonitor.statusGroupB.digitalSupplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VDIG_GAIN, PACK_MON_VDIG_OFFSET);
+        adbmsData->packMonitor.statusGroupB.groundPadVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_EPAD_GAIN, PACK_MON_EPAD_OFFSET);
+        changedMask |= STATUS_CHANGED_PACK_MONITOR;
+    }
 
     for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
     {
-        adbmsData->cellMonitor[i].statusGroupB.digitalSupplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
-        adbmsData->cellMonitor[i].statusGroupB.analogSupplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES) + (VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
-        adbmsData->cellMonitor[i].statusGroupB.referenceResistorVoltage = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES) + (2 * VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
+        uint8_t *statRegister = cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES);
+
+        if(updateStatusMirror(adbmsData, STATUS_GROUP_B, adbmsData->cellMonitor[i].statusRegisterMirror[STATUS_GROUP_B], statRegister, validFrames, STATUS_COMPARE_LOW_ALL, STATUS_COMPARE_HIGH_ALL))
+        {
+            adbmsData->cellMonitor[i].statusGroupB.digitalSupplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER(statRegister, CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
+            adbmsData->cellMonitor[i].statusGroupB.analogSupplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER((statRegister + (VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
+            adbmsData->cellMonitor[i].statusGroupB.referenceResistorVoltage = CONVERT_SIGNED_16_BIT_REGISTER((statRegister + (2 * VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
+            changedMask |= (1UL << i);
+        }
     }
 
+    adbmsData->statusGroupChanged[STATUS_GROUP_B] = changedMask;
+
     return status;
 }
 
@@ -921,7 +1178,15 @@ TRANSACTION_STATUS_E readStatusC(ADBMS_BatteryData *adbmsData)
         packMonitorDataBuffer = transactionBuffer + ((adbmsData->chainInfo.numDevs - 1) * REGISTER_SIZE_BYTES);
     }
 
-    memcpy(&adbmsData->packMonitor.statusGroupC, packMonitorDataBuffer, REGISTER_SIZE_BYTES);
+    uint32_t validFrames = getValidFrameMask(adbmsData, status);
+    uint32_t changedMask = 0;
+
+    // The conversion counters change every conversion and are always decoded, fault flags only when they change
+    if(updateStatusMirror(adbmsData, STATUS_GROUP_C, adbmsData->packMonitor.statusRegisterMirror[STATUS_GROUP_C], packMonitorDataBuffer, validFrames, STATUS_COMPARE_LOW_NO_COUNTER, STATUS_COMPARE_HIGH_ALL))
+    {
+        memcpy(&adbmsData->packMonitor.statusGroupC, packMonitorDataBuffer, REGISTER_SIZE_BYTES);
+        changedMask |= STATUS_CHANGED_PACK_MONITOR;
+    }
     adbmsData->packMonitor.statusGroupC.conversionCounter1 = (((uint16_t)(packMonitorDataBuffer[REGISTER_BYTE2] & PACK_MON_COUNTER1_MASK)) << BITS_IN_BYTE) | ((uint16_t)(packMonitorDataBuffer[REGISTER_BYTE3]));
     adbmsData->packMonitor.statusGroupC.conversionCounter2 = packMonitorDataBuffer[REGISTER_BYTE2] >> PACK_MON_COUNTER2_BIT;
 
@@ -929,18 +1194,24 @@ TRANSACTION_STATUS_E readStatusC(ADBMS_BatteryData *adbmsData)
     {
         uint8_t *statRegister = cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES);
 
-        memcpy(&adbmsData->cellMonitor[i].statusGroupC, statRegister, REGISTER_SIZE_BYTES);
-
-        adbmsData->cellMonitor[i].statusGroupC.conversionCounter = (((uint16_t)(statRegister[REGISTER_BYTE2])) << BITS_IN_BYTE) | ((uint16_t)(statRegister[REGISTER_BYTE3]));
+        if(updateStatusMirror(adbmsData, STATUS_GROUP_C, adbmsData->cellMonitor[i].statusRegisterMirror[STATUS_GROUP_C], statRegister, validFrames, STATUS_COMPARE_LOW_NO_COUNTER, STATUS_COMPARE_HIGH_ALL))
+        {
+            memcpy(&adbmsData->cellMonitor[i].statusGroupC, statRegister, REGISTER_SIZE_BYTES);
 
-        uint16_t cellAdcMismatchMask = ((uint16_t)(statRegister[REGISTER_BYTE0])) | (((uint16_t)(statRegister[REGISTER_BYTE1])) << BITS_IN_BYTE);
+            uint16_t cellAdcMismatchMask = ((uint16_t)(statRegister[REGISTER_BYTE0])) | (((uint16_t)(statRegister[REGISTER_BYTE1])) << BITS_IN_BYTE);
 
-        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
-        {
-            adbmsData->cellMonitor[i].statusGroupC.cellAdcMismatchFault[j] = ((cellAdcMismatchMask >> j) & 0x0001);
+            for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+            {
+                adbmsData->cellMonitor[i].statusGroupC.cellAdcMismatchFault[j] = ((cellAdcMismatchMask >> j) & 0x0001);
+            }
+            changedMask |= (1UL << i);
         }
+
+        adbmsData->cellMonitor[i].statusGroupC.conversionCounter = (((uint16_t)(statRegister[REGISTER_BYTE2])) << BITS_IN_BYTE) | ((uint16_t)(statRegister[REGISTER_BYTE3]));
     }
 
+    adbmsData->statusGroupChanged[STATUS_GROUP_C] = changedMask;
+
     return status;
 }
 
@@ -963,8 +1234,16 @@ TRANSACTION_STATUS_E readStatusD(ADBMS_BatteryData *adbmsData)
         packMonitorDataBuffer = transactionBuffer + ((adbmsData->chainInfo.numDevs - 1) * REGISTER_SIZE_BYTES);
     }
 
-    adbmsData->packMonitor.statusGroupD.referenceResistorVoltage = CONVERT_SIGNED_16_BIT_REGISTER(packMonitorDataBuffer, PACK_MON_VDIV_GAIN, PACK_MON_VDIV_OFFSET);
-    adbmsData->packMonitor.statusGroupD.dieTemp2 = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_DIE_TEMP2_GAIN, PACK_MON_DIE_TEMP2_OFFSET);
+    uint32_t validFrames = getValidFrameMask(adbmsData, status);
+    uint32_t changedMask = 0;
+
+    // The oscillator counters free run and are always decoded, the rest only when it changes
+    if(updateStatusMirror(adbmsData, STATUS_GROUP_D, adbmsData->packMonitor.statusRegisterMirror[STATUS_GROUP_D], packMonitorDataBuffer, validFrames, STATUS_COMPARE_LOW_ALL, STATUS_COMPARE_HIGH_NO_OSC))
+    {
+        adbmsData->packMonitor.statusGroupD.referenceResistorVoltage = CONVERT_SIGNED_16_BIT_REGISTER(packMonitorDataBuffer, PACK_MON_VDIV_GAIN, PACK_MON_VDIV_OFFSET);
+        adbmsData->packMonitor.statusGroupD.dieTemp2 = CONVERT_SIGNED_16_BIT_REGISTER((packMonitorDataBuffer + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_DIE_TEMP2_GAIN, PACK_MON_DIE_TEMP2_OFFSET);
+        changedMask |= STATUS_CHANGED_PACK_MONITOR;
+    }
     adbmsData->packMonitor.statusGroupD.oscillatorCounter = packMonitorDataBuffer[REGISTER_BYTE5];
 
     for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
@@ -973,20 +1252,15 @@ TRANSACTION_STATUS_E readStatusD(ADBMS_BatteryData *adbmsData)
 
         adbmsData->cellMonitor[i].statusGroupD.oscillatorCounter = statRegister[REGISTER_BYTE5];
 
-        uint32_t cellFault0 = (uint32_t)statRegister[REGISTER_BYTE0];
-        uint32_t cellFault1 = ((uint32_t)statRegister[REGISTER_BYTE1]) << (BITS_IN_BYTE);
-        uint32_t cellFault2 = ((uint32_t)statRegister[REGISTER_BYTE2]) << (BITS_IN_BYTE * 2);
-        uint32_t cellFault3 = ((uint32_t)statRegister[REGISTER_BYTE3]) << (BITS_IN_BYTE * 3);
-
-        uint32_t cellFaultMask = (cellFault0) | (cellFault1) | (cellFault2) | (cellFault3);
-
-        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+        if(updateStatusMirror(adbmsData, STATUS_GROUP_D, adbmsData->cellMonitor[i].statusRegisterMirror[STATUS_GROUP_D], statRegister, validFrames, STATUS_COMPARE_LOW_ALL, STATUS_COMPARE_HIGH_NO_OSC))
         {
-            adbmsData->cellMonitor[i].statusGroupD.cellUnderVoltageFault[j] = ((cellFaultMask >> (j * 2)) & 0x00000001);
-            adbmsData->cellMonitor[i].statusGroupD.cellOverVoltageFault[j] = ((cellFaultMask >> ((j * 2) + 1)) & 0x00000001);
+            decodeCellOvUvFlags(statRegister, &adbmsData->cellMonitor[i].statusGroupD);
+            changedMask |= (1UL << i);
         }
     }
 
+    adbmsData->statusGroupChanged[STATUS_GROUP_D] = changedMask;
+
     return status;
 }
 
@@ -1009,16 +1283,107 @@ TRANSACTION_STATUS_E readStatusE(ADBMS_BatteryData *adbmsData)
         packMonitorDataBuffer = transactionBuffer + ((adbmsData->chainInfo.numDevs - 1) * REGISTER_SIZE_BYTES);
     }
 
-    memcpy(&adbmsData->packMonitor.statusGroupE, packMonitorDataBuffer, REGISTER_SIZE_BYTES);
+    uint32_t validFrames = getValidFrameMask(adbmsData, status);
+    uint32_t changedMask = 0;
+
+    if(updateStatusMirror(adbmsData, STATUS_GROUP_E, adbmsData->packMonitor.statusRegisterMirror[STATUS_GROUP_E], packMonitorDataBuffer, validFrames, STATUS_COMPARE_LOW_ALL, STATUS_COMPARE_HIGH_ALL))
+    {
+        memcpy(&adbmsData->packMonitor.statusGroupE, packMonitorDataBuffer, REGISTER_SIZE_BYTES);
+        changedMask |= STATUS_CHANGED_PACK_MONITOR;
+    }
+
+    for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
+    {
+        uint8_t *statRegister = cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES);
+
+        if(updateStatusMirror(adbmsData, STATUS_GROUP_E, adbmsData->cellMonitor[i].statusRegisterMirror[STATUS_GROUP_E], statRegister, validFrames, STATUS_COMPARE_LOW_ALL, STATUS_COMPARE_HIGH_ALL))
+        {
+            memcpy(&adbmsData->cellMonitor[i].statusGroupE, statRegister + REGISTER_BYTE4, BYTES_IN_WORD);
+            changedMask |= (1UL << i);
+        }
+    }
+
+    adbmsData->statusGroupChanged[STATUS_GROUP_E] = changedMask;
+
+    return status;
+}
+
+TRANSACTION_STATUS_E readCellOvUvFlags(ADBMS_BatteryData *adbmsData)
+{
+    memset(transactionBuffer, 0x00, adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES);
+
+    TRANSACTION_STATUS_E status = readChain(RDSTATD, &adbmsData->chainInfo, transactionBuffer);
+
+    uint8_t *cellMonitorDataBuffer;
+    if(adbmsData->chainInfo.packMonitorPort == PORTA)
+    {
+        cellMonitorDataBuffer = transactionBuffer + REGISTER_SIZE_BYTES;
+    }
+    else
+    {
+        cellMonitorDataBuffer = transactionBuffer;
+    }
 
+    // Fast path, only the cell OV/UV flag bits are decoded and the status mirror is left untouched
     for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
     {
-        memcpy(&adbmsData->cellMonitor[i].statusGroupE, cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES) + REGISTER_BYTE4, BYTES_IN_WORD);
+        uint8_t *statRegister = cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES);
+        decodeCellOvUvFlags(statRegister, &adbmsData->cellMonitor[i].statusGroupD);
     }
 
     return status;
 }
 
+TRANSACTION_STATUS_E clearCellOvUvFlags(ADBMS_BatteryData *adbmsData)
+{
+    memset(transactionBuffer, 0xFF, (adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES));
+
+    return writeChain(CLOVUV, &adbmsData->chainInfo, SHARED_COMMAND, transactionBuffer);
+}
+
+TRANSACTION_STATUS_E readOvercurrentFaults(ADBMS_BatteryData *adbmsData)
+{
+    // The pack monitor frame is read into its chain position so it is mirrored like a full status read
+    uint32_t packMonitorFrame = (adbmsData->chainInfo.packMonitorPort == PORTA) ? (0) : (adbmsData->chainInfo.numDevs - 1);
+    uint8_t *packMonitorData = transactionBuffer + (packMonitorFrame * REGISTER_SIZE_BYTES);
+    memset(packMonitorData, 0x00, REGISTER_SIZE_BYTES);
+
+    TRANSACTION_STATUS_E status = readPackMonitor(RDSTATC, &adbmsData->chainInfo, packMonitorData);
+
+    // Decoded through the status mirror like readStatusC, only the pack monitor changed bit is updated
+    // The conversion counters are left as the last full status read captured them for the phase calibration
+    if(status == TRANSACTION_SUCCESS)
+    {
+        uint32_t changedMask = adbmsData->statusGroupChanged[STATUS_GROUP_C] & ~STATUS_CHANGED_PACK_MONITOR;
+
+        if(updateStatusMirror(adbmsData, STATUS_GROUP_C, adbmsData->packMonitor.statusRegisterMirror[STATUS_GROUP_C], packMonitorData, (1UL << packMonitorFrame), STATUS_COMPARE_LOW_NO_COUNTER, STATUS_COMPARE_HIGH_ALL))
+        {
+            uint16_t conversionCounter1 = adbmsData->packMonitor.statusGroupC.conversionCounter1;
+            uint16_t conversionCounter2 = adbmsData->packMonitor.statusGroupC.conversionCounter2;
+
+            memcpy(&adbmsData->packMonitor.statusGroupC, packMonitorData, REGISTER_SIZE_BYTES);
+
+            adbmsData->packMonitor.statusGroupC.conversionCounter1 = conversionCounter1;
+            adbmsData->packMonitor.statusGroupC.conversionCounter2 = conversionCounter2;
+            changedMask |= STATUS_CHANGED_PACK_MONITOR;
+        }
+
+        adbmsData->statusGroupChanged[STATUS_GROUP_C] = changedMask;
+    }
+
+    return status;
+}
+
+TRANSACTION_STATUS_E clearOvercurrentFaults(ADBMS_BatteryData *adbmsData)
+{
+    uint8_t packMonitorData[REGISTER_SIZE_BYTES] = {0};
+
+    // Only clear the overcurrent fault bytes in pack monitor status C
+    memset(packMonitorData, 0xFF, OVERCURRENT_FAULT_BYTES);
+
+    return writePackMonitor(CLRFLAG, &adbmsData->chainInfo, PACK_MONITOR_COMMAND, packMonitorData);
+}
+
 TRANSACTION_STATUS_E readCellVoltages(ADBMS_BatteryData *adbmsData, CELL_VOLTAGE_TYPE_E cellVoltageType)
 {
     memset(transactionBuffer, 0x00, adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES);
@@ -1053,7 +1418,7 @@ TRANSACTION_STATUS_E readCellVoltages(ADBMS_BatteryData *adbmsData, CELL_VOLTAGE
         {
             for(uint32_t k = 0; k < VOLTAGE_16BIT_PER_REG; k++)
             {
-                adbmsData->cellMonitor[j].cellVoltage[(i * VOLTAGE_16BIT_PER_REG) + k] = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES) + (k * VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_CELL_ADC_GAIN, CELL_MON_CELL_ADC_OFFSET);
+                adbmsData->voltageData->cellMonitor[j].cellVoltage[(i * VOLTAGE_16BIT_PER_REG) + k] = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES) + (k * VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_CELL_ADC_GAIN, CELL_MON_CELL_ADC_OFFSET);
             }
         }
     }
@@ -1067,14 +1432,14 @@ TRANSACTION_STATUS_E readCellVoltages(ADBMS_BatteryData *adbmsData, CELL_VOLTAGE
 
     for(uint32_t j = 0; j < (adbmsData->chainInfo.numDevs - 1); j++)
     {
-        adbmsData->cellMonitor[j].cellVoltage[(NUM_CELLV_REGISTERS - 1) * VOLTAGE_16BIT_PER_REG] = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES)), CELL_MON_CELL_ADC_GAIN, CELL_MON_CELL_ADC_OFFSET);
+        adbmsData->voltageData->cellMonitor[j].cellVoltage[(NUM_CELLV_REGISTERS - 1) * VOLTAGE_16BIT_PER_REG] = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES)), CELL_MON_CELL_ADC_GAIN, CELL_MON_CELL_ADC_OFFSET);
     }
 
     // Buffer[3] and Buffer[4] hold aux voltages 1-6
     for(uint32_t i = 0; i < VOLTAGE_16BIT_PER_REG; i++)
     {
-        adbmsData->packMonitor.auxVoltage[i] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[3] + (i * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
-        adbmsData->packMonitor.auxVoltage[(i + VOLTAGE_16BIT_PER_REG)] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[4] + (i * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
+        adbmsData->auxData->packMonitor.auxVoltage[i] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[3] + (i * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
+        adbmsData->auxData->packMonitor.auxVoltage[(i + VOLTAGE_16BIT_PER_REG)] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[4] + (i * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
     }
 
     if(cellVoltageType == AVERAGED_CELL_VOLTAGE)
@@ -1111,31 +1476,32 @@ TRANSACTION_STATUS_E readCellVoltages(ADBMS_BatteryData *adbmsData, CELL_VOLTAGE
     }
 
     // Buffer[0] holds IADC1 and IADC2 data
-    adbmsData->packMonitor.currentAdc1uV = CONVERT_SIGNED_24_BIT_REGISTER_UV(packRegisterData[0], PACK_MON_IADC1_GAIN_UV);
-    adbmsData->packMonitor.currentAdc2uV = CONVERT_SIGNED_24_BIT_REGISTER_UV((packRegisterData[0] + VOLTAGE_24BIT_SIZE_BYTES), PACK_MON_IADC2_GAIN_UV);
+    adbmsData->voltageData->packMonitor.currentAdc1uV = CONVERT_SIGNED_24_BIT_REGISTER_UV(packRegisterData[0], PACK_MON_IADC1_GAIN_UV);
+    adbmsData->voltageData->packMonitor.currentAdc2uV = CONVERT_SIGNED_24_BIT_REGISTER_UV((packRegisterData[0] + VOLTAGE_24BIT_SIZE_BYTES), PACK_MON_IADC2_GAIN_UV);
 
     // Buffer[1] holds VBADC1 and VBADC2 data
-    adbmsData->packMonitor.batteryVoltage1 = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[1] + VOLTAGE_16BIT_SIZE_BYTES), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
-    adbmsData->packMonitor.batteryVoltage2 = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[1] + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC2_GAIN, PACK_MON_VADC2_OFFSET);
+    adbmsData->voltageData->packMonitor.batteryVoltage1 = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[1] + VOLTAGE_16BIT_SIZE_BYTES), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
+    adbmsData->voltageData->packMonitor.batteryVoltage2 = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[1] + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC2_GAIN, PACK_MON_VADC2_OFFSET);
 
     // Buffer[3] holds IACC1 and IACC2 data
-    adbmsData->packMonitor.currentAdcAccumulator1uV = CONVERT_SIGNED_24_BIT_REGISTER_UV(packRegisterData[3], PACK_MON_IADC1_GAIN_UV);
-    adbmsData->packMonitor.currentAdcAccumulator2uV = CONVERT_SIGNED_24_BIT_REGISTER_UV((packRegisterData[3] + VOLTAGE_24BIT_SIZE_BYTES), PACK_MON_IADC2_GAIN_UV);
+    adbmsData->voltageData->packMonitor.currentAdcAccumulator1uV = CONVERT_SIGNED_24_BIT_REGISTER_UV(packRegisterData[3], PACK_MON_IADC1_GAIN_UV);
+    adbmsData->voltageData->packMonitor.currentAdcAccumulator2uV = CONVERT_SIGNED_24_BIT_REGISTER_UV((packRegisterData[3] + VOLTAGE_24BIT_SIZE_BYTES), PACK_MON_IADC2_GAIN_UV);
 
     // Buffer[4] holds VBACC1 and VBACC2 data
-    adbmsData->packMonitor.batteryVoltageAccumulator1uV = CONVERT_SIGNED_24_BIT_REGISTER_UV(packRegisterData[4], PACK_MON_VACC1_GAIN_UV);
-    adbmsData->packMonitor.batteryVoltageAccumulator2uV = CONVERT_SIGNED_24_BIT_REGISTER_UV((packRegisterData[4] + VOLTAGE_24BIT_SIZE_BYTES), PACK_MON_VACC2_GAIN_UV);
+    adbmsData->voltageData->packMonitor.batteryVoltageAccumulator1uV = CONVERT_SIGNED_24_BIT_REGISTER_UV(packRegisterData[4], PACK_MON_VACC1_GAIN_UV);
+    adbmsData->voltageData->packMonitor.batteryVoltageAccumulator2uV = CONVERT_SIGNED_24_BIT_REGISTER_UV((packRegisterData[4] + VOLTAGE_24BIT_SIZE_BYTES), PACK_MON_VACC2_GAIN_UV);
 
     // Buffer[5] hold overcurrent ADC data
     float oc1Gain = (adbmsData->packMonitor.configGroupB.oc1GainControl) ? (OVERCURRENT_GAIN2) : (OVERCURRENT_GAIN1);
     float oc2Gain = (adbmsData->packMonitor.configGroupB.oc2GainControl) ? (OVERCURRENT_GAIN2) : (OVERCURRENT_GAIN1);
     float oc3Gain = (adbmsData->packMonitor.configGroupB.oc3GainControl) ? (OVERCURRENT_GAIN2) : (OVERCURRENT_GAIN1);
 
-    adbmsData->packMonitor.overcurrentStatusGroup.overCurrentAdc1 = packRegisterData[5][REGISTER_BYTE0] * oc1Gain;
-    adbmsData->packMonitor.overcurrentStatusGroup.overCurrentAdc2 = packRegisterData[5][REGISTER_BYTE1] * oc2Gain;
-    adbmsData->packMonitor.overcurrentStatusGroup.overCurrentAdc3 = packRegisterData[5][REGISTER_BYTE2] * oc3Gain;
-    adbmsData->packMonitor.overcurrentStatusGroup.overCurrentAdc3Max = packRegisterData[5][REGISTER_BYTE4] * oc3Gain;
-    adbmsData->packMonitor.overcurrentStatusGroup.overCurrentAdc3Min = packRegisterData[5][REGISTER_BYTE5] * oc3Gain;
+    // Overcurrent ADC results are two's complement, charge current reads negative
+    adbmsData->voltageData->packMonitor.overcurrentStatusGroup.overCurrentAdc1 = (int8_t)packRegisterData[5][REGISTER_BYTE0] * oc1Gain;
+    adbmsData->voltageData->packMonitor.overcurrentStatusGroup.overCurrentAdc2 = (int8_t)packRegisterData[5][REGISTER_BYTE1] * oc2Gain;
+    adbmsData->voltageData->packMonitor.overcurrentStatusGroup.overCurrentAdc3 = (int8_t)packRegisterData[5][REGISTER_BYTE2] * oc3Gain;
+    adbmsData->voltageData->packMonitor.overcurrentStatusGroup.overCurrentAdc3Max = (int8_t)packRegisterData[5][REGISTER_BYTE4] * oc3Gain;
+    adbmsData->voltageData->packMonitor.overcurrentStatusGroup.overCurrentAdc3Min = (int8_t)packRegisterData[5][REGISTER_BYTE5] * oc3Gain;
 
     return status;
 }
@@ -1162,7 +1528,7 @@ TRANSACTION_STATUS_E readRedundantCellVoltages(ADBMS_BatteryData *adbmsData)
     {
         if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
         {
-            status = readChain(redundantAuxVoltageCode[i], &adbmsData->chainInfo, transactionBuffer);
+            status = readChain(redundantCellVoltageCode[i], &adbmsData->chainInfo, transactionBuffer);
         }
 
         for(uint32_t j = 0; j < (adbmsData->chainInfo.numDevs - 1); j++)
@@ -1176,7 +1542,7 @@ TRANSACTION_STATUS_E readRedundantCellVoltages(ADBMS_BatteryData *adbmsData)
 
     if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
     {
-        status = readChain(redundantAuxVoltageCode[NUM_CELLV_REGISTERS - 1], &adbmsData->chainInfo, transactionBuffer);
+        status = readChain(redundantCellVoltageCode[NUM_CELLV_REGISTERS - 1], &adbmsData->chainInfo, transactionBuffer);
     }
 
     for(uint32_t j = 0; j < (adbmsData->chainInfo.numDevs - 1); j++)
@@ -1221,7 +1587,7 @@ TRANSACTION_STATUS_E readAuxVoltages(ADBMS_BatteryData * adbmsData)
         {
             for(uint32_t k = 0; k < VOLTAGE_16BIT_PER_REG; k++)
             {
-                adbmsData->cellMonitor[j].auxVoltage[(i * VOLTAGE_16BIT_PER_REG) + k] = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES) + (k * VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
+                adbmsData->auxData->cellMonitor[j].auxVoltage[(i * VOLTAGE_16BIT_PER_REG) + k] = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES) + (k * VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
             }
         }
     }
@@ -1235,25 +1601,25 @@ TRANSACTION_STATUS_E readAuxVoltages(ADBMS_BatteryData * adbmsData)
 
     for(uint32_t j = 0; j < (adbmsData->chainInfo.numDevs - 1); j++)
     {
-        adbmsData->cellMonitor[j].auxVoltage[(NUM_AUXV_REGISTERS - 1) * VOLTAGE_16BIT_PER_REG] = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
-        adbmsData->cellMonitor[j].switch1Voltage = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES) + (VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
-        adbmsData->cellMonitor[j].hvSupplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES) + (2 * VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_HV_SUPPLY_GAIN, CELL_MON_HV_SUPPLY_OFFSET);
+        adbmsData->auxData->cellMonitor[j].auxVoltage[(NUM_AUXV_REGISTERS - 1) * VOLTAGE_16BIT_PER_REG] = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
+        adbmsData->auxData->cellMonitor[j].switch1Voltage = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES) + (VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_AUX_ADC_GAIN, CELL_MON_AUX_ADC_OFFSET);
+        adbmsData->auxData->cellMonitor[j].hvSupplyVoltage = CONVERT_SIGNED_16_BIT_REGISTER((cellMonitorDataBuffer + (j * REGISTER_SIZE_BYTES) + (2 * VOLTAGE_16BIT_SIZE_BYTES)), CELL_MON_HV_SUPPLY_GAIN, CELL_MON_HV_SUPPLY_OFFSET);
     }
 
      // Buffer[0], Buffer[1], and Buffer[2] hold aux voltages 1-9
     for(uint32_t i = 0; i < VOLTAGE_16BIT_PER_REG; i++)
     {
-        adbmsData->packMonitor.auxVoltage[i] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[0] + (i * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
-        adbmsData->packMonitor.auxVoltage[(i + VOLTAGE_16BIT_PER_REG)] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[1] + (i * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
+        adbmsData->auxData->packMonitor.auxVoltage[i] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[0] + (i * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
+        adbmsData->auxData->packMonitor.auxVoltage[(i + VOLTAGE_16BIT_PER_REG)] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[1] + (i * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
     }
 
-    adbmsData->packMonitor.auxVoltage[(2 * VOLTAGE_16BIT_PER_REG)]  = CONVERT_SIGNED_16_BIT_REGISTER(packRegisterData[2], PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
-    adbmsData->packMonitor.auxVoltage[(2 * VOLTAGE_16BIT_PER_REG) + 1] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[2] + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
-    adbmsData->packMonitor.auxVoltage[(2 * VOLTAGE_16BIT_PER_REG) + 2] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[2] + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC2_GAIN, PACK_MON_VADC2_OFFSET);
+    adbmsData->auxData->packMonitor.auxVoltage[(2 * VOLTAGE_16BIT_PER_REG)]  = CONVERT_SIGNED_16_BIT_REGISTER(packRegisterData[2], PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
+    adbmsData->auxData->packMonitor.auxVoltage[(2 * VOLTAGE_16BIT_PER_REG) + 1] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[2] + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
+    adbmsData->auxData->packMonitor.auxVoltage[(2 * VOLTAGE_16BIT_PER_REG) + 2] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[2] + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC2_GAIN, PACK_MON_VADC2_OFFSET);
 
-    adbmsData->packMonitor.auxVoltage[(3 * VOLTAGE_16BIT_PER_REG)] = CONVERT_SIGNED_16_BIT_REGISTER(packRegisterData[3], PACK_MON_VADC2_GAIN, PACK_MON_VADC2_OFFSET);
-    adbmsData->packMonitor.referenceVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[3] + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VREF2A_GAIN, PACK_MON_VREF2A_OFFSET);
-    adbmsData->packMonitor.redundantReferenceVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[3] + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VREF2B_GAIN, PACK_MON_VREF2B_OFFSET);
+    adbmsData->auxData->packMonitor.auxVoltage[(3 * VOLTAGE_16BIT_PER_REG)] = CONVERT_SIGNED_16_BIT_REGISTER(packRegisterData[3], PACK_MON_VADC2_GAIN, PACK_MON_VADC2_OFFSET);
+    adbmsData->auxData->packMonitor.referenceVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[3] + (VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VREF2A_GAIN, PACK_MON_VREF2A_OFFSET);
+    adbmsData->auxData->packMonitor.redundantReferenceVoltage = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[3] + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VREF2B_GAIN, PACK_MON_VREF2B_OFFSET);
 
     return status;
 }
@@ -1318,3 +1684,243 @@ TRANSACTION_STATUS_E readRedundantAuxVoltages(ADBMS_BatteryData * adbmsData)
 
     return status;
 }
+
+TRANSACTION_STATUS_E readPackCurrent(ADBMS_BatteryData *adbmsData)
+{
+    uint8_t packRegisterData[REGISTER_SIZE_BYTES];
+    memset(packRegisterData, 0x00, REGISTER_SIZE_BYTES);
+
+    // Only the pack monitor is addressed, RDCVA holds IADC1 and IADC2 data
+    TRANSACTION_STATUS_E status = readPackMonitor(RDCVA, &adbmsData->chainInfo, packRegisterData);
+
+    if(status == TRANSACTION_SUCCESS)
+    {
+        adbmsData->voltageData->packMonitor.currentAdc1uV = CONVERT_SIGNED_24_BIT_REGISTER_UV(packRegisterData, PACK_MON_IADC1_GAIN_UV);
+        adbmsData->voltageData->packMonitor.currentAdc2uV = CONVERT_SIGNED_24_BIT_REGISTER_UV((packRegisterData + VOLTAGE_24BIT_SIZE_BYTES), PACK_MON_IADC2_GAIN_UV);
+    }
+
+    return status;
+}
+
+TRANSACTION_STATUS_E readPackCurrentAccumulators(ADBMS_BatteryData *adbmsData)
+{
+    uint8_t packRegisterData[REGISTER_SIZE_BYTES];
+    memset(packRegisterData, 0x00, REGISTER_SIZE_BYTES);
+
+    // Only the pack monitor is addressed, RDACA holds IACC1 and IACC2 data
+    TRANSACTION_STATUS_E status = readPackMonitor(RDACA, &adbmsData->chainInfo, packRegisterData);
+
+    if(status == TRANSACTION_SUCCESS)
+    {
+        adbmsData->voltageData->packMonitor.currentAdcAccumulator1uV = CONVERT_SIGNED_24_BIT_REGISTER_UV(packRegisterData, PACK_MON_IADC1_GAIN_UV);
+        adbmsData->voltageData->packMonitor.currentAdcAccumulator2uV = CONVERT_SIGNED_24_BIT_REGISTER_UV((packRegisterData + VOLTAGE_24BIT_SIZE_BYTES), PACK_MON_IADC2_GAIN_UV);
+    }
+
+    return status;
+}
+
+TRANSACTION_STATUS_E readPackLinkVoltages(ADBMS_BatteryData *adbmsData)
+{
+    uint8_t packRegisterData[2][REGISTER_SIZE_BYTES];
+    memset(packRegisterData, 0x00, 2 * REGISTER_SIZE_BYTES);
+
+    // Only the pack monitor is addressed, RDAUXB holds V4 to V6 and RDCVB holds VBADC1 and VBADC2 data
+    TRANSACTION_STATUS_E status = readPackMonitor(RDAUXB, &adbmsData->chainInfo, packRegisterData[0]);
+
+    if(status == TRANSACTION_SUCCESS)
+    {
+        status = readPackMonitor(RDCVB, &adbmsData->chainInfo, packRegisterData[1]);
+    }
+
+    if(status == TRANSACTION_SUCCESS)
+    {
+        for(uint32_t i = 0; i < VOLTAGE_16BIT_PER_REG; i++)
+        {
+            adbmsData->auxData->packMonitor.auxVoltage[(i + VOLTAGE_16BIT_PER_REG)] = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[0] + (i * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
+        }
+
+        adbmsData->voltageData->packMonitor.batteryVoltage1 = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[1] + VOLTAGE_16BIT_SIZE_BYTES), PACK_MON_VADC1_GAIN, PACK_MON_VADC1_OFFSET);
+        adbmsData->voltageData->packMonitor.batteryVoltage2 = CONVERT_SIGNED_16_BIT_REGISTER((packRegisterData[1] + (2 * VOLTAGE_16BIT_SIZE_BYTES)), PACK_MON_VADC2_GAIN, PACK_MON_VADC2_OFFSET);
+    }
+
+    return status;
+}
+
+TRANSACTION_STATUS_E enableLpcm(ADBMS_BatteryData *adbmsData)
+{
+    return commandChain(CMEN, &adbmsData->chainInfo, CELL_MONITOR_COMMAND);
+}
+
+TRANSACTION_STATUS_E disableLpcm(ADBMS_BatteryData *adbmsData)
+{
+    return commandChain(CMDIS, &adbmsData->chainInfo, CELL_MONITOR_COMMAND);
+}
+
+TRANSACTION_STATUS_E sendLpcmHeartbeat(ADBMS_BatteryData *adbmsData)
+{
+    return commandChain(CMHB2, &adbmsData->chainInfo, CELL_MONITOR_COMMAND);
+}
+
+TRANSACTION_STATUS_E writeLpcmConfig(ADBMS_BatteryData *adbmsData)
+{
+    memset(transactionBuffer, 0x00, adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES);
+
+    uint8_t *cellMonitorDataBuffer;
+    if(adbmsData->chainInfo.packMonitorPort == PORTA)
+    {
+        cellMonitorDataBuffer = transactionBuffer + REGISTER_SIZE_BYTES;
+    }
+    else
+    {
+        cellMonitorDataBuffer = transactionBuffer;
+    }
+
+    for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
+    {
+        memcpy(cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES), &adbmsData->cellMonitor[i].lpcmConfig, REGISTER_SIZE_BYTES);
+    }
+
+    return writeChain(WRCMCFG, &adbmsData->chainInfo, SHARED_COMMAND, transactionBuffer);
+}
+
+TRANSACTION_STATUS_E writeLpcmThresholds(ADBMS_BatteryData *adbmsData)
+{
+    memset(transactionBuffer, 0x00, adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES);
+
+    uint8_t *cellMonitorDataBuffer;
+    if(adbmsData->chainInfo.packMonitorPort == PORTA)
+    {
+        cellMonitorDataBuffer = transactionBuffer + REGISTER_SIZE_BYTES;
+    }
+    else
+    {
+        cellMonitorDataBuffer = transactionBuffer;
+    }
+
+    // Cell thresholds
+    for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
+    {
+        ADBMS_LpcmThresholdCellMonitor *threshold = &adbmsData->cellMonitor[i].lpcmThreshold;
+        encodeLpcmThresholds(cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES), threshold->cellUnderVoltage, threshold->cellOverVoltage, threshold->cellDeltaVoltage);
+    }
+
+    TRANSACTION_STATUS_E status = writeChain(WRCMCELLT, &adbmsData->chainInfo, SHARED_COMMAND, transactionBuffer);
+    if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        return status;
+    }
+
+    // GPIO thresholds
+    for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
+    {
+        ADBMS_LpcmThresholdCellMonitor *threshold = &adbmsData->cellMonitor[i].lpcmThreshold;
+        encodeLpcmThresholds(cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES), threshold->gpioUnderVoltage, threshold->gpioOverVoltage, threshold->gpioDeltaVoltage);
+    }
+
+    return writeChain(WRCMGPIOT, &adbmsData->chainInfo, SHARED_COMMAND, transactionBuffer);
+}
+
+TRANSACTION_STATUS_E readLpcmFlags(ADBMS_BatteryData *adbmsData)
+{
+    memset(transactionBuffer, 0x00, adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES);
+
+    TRANSACTION_STATUS_E status = readChain(RDCMFLAG, &adbmsData->chainInfo, transactionBuffer);
+
+    uint8_t *cellMonitorDataBuffer;
+    if(adbmsData->chainInfo.packMonitorPort == PORTA)
+    {
+        cellMonitorDataBuffer = transactionBuffer + REGISTER_SIZE_BYTES;
+    }
+    else
+    {
+        cellMonitorDataBuffer = transactionBuffer;
+    }
+
+    for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
+    {
+        memcpy(&adbmsData->cellMonitor[i].lpcmFlags, cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES), sizeof(ADBMS_LpcmFlagsCellMonitor));
+    }
+
+    return status;
+}
+
+TRANSACTION_STATUS_E clearLpcmFlags(ADBMS_BatteryData *adbmsData)
+{
+    memset(transactionBuffer, 0xFF, (adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES));
+
+    return writeChain(CLRCMFLAG, &adbmsData->chainInfo, SHARED_COMMAND, transactionBuffer);
+}
+
+TRANSACTION_STATUS_E writeCommRegisters(ADBMS_BatteryData *adbmsData)
+{
+    uint8_t *packMonitorDataBuffer;
+    uint8_t *cellMonitorDataBuffer;
+    if(adbmsData->chainInfo.packMonitorPort == PORTA)
+    {
+        packMonitorDataBuffer = transactionBuffer;
+        cellMonitorDataBuffer = transactionBuffer + REGISTER_SIZE_BYTES;
+    }
+    else
+    {
+        cellMonitorDataBuffer = transactionBuffer;
+        packMonitorDataBuffer = transactionBuffer + ((adbmsData->chainInfo.numDevs - 1) * REGISTER_SIZE_BYTES);
+    }
+
+    // The pack monitor does not take part in pass-through transfers
+    for(uint32_t j = 0; j < NUM_COMM_BYTES; j++)
+    {
+        packMonitorDataBuffer[(j * COMM_BYTES_PER_DATA)] = (uint8_t)((ICOM_I2C_NO_TRANSMIT << COMM_NIBBLE_BITS) | COMM_NIBBLE_MASK);
+        packMonitorDataBuffer[(j * COMM_BYTES_PER_DATA) + 1] = (uint8_t)((COMM_NIBBLE_MASK << COMM_NIBBLE_BITS) | FCOM_I2C_MASTER_NACK_STOP);
+    }
+
+    for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
+    {
+        uint8_t *deviceRegister = cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES);
+        ADBMS_CommCellMonitor *comm = &adbmsData->cellMonitor[i].commGroup;
+
+        for(uint32_t j = 0; j < NUM_COMM_BYTES; j++)
+        {
+            deviceRegister[(j * COMM_BYTES_PER_DATA)] = (uint8_t)(((comm->initialControl[j] & COMM_NIBBLE_MASK) << COMM_NIBBLE_BITS) | (comm->data[j] >> COMM_NIBBLE_BITS));
+            deviceRegister[(j * COMM_BYTES_PER_DATA) + 1] = (uint8_t)(((comm->data[j] & COMM_NIBBLE_MASK) << COMM_NIBBLE_BITS) | (comm->finalControl[j] & COMM_NIBBLE_MASK));
+        }
+    }
+
+    return writeChain(WRCOMM, &adbmsData->chainInfo, SHARED_COMMAND, transactionBuffer);
+}
+
+TRANSACTION_STATUS_E startCommTransfer(ADBMS_BatteryData *adbmsData)
+{
+    return clockedCommandChain(STCOMM, &adbmsData->chainInfo, SHARED_COMMAND, COMM_CLOCK_BYTES);
+}
+
+TRANSACTION_STATUS_E readCommRegisters(ADBMS_BatteryData *adbmsData)
+{
+    memset(transactionBuffer, 0x00, adbmsData->chainInfo.numDevs * REGISTER_SIZE_BYTES);
+
+    TRANSACTION_STATUS_E status = readChain(RDCOMM, &adbmsData->chainInfo, transactionBuffer);
+
+    uint8_t *cellMonitorDataBuffer;
+    if(adbmsData->chainInfo.packMonitorPort == PORTA)
+    {
+        cellMonitorDataBuffer = transactionBuffer + REGISTER_SIZE_BYTES;
+    }
+    else
+    {
+        cellMonitorDataBuffer = transactionBuffer;
+    }
+
+    // Only the received data bytes are decoded, the control nibbles read back as status codes
+    for(uint32_t i = 0; i < (adbmsData->chainInfo.numDevs - 1); i++)
+    {
+        uint8_t *deviceRegister = cellMonitorDataBuffer + (i * REGISTER_SIZE_BYTES);
+
+        for(uint32_t j = 0; j < NUM_COMM_BYTES; j++)
+        {
+            uint8_t dataHigh = deviceRegister[(j * COMM_BYTES_PER_DATA)] & COMM_NIBBLE_MASK;
+            uint8_t dataLow = deviceRegister[(j * COMM_BYTES_PER_DATA) + 1] >> COMM_NIBBLE_BITS;
+            adbmsData->cellMonitor[i].commGroup.data[j] = (uint8_t)((dataHigh << COMM_NIBBLE_BITS) | dataLow);
+        }
+    }
+
+    return status;
+}
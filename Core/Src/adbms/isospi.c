@@ -156,10 +156,11 @@ static void incCommandCounter(COMMAND_TYPE_E commandType, uint32_t* localCommand
 /**
  * @brief Send a command over isospi
  * @param command Command code to send
+ * @param numClockBytes Number of dummy bytes clocked after the command with CS held low
  * @param port Isospi port on which to issue command
  * @return Transaction status error code
  */
-static TRANSACTION_STATUS_E sendCommand(uint16_t command, PORT_E port);
+static TRANSACTION_STATUS_E sendCommand(uint16_t command, uint32_t numClockBytes, PORT_E port);
 
 /**
  * @brief Write data over isospi - data buffer should include 6 bytes per device
@@ -304,12 +305,12 @@ static void resetCommandCounter(CHAIN_STATUS_E chainStatus, uint32_t* localComma
     // Reset the device command counters
     if(chainStatus == CHAIN_COMPLETE)
     {
-        sendCommand(RSTCC, PORTA);
+        sendCommand(RSTCC, 0, PORTA);
     }
     else
     {
-        sendCommand(RSTCC, PORTA);
-        sendCommand(RSTCC, PORTB);
+        sendCommand(RSTCC, 0, PORTA);
+        sendCommand(RSTCC, 0, PORTB);
     }
 }
 
@@ -344,10 +345,11 @@ static void incCommandCounter(COMMAND_TYPE_E commandType, uint32_t* localCommand
 /**
  * @brief Send a command over isospi
  * @param command Command code to send
+ * @param numClockBytes Number of dummy bytes clocked after the command with CS held low
  * @param port Isospi port on which to issue command
  * @return Transaction status error code
  */
-static TRANSACTION_STATUS_E sendCommand(uint16_t command, PORT_E port)
+static TRANSACTION_STATUS_E sendCommand(uint16_t command, uint32_t numClockBytes, PORT_E port)
 {
     // Populate the tx buffer with the command word
     txBuffer[0] = (uint8_t)(command >> BITS_IN_BYTE);
@@ -358,9 +360,16 @@ static TRANSACTION_STATUS_E sendCommand(uint16_t command, PORT_E port)
     txBuffer[2] = (uint8_t)(commandCRC >> BITS_IN_BYTE);
     txBuffer[3] = (uint8_t)(commandCRC);
 
+    // Commands like STCOMM need extra clock cycles to shift out data
+    if(numClockBytes > (MAX_SPI_BUFFER - COMMAND_PACKET_LENGTH))
+    {
+        numClockBytes = (MAX_SPI_BUFFER - COMMAND_PACKET_LENGTH);
+    }
+    memset((txBuffer + COMMAND_PACKET_LENGTH), 0xFF, numClockBytes);
+
     // SPIify
     openPort(port);
-    if(taskNotifySPI(&hspi1, txBuffer, rxBuffer, COMMAND_PACKET_LENGTH, SPI_TIMEOUT_MS) != SPI_SUCCESS)
+    if(taskNotifySPI(&hspi1, txBuffer, rxBuffer, (COMMAND_PACKET_LENGTH + numClockBytes), SPI_TIMEOUT_MS) != SPI_SUCCESS)
     {
         closePort(port);
         return TRANSACTION_SPI_ERROR;
@@ -666,13 +675,26 @@ TRANSACTION_STATUS_E updateChainStatus(CHAIN_INFO_S *chainInfo)
  * @return Transaction status error code
  */
 TRANSACTION_STATUS_E commandChain(uint16_t command, CHAIN_INFO_S *chainInfo, COMMAND_TYPE_E commandType)
+{
+    return clockedCommandChain(command, chainInfo, commandType, 0);
+}
+
+/**
+ * @brief Send a command on the device daisy chain followed by extra clock cycles
+ * @param command Command code to send
+ * @param chainInfo Chain data struct
+ * @param commandType The type of command to determine which devices will recognize the command
+ * @param numClockBytes Number of dummy bytes clocked after the command
+ * @return Transaction status error code
+ */
+TRANSACTION_STATUS_E clockedCommandChain(uint16_t command, CHAIN_INFO_S *chainInfo, COMMAND_TYPE_E commandType, uint32_t numClockBytes)
 {
     // Check the current assumed chain status
     if(chainInfo->chainStatus == CHAIN_COMPLETE)
     {
         // When the chain is complete, send the command using the current chain port
         // sendCommand will return either success or a spi error
-        TRANSACTION_STATUS_E status = sendCommand(command, chainInfo->currentPort);
+        TRANSACTION_STATUS_E status = sendCommand(command, numClockBytes, chainInfo->currentPort);
 
         // Increment command counter
         incCommandCounter(commandType, chainInfo->localCommandCounter);
@@ -689,13 +711,13 @@ TRANSACTION_STATUS_E commandChain(uint16_t command, CHAIN_INFO_S *chainInfo, COM
         // Only send a command if there are devices available on the port
         if(chainInfo->availableDevices[PORTA] > 0)
         {
-            portAStatus = sendCommand(command, PORTA);
+            portAStatus = sendCommand(command, numClockBytes, PORTA);
         }
 
         // Only send a command if there are devices available on the port
         if(chainInfo->availableDevices[PORTB] > 0)
         {
-            portBStatus = sendCommand(command, PORTB);
+            portBStatus = sendCommand(command, numClockBytes, PORTB);
         }
 
         // Increment command counter
@@ -33,6 +33,30 @@ static bool undervoltageFaultPresent(telemetryTaskData_S* telemetryData)
     return (telemetryData->minCellVoltage < MIN_BRICK_FAULT_VOLTAGE);
 }
 
+static bool hardwareOvervoltageFaultPresent(telemetryTaskData_S* telemetryData)
+{
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        if(telemetryData->bmb[i].cellOverVoltageFlags != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool hardwareUndervoltageFaultPresent(telemetryTaskData_S* telemetryData)
+{
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        if(telemetryData->bmb[i].cellUnderVoltageFlags != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 static bool cellImbalancePresent(telemetryTaskData_S* telemetryData)
 {
     return (telemetryData->cellImbalance > MAX_CELL_IMBALANCE_V);
@@ -111,7 +135,25 @@ static bool telemetryCommunicationErrorPresent(telemetryTaskData_S* telemetryDat
 
 static bool packOvercurrentFaultPresent(telemetryTaskData_S* telemetryData)
 {
-    return ((telemetryData->packMonitor.packCurrent <= -ABS_MAX_DISCHARGE_CURRENT_A) || (telemetryData->packMonitor.packCurrent >= ABS_MAX_CHARGE_CURRENT_A));
+    bool hardwareOvercurrent = (telemetryData->packMonitor.overcurrent1Fault || telemetryData->packMonitor.overcurrent2Fault || telemetryData->packMonitor.overcurrent3Fault);
+
+    // The peak includes every high rate sample since the last cycle, so a spike between snapshots is not missed
+    float peakCurrent = telemetryData->packMonitor.peakPackCurrent;
+    bool peakOvercurrent = ((peakCurrent <= -ABS_MAX_DISCHARGE_CURRENT_A) || (peakCurrent >= ABS_MAX_CHARGE_CURRENT_A));
+
+    return ((telemetryData->packMonitor.packCurrent <= -ABS_MAX_DISCHARGE_CURRENT_A) || (telemetryData->packMonitor.packCurrent >= ABS_MAX_CHARGE_CURRENT_A) || peakOvercurrent || hardwareOvercurrent);
+}
+
+static bool openWirePresent(telemetryTaskData_S* telemetryData)
+{
+    for(uint32_t i = 0; i < NUM_CELLS_IN_ACCUMULATOR; i++)
+    {
+        if(telemetryData->cells.cellOpenWire[i] || telemetryData->cells.cellTempOpenWire[i])
+        {
+            return true;
+        }
+    }
+    return false;
 }
 
 // Status update task
@@ -268,6 +310,30 @@ Alert_S undervoltageFaultAlert =
     .numAlertResponse = NUM_UNDERVOLTAGE_FAULT_ALERT_RESPONSE, .alertResponse = undervoltageFaultAlertResponse
 };
 
+// Hardware Overvoltage Fault Alert
+const AlertResponse_E hardwareOvervoltageFaultAlertResponse[] = { DISABLE_CHARGING, EMERGENCY_BLEED, AMS_FAULT};
+#define NUM_HARDWARE_OVERVOLTAGE_FAULT_ALERT_RESPONSE sizeof(hardwareOvervoltageFaultAlertResponse) / sizeof(AlertResponse_E)
+Alert_S hardwareOvervoltageFaultAlert = 
+{ 
+    .alertName = "HardwareOvervoltageFault", .latching = true,
+    .alertStatus = ALERT_CLEARED, .alertTimer = (Timer_S){.timCount = 0, .lastUpdate = 0, .timThreshold = HARDWARE_OVERVOLTAGE_FAULT_ALERT_SET_TIME_MS}, 
+    .setTime_MS = HARDWARE_OVERVOLTAGE_FAULT_ALERT_SET_TIME_MS, .clearTime_MS = HARDWARE_OVERVOLTAGE_FAULT_ALERT_CLEAR_TIME_MS, 
+    .alertConditionPresent = false, 
+    .numAlertResponse = NUM_HARDWARE_OVERVOLTAGE_FAULT_ALERT_RESPONSE, .alertResponse =  hardwareOvervoltageFaultAlertResponse
+};
+
+// Hardware Undervoltage Fault Alert
+const AlertResponse_E hardwareUndervoltageFaultAlertResponse[] = { AMS_FAULT };
+#define NUM_HARDWARE_UNDERVOLTAGE_FAULT_ALERT_RESPONSE sizeof(hardwareUndervoltageFaultAlertResponse) / sizeof(AlertResponse_E)
+Alert_S hardwareUndervoltageFaultAlert = 
+{ 
+    .alertName = "HardwareUndervoltageFault", .latching = true,
+    .alertStatus = ALERT_CLEARED, .alertTimer = (Timer_S){.timCount = 0, .lastUpdate = 0, .timThreshold = HARDWARE_UNDERVOLTAGE_FAULT_ALERT_SET_TIME_MS}, 
+    .setTime_MS = HARDWARE_UNDERVOLTAGE_FAULT_ALERT_SET_TIME_MS, .clearTime_MS = HARDWARE_UNDERVOLTAGE_FAULT_ALERT_CLEAR_TIME_MS, 
+    .alertConditionPresent = false,
+    .numAlertResponse = NUM_HARDWARE_UNDERVOLTAGE_FAULT_ALERT_RESPONSE, .alertResponse = hardwareUndervoltageFaultAlertResponse
+};
+
 // IMD Shut Down Circuit Alert
 const AlertResponse_E imdSdcAlertResponse[] = { INFO_ONLY };
 #define NUM_IMD_SDC_ALERT_RESPONSE sizeof(imdSdcAlertResponse) / sizeof(AlertResponse_E)
@@ -412,6 +478,18 @@ Alert_S packOvercurrentFaultAlert =
     .numAlertResponse = NUM_PACK_OVERCURRENT_FAULT_ALERT_RESPONSE, .alertResponse = packOvercurrentFaultAlertResponse
 };
 
+// Open cell voltage or thermistor sense wire
+const AlertResponse_E openWireAlertResponse[] = { DISABLE_BALANCING };
+#define NUM_OPEN_WIRE_ALERT_RESPONSE sizeof(openWireAlertResponse) / sizeof(AlertResponse_E)
+Alert_S openWireAlert = 
+{
+    .alertName = "OpenWire",
+    .alertStatus = ALERT_CLEARED, .alertTimer = (Timer_S){.timCount = 0, .lastUpdate = 0, .timThreshold = OPEN_WIRE_ALERT_SET_TIME_MS}, 
+    .setTime_MS = OPEN_WIRE_ALERT_SET_TIME_MS, .clearTime_MS = OPEN_WIRE_ALERT_CLEAR_TIME_MS, 
+    .alertConditionPresent = false,
+    .numAlertResponse = NUM_OPEN_WIRE_ALERT_RESPONSE, .alertResponse = openWireAlertResponse
+};
+
 // Telemetry alerts
 
 Alert_S* telemetryAlerts[] = 
@@ -428,7 +506,10 @@ Alert_S* telemetryAlerts[] =
     &badBoardTempSenseStatusAlert,
     &insufficientTempSensorsAlert,
     &telemetryCommunicationAlert,
-    &packOvercurrentFaultAlert
+    &packOvercurrentFaultAlert,
+    &hardwareOvervoltageFaultAlert,
+    &hardwareUndervoltageFaultAlert,
+    &openWireAlert
 };
 
 Alert_S* statusAlerts[] = 
@@ -452,7 +533,10 @@ telemetryAlertCondition telemetryAlertConditionArray[] =
     badBoardTempSensorStatusPresent,
     insufficientTempSensePresent,
     telemetryCommunicationErrorPresent,
-    packOvercurrentFaultPresent
+    packOvercurrentFaultPresent,
+    hardwareOvervoltageFaultPresent,
+    hardwareUndervoltageFaultPresent,
+    openWirePresent
 };
 
 statusAlertCondition statusAlertConditionArray[] = 
@@ -0,0 +1,313 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+#include "burstCapture.h"
+#include "telemetry.h"
+#include "alerts.h"
+#include "packData.h"
+#include "main.h"
+#include "cmsis_os.h"
+#include <math.h>
+#include <stdlib.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+#define BURST_DEFAULT_OVERCURRENT_THRES_A   (0.8f * ABS_MAX_DISCHARGE_CURRENT_A)
+#define BURST_DEFAULT_CELL_SAG_THRES_V      0.1f
+#define BURST_ALL_TRIGGERS                  ((1 << NUM_BURST_TRIGGERS) - 1)
+
+// Alerts are tracked as bits of a 32 bit mask
+#define BURST_MAX_ALERTS                    32
+
+_Static_assert((BURST_CURRENT_SAMPLES_PER_FRAME % 2) == 0, "Burst current samples are merged in pairs");
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+// Frame ring, frame n is held in slot n % BURST_CAPTURE_NUM_FRAMES
+// The capture side owns the ring until it freezes, the drain side owns it until it re-arms
+static Burst_Frame_S burstFrames[BURST_CAPTURE_NUM_FRAMES];
+static uint32_t numFramesWritten = 0;
+static uint32_t firstValidFrame = 0;
+static volatile BURST_CAPTURE_STATE_E burstState = BURST_CAPTURE_ARMED;
+
+static Burst_Capture_Config_S burstConfig =
+{
+    .triggerMask = BURST_ALL_TRIGGERS,
+    .preTriggerFrames = BURST_DEFAULT_PRE_TRIGGER_FRAMES,
+    .postTriggerFrames = BURST_DEFAULT_POST_TRIGGER_FRAMES,
+    .overcurrentThresA = BURST_DEFAULT_OVERCURRENT_THRES_A,
+    .cellSagThresV = BURST_DEFAULT_CELL_SAG_THRES_V
+};
+
+// Written by configureBurstCapture from any task, taken by the telemetry task while armed
+static Burst_Capture_Config_S pendingConfig;
+static bool configPending = false;
+
+// Capture window of the frozen or pending capture
+static BURST_TRIGGER_E burstTrigger;
+static uint32_t triggerFrame = 0;
+static uint32_t postTriggerFramesRemaining = 0;
+static uint32_t drainFrame = 0;
+static uint32_t drainEndFrame = 0;
+
+// Trigger inputs carried between cycles
+static uint32_t currentSampleReadIndex = 0;
+static uint32_t lastAlertMask = 0;
+static bool manualTriggerPending = false;
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DECLARATIONS ==================== */
+/* ==================================================================== */
+
+static int16_t compressSample(float value, float lsb);
+static int16_t largerMagnitude(int16_t sample1, int16_t sample2);
+static void recordCurrentSamples(Burst_Frame_S *frame, float *peakCurrentA);
+static bool checkBurstTriggers(telemetryTaskData_S *taskData, float peakCurrentA, float maxCellSagV, bool alertSet, bool manualTrigger, BURST_TRIGGER_E *trigger);
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+static int16_t compressSample(float value, float lsb)
+{
+    float counts = roundf(value / lsb);
+
+    if(counts > (float)INT16_MAX)
+    {
+        return INT16_MAX;
+    }
+    else if(counts < (float)INT16_MIN)
+    {
+        return INT16_MIN;
+    }
+
+    return (int16_t)counts;
+}
+
+static int16_t largerMagnitude(int16_t sample1, int16_t sample2)
+{
+    return (abs(sample1) >= abs(sample2)) ? (sample1) : (sample2);
+}
+
+static void recordCurrentSamples(Burst_Frame_S *frame, float *peakCurrentA)
+{
+    Current_Sample_S currentSamples[BURST_CURRENT_SAMPLES_PER_FRAME];
+    uint32_t numCurrentSamples;
+    uint32_t binSamples = 0;
+
+    frame->numCurrentSamples = 0;
+    frame->currentSampleDecimation = 1;
+
+    // Take the samples a chunk at a time, halving the frame resolution each time it fills up
+    while((numCurrentSamples = getCurrentSamples(currentSamples, BURST_CURRENT_SAMPLES_PER_FRAME, &currentSampleReadIndex)) > 0)
+    {
+        for(uint32_t i = 0; i < numCurrentSamples; i++)
+        {
+            int16_t sample = compressSample(currentSamples[i].instantCurrent, BURST_CURRENT_LSB_A);
+            *peakCurrentA = fmaxf(*peakCurrentA, fabsf(currentSamples[i].instantCurrent));
+
+            if(binSamples == 0)
+            {
+                if(frame->numCurrentSamples == BURST_CURRENT_SAMPLES_PER_FRAME)
+                {
+                    // Merge neighbouring samples, keeping the larger magnitude so current spikes survive
+                    for(uint32_t j = 0; j < (BURST_CURRENT_SAMPLES_PER_FRAME / 2); j++)
+                    {
+                        frame->packCurrent[j] = largerMagnitude(frame->packCurrent[2 * j], frame->packCurrent[(2 * j) + 1]);
+                    }
+                    frame->numCurrentSamples = BURST_CURRENT_SAMPLES_PER_FRAME / 2;
+                    frame->currentSampleDecimation *= 2;
+                }
+                frame->packCurrent[frame->numCurrentSamples++] = sample;
+            }
+            else
+            {
+                frame->packCurrent[frame->numCurrentSamples - 1] = largerMagnitude(frame->packCurrent[frame->numCurrentSamples - 1], sample);
+            }
+
+            binSamples = (binSamples + 1) % frame->currentSampleDecimation;
+        }
+    }
+}
+
+static bool checkBurstTriggers(telemetryTaskData_S *taskData, float peakCurrentA, float maxCellSagV, bool alertSet, bool manualTrigger, BURST_TRIGGER_E *trigger)
+{
+    bool triggerActive[NUM_BURST_TRIGGERS];
+
+    triggerActive[BURST_TRIGGER_OVERCURRENT] = (taskData->packMonitor.overcurrent1Fault || taskData->packMonitor.overcurrent2Fault ||
+                                                taskData->packMonitor.overcurrent3Fault || (peakCurrentA > burstConfig.overcurrentThresA));
+    triggerActive[BURST_TRIGGER_CELL_SAG] = (maxCellSagV > burstConfig.cellSagThresV);
+    triggerActive[BURST_TRIGGER_ALERT] = alertSet;
+    triggerActive[BURST_TRIGGER_MANUAL] = manualTrigger;
+
+    for(uint32_t i = 0; i < NUM_BURST_TRIGGERS; i++)
+    {
+        if(triggerActive[i] && (burstConfig.triggerMask & (1 << i)))
+        {
+            *trigger = (BURST_TRIGGER_E)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+bool configureBurstCapture(const Burst_Capture_Config_S *config)
+{
+    // The whole window has to fit in the ring so no frame is overwritten before it is drained
+    if((config->preTriggerFrames + config->postTriggerFrames + 1) > BURST_CAPTURE_NUM_FRAMES)
+    {
+        return false;
+    }
+
+    // The telemetry task takes the configuration at the start of its next armed cycle
+    vTaskSuspendAll();
+    pendingConfig = *config;
+    configPending = true;
+    xTaskResumeAll();
+
+    return true;
+}
+
+void updateBurstCapture(telemetryTaskData_S *taskData)
+{
+    // Keep up with the alert states even while frozen, so alerts that set during the drain never trigger the next capture
+    // An alert setting triggers even when another clears in the same cycle
+    uint32_t alertMask = 0;
+    for(uint32_t i = 0; (i < NUM_TELEMETRY_ALERTS) && (i < BURST_MAX_ALERTS); i++)
+    {
+        if(getAlertStatus(telemetryAlerts[i]) == ALERT_SET)
+        {
+            alertMask |= (1 << i);
+        }
+    }
+    bool alertSet = ((alertMask & ~lastAlertMask) != 0);
+    lastAlertMask = alertMask;
+
+    if(burstState == BURST_CAPTURE_FROZEN)
+    {
+        // Drop the samples taken during the drain, stale current never triggers the next capture
+        Current_Sample_S currentSamples[BURST_CURRENT_SAMPLES_PER_FRAME];
+        while(getCurrentSamples(currentSamples, BURST_CURRENT_SAMPLES_PER_FRAME, &currentSampleReadIndex) > 0);
+        return;
+    }
+
+    // Requests from other tasks are taken together, a new configuration only ever applies between captures
+    vTaskSuspendAll();
+    bool manualTrigger = manualTriggerPending;
+    manualTriggerPending = false;
+    if(configPending && (burstState == BURST_CAPTURE_ARMED))
+    {
+        burstConfig = pendingConfig;
+        configPending = false;
+    }
+    xTaskResumeAll();
+
+    Burst_Frame_S *frame = &burstFrames[numFramesWritten % BURST_CAPTURE_NUM_FRAMES];
+    Burst_Frame_S *lastFrame = &burstFrames[(numFramesWritten + BURST_CAPTURE_NUM_FRAMES - 1) % BURST_CAPTURE_NUM_FRAMES];
+    bool lastFrameValid = (numFramesWritten > firstValidFrame);
+
+    frame->timeUs = taskData->packMonitor.currentSampleTimeUs;
+
+    // Pack current at the sampler rate, or the cycle reading when the sampler was not running
+    float peakCurrentA = fabsf(taskData->packMonitor.packCurrent);
+    recordCurrentSamples(frame, &peakCurrentA);
+    if(frame->numCurrentSamples == 0)
+    {
+        frame->packCurrent[0] = compressSample(taskData->packMonitor.packCurrent, BURST_CURRENT_LSB_A);
+        frame->numCurrentSamples = 1;
+    }
+
+    frame->packVoltage = compressSample(taskData->packMonitor.packVoltage, BURST_PACK_VOLTAGE_LSB_V);
+
+    frame->temp[BURST_TEMP_MAX_CELL] = compressSample(taskData->maxCellTemp, BURST_TEMP_LSB_C);
+    frame->temp[BURST_TEMP_MIN_CELL] = compressSample(taskData->minCellTemp, BURST_TEMP_LSB_C);
+    frame->temp[BURST_TEMP_SHUNT_ELEMENT] = compressSample(taskData->packMonitor.shuntElementTemp, BURST_TEMP_LSB_C);
+    frame->temp[BURST_TEMP_PACK_MON_BOARD] = compressSample(taskData->packMonitor.boardTemp, BURST_TEMP_LSB_C);
+
+    // Cell voltages, with the largest drop of any cell since the last frame
+    int32_t maxCellSagCounts = 0;
+    for(uint32_t i = 0; i < NUM_CELLS_IN_ACCUMULATOR; i++)
+    {
+        frame->cellVoltage[i] = compressSample(taskData->cells.cellVoltage[i], BURST_CELL_VOLTAGE_LSB_V);
+
+        if(lastFrameValid && ((lastFrame->cellVoltage[i] - frame->cellVoltage[i]) > maxCellSagCounts))
+        {
+            maxCellSagCounts = lastFrame->cellVoltage[i] - frame->cellVoltage[i];
+        }
+    }
+
+    numFramesWritten++;
+
+    BURST_TRIGGER_E trigger;
+    if(burstState == BURST_CAPTURE_ARMED)
+    {
+        if(checkBurstTriggers(taskData, peakCurrentA, maxCellSagCounts * BURST_CELL_VOLTAGE_LSB_V, alertSet, manualTrigger, &trigger))
+        {
+            burstTrigger = trigger;
+            triggerFrame = numFramesWritten - 1;
+            postTriggerFramesRemaining = burstConfig.postTriggerFrames;
+            burstState = BURST_CAPTURE_TRIGGERED;
+        }
+    }
+    else if(postTriggerFramesRemaining > 0)
+    {
+        postTriggerFramesRemaining--;
+    }
+
+    if((burstState == BURST_CAPTURE_TRIGGERED) && (postTriggerFramesRemaining == 0))
+    {
+        // Keep as many of the pre trigger frames as were recorded since the ring was armed
+        uint32_t preTriggerFrames = triggerFrame - firstValidFrame;
+        if(preTriggerFrames > burstConfig.preTriggerFrames)
+        {
+            preTriggerFrames = burstConfig.preTriggerFrames;
+        }
+
+        drainFrame = triggerFrame - preTriggerFrames;
+        drainEndFrame = numFramesWritten;
+
+        // Publish the window only once every frame in it is written
+        __DMB();
+        burstState = BURST_CAPTURE_FROZEN;
+    }
+}
+
+void triggerBurstCapture(void)
+{
+    vTaskSuspendAll();
+    manualTriggerPending = true;
+    xTaskResumeAll();
+}
+
+bool drainBurstCapture(Burst_Frame_S *frame, BURST_TRIGGER_E *trigger, int32_t *frameIndex)
+{
+    if(burstState != BURST_CAPTURE_FROZEN)
+    {
+        return false;
+    }
+
+    *frame = burstFrames[drainFrame % BURST_CAPTURE_NUM_FRAMES];
+    *trigger = burstTrigger;
+    *frameIndex = (int32_t)(drainFrame - triggerFrame);
+    drainFrame++;
+
+    // Hand the ring back empty, the frames before the freeze are no longer contiguous with new ones
+    if(drainFrame >= drainEndFrame)
+    {
+        firstValidFrame = numFramesWritten;
+        __DMB();
+        burstState = BURST_CAPTURE_ARMED;
+    }
+
+    return true;
+}
@@ -0,0 +1,239 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+#include "commPassthrough.h"
+#include "main.h"
+#include "cmsis_os.h"
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+// Per cell monitor ring buffer of pending transactions
+static Comm_Transaction_S *commQueue[NUM_CELL_MON_IN_ACCUMULATOR][COMM_QUEUE_LENGTH];
+static uint32_t commQueueHead[NUM_CELL_MON_IN_ACCUMULATOR];
+static uint32_t commQueueCount[NUM_CELL_MON_IN_ACCUMULATOR];
+
+extern TIM_HandleTypeDef htim5;
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DECLARATIONS ==================== */
+/* ==================================================================== */
+
+static void popCommTransaction(uint32_t cellMonitorIndex, COMM_TRANSACTION_STATE_E finalState);
+static void encodeCommByte(Comm_Transaction_S *transaction, uint32_t byteIndex, ADBMS_CommCellMonitor *comm, uint32_t commIndex);
+static void encodeCommIdle(COMM_BUS_E bus, ADBMS_CommCellMonitor *comm, uint32_t commIndex);
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+static void popCommTransaction(uint32_t cellMonitorIndex, COMM_TRANSACTION_STATE_E finalState)
+{
+    commQueue[cellMonitorIndex][commQueueHead[cellMonitorIndex]]->state = finalState;
+    commQueueHead[cellMonitorIndex] = (commQueueHead[cellMonitorIndex] + 1) % COMM_QUEUE_LENGTH;
+    commQueueCount[cellMonitorIndex]--;
+}
+
+static void encodeCommByte(Comm_Transaction_S *transaction, uint32_t byteIndex, ADBMS_CommCellMonitor *comm, uint32_t commIndex)
+{
+    bool firstByte = (byteIndex == 0);
+    bool lastByte = (byteIndex == (transaction->numBytes - 1));
+    bool repeatedStart = ((transaction->repeatedStartMask >> byteIndex) & 1);
+    bool restartNext = (!lastByte && ((transaction->repeatedStartMask >> (byteIndex + 1)) & 1));
+
+    // The address byte after a repeated START is always written
+    bool writeByte = (byteIndex < transaction->numWriteBytes) || repeatedStart;
+
+    if(transaction->bus == COMM_BUS_I2C)
+    {
+        comm->initialControl[commIndex] = (firstByte || repeatedStart) ? (ICOM_I2C_START) : (ICOM_I2C_BLANK);
+        comm->data[commIndex] = (writeByte) ? (transaction->txData[byteIndex]) : (0xFF);
+
+        // The slave acknowledges written bytes, the master acknowledges read bytes until the last one before a STOP or repeated START
+        if(lastByte)
+        {
+            comm->finalControl[commIndex] = FCOM_I2C_MASTER_NACK_STOP;
+        }
+        else if(writeByte || restartNext)
+        {
+            comm->finalControl[commIndex] = FCOM_I2C_MASTER_NACK;
+        }
+        else
+        {
+            comm->finalControl[commIndex] = FCOM_I2C_MASTER_ACK;
+        }
+    }
+    else
+    {
+        // Chip select is held low across COMM frames until the last byte
+        comm->initialControl[commIndex] = ICOM_SPI_CSB_LOW;
+        comm->data[commIndex] = transaction->txData[byteIndex];
+        comm->finalControl[commIndex] = (lastByte) ? (FCOM_SPI_CSB_HIGH) : (FCOM_SPI_CSB_LOW);
+    }
+}
+
+static void encodeCommIdle(COMM_BUS_E bus, ADBMS_CommCellMonitor *comm, uint32_t commIndex)
+{
+    comm->initialControl[commIndex] = (bus == COMM_BUS_SPI) ? (ICOM_SPI_NO_TRANSMIT) : (ICOM_I2C_NO_TRANSMIT);
+    comm->data[commIndex] = 0xFF;
+    comm->finalControl[commIndex] = (bus == COMM_BUS_SPI) ? (FCOM_SPI_CSB_HIGH) : (FCOM_I2C_MASTER_NACK_STOP);
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+bool queueCommTransaction(uint32_t cellMonitorIndex, Comm_Transaction_S *transaction)
+{
+    if((cellMonitorIndex >= NUM_CELL_MON_IN_ACCUMULATOR) || (transaction == NULL))
+    {
+        return false;
+    }
+
+    if((transaction->numBytes == 0) || (transaction->numBytes > COMM_MAX_TRANSACTION_BYTES) || (transaction->numWriteBytes > transaction->numBytes))
+    {
+        return false;
+    }
+
+    // Repeated STARTs are I2C only and must fall inside the transaction
+    if((transaction->repeatedStartMask != 0) && ((transaction->bus != COMM_BUS_I2C) ||
+       ((transaction->numBytes < COMM_MAX_TRANSACTION_BYTES) && ((transaction->repeatedStartMask >> transaction->numBytes) != 0))))
+    {
+        return false;
+    }
+
+    bool queued = false;
+
+    vTaskSuspendAll();
+    if(commQueueCount[cellMonitorIndex] < COMM_QUEUE_LENGTH)
+    {
+        uint32_t tail = (commQueueHead[cellMonitorIndex] + commQueueCount[cellMonitorIndex]) % COMM_QUEUE_LENGTH;
+        transaction->bytesTransferred = 0;
+        transaction->state = COMM_TRANSACTION_QUEUED;
+        commQueue[cellMonitorIndex][tail] = transaction;
+        commQueueCount[cellMonitorIndex]++;
+        queued = true;
+    }
+    xTaskResumeAll();
+
+    return queued;
+}
+
+TRANSACTION_STATUS_E runCommPassthrough(ADBMS_BatteryData *adbmsData, uint32_t budgetUs)
+{
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+
+    uint32_t startTime = __HAL_TIM_GetCounter(&htim5);
+    uint32_t frameTimeUs = 0;
+
+    while(true)
+    {
+        // Stop before a frame that would overrun the budget, remaining bytes resume next call
+        uint32_t elapsedUs = __HAL_TIM_GetCounter(&htim5) - startTime;
+        if((elapsedUs + frameTimeUs) > budgetUs)
+        {
+            break;
+        }
+
+        uint32_t frameStartTime = __HAL_TIM_GetCounter(&htim5);
+
+        // Pack the next bytes of every device's head transaction into one shared COMM frame
+        bool transferPending = false;
+        vTaskSuspendAll();
+        for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+        {
+            ADBMS_CommCellMonitor *comm = &adbmsData->cellMonitor[i].commGroup;
+            Comm_Transaction_S *transaction = (commQueueCount[i] > 0) ? (commQueue[i][commQueueHead[i]]) : (NULL);
+
+            for(uint32_t j = 0; j < NUM_COMM_BYTES; j++)
+            {
+                if((transaction != NULL) && ((transaction->bytesTransferred + j) < transaction->numBytes))
+                {
+                    encodeCommByte(transaction, (transaction->bytesTransferred + j), comm, j);
+                }
+                else
+                {
+                    encodeCommIdle(((transaction != NULL) ? (transaction->bus) : (COMM_BUS_I2C)), comm, j);
+                }
+            }
+
+            if(transaction != NULL)
+            {
+                transaction->state = COMM_TRANSACTION_ACTIVE;
+                transferPending = true;
+            }
+        }
+        xTaskResumeAll();
+
+        if(!transferPending)
+        {
+            break;
+        }
+
+        status = writeCommRegisters(adbmsData);
+
+        if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            status = startCommTransfer(adbmsData);
+        }
+
+        if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            status = readCommRegisters(adbmsData);
+        }
+
+        vTaskSuspendAll();
+        for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+        {
+            if(commQueueCount[i] == 0)
+            {
+                continue;
+            }
+
+            Comm_Transaction_S *transaction = commQueue[i][commQueueHead[i]];
+
+            if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                // A partially shifted I2C or SPI sequence cannot be resumed safely
+                popCommTransaction(i, COMM_TRANSACTION_FAILED);
+                continue;
+            }
+
+            for(uint32_t j = 0; (j < NUM_COMM_BYTES) && (transaction->bytesTransferred < transaction->numBytes); j++)
+            {
+                transaction->rxData[transaction->bytesTransferred] = adbmsData->cellMonitor[i].commGroup.data[j];
+                transaction->bytesTransferred++;
+            }
+
+            if(transaction->bytesTransferred >= transaction->numBytes)
+            {
+                popCommTransaction(i, COMM_TRANSACTION_COMPLETE);
+            }
+        }
+        xTaskResumeAll();
+
+        if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            break;
+        }
+
+        frameTimeUs = __HAL_TIM_GetCounter(&htim5) - frameStartTime;
+    }
+
+    return status;
+}
+
+void resetCommPassthrough(void)
+{
+    vTaskSuspendAll();
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        while(commQueueCount[i] > 0)
+        {
+            popCommTransaction(i, COMM_TRANSACTION_FAILED);
+        }
+    }
+    xTaskResumeAll();
+}
@@ -93,11 +93,12 @@ void updateMediumFrequencyVariables(GcanTaskInputData_S* gcanData)
         if((alertStatus == ALERT_SET) || (alertStatus == ALERT_LATCHED))
         {
             numAlertsSet++;
-            update_and_queue_param_u8(bmsAlertsParams[i], 0x01);
         }
-        else
+
+        // Alerts without a dedicated CAN parameter are only counted
+        if(i < NUM_GCAN_ALERTS)
         {
-            update_and_queue_param_u8(bmsAlertsParams[i], 0x00);
+            update_and_queue_param_u8(bmsAlertsParams[i], ((alertStatus == ALERT_SET) || (alertStatus == ALERT_LATCHED)) ? (0x01) : (0x00));
         }
     }
 
@@ -24,6 +24,7 @@
 /* USER CODE BEGIN Includes */
 #include <stdbool.h>
 #include "printTask.h"
+#include "telemetry.h"
 #include "gcanUpdateTask.h"
 #include "utils.h"
 
@@ -882,8 +883,7 @@ void startTelemetryTask(void const * argument)
 {
   /* USER CODE BEGIN 5 */
   initTelemetryTask();
-  TickType_t lastTelemetryTaskTick;
-  const TickType_t telemetryTaskPeriod = pdMS_TO_TICKS(TELEMETRY_TASK_PERIOD_MS);
+  TickType_t lastTelemetryTaskTick = xTaskGetTickCount();
 
   /* Infinite loop */
   for(;;)
@@ -892,7 +892,36 @@ void startTelemetryTask(void const * argument)
     runTelemetryTask();
     // printf("%lu\n", (HAL_GetTick()-taskStart));
 
-    vTaskDelayUntil(&lastTelemetryTaskTick, telemetryTaskPeriod);
+    // Wake just after the next predicted accumulation window, fixed period until the predictor is calibrated
+    uint32_t telemetryWakeDelayMs = getTelemetryWakeDelayMs();
+    TickType_t nextTelemetryTaskTick;
+    if(telemetryWakeDelayMs)
+    {
+      nextTelemetryTaskTick = xTaskGetTickCount() + pdMS_TO_TICKS(telemetryWakeDelayMs);
+    }
+    else
+    {
+      nextTelemetryTaskTick = lastTelemetryTaskTick + pdMS_TO_TICKS(getTelemetryPeriodMs());
+    }
+
+    // Sample pack current on its microsecond grid until the next read cycle is due, or until the sampler sees activity at a reduced rate
+    while((int32_t)(nextTelemetryTaskTick - xTaskGetTickCount()) > 0)
+    {
+      if(telemetryWakeRequested())
+      {
+        nextTelemetryTaskTick = xTaskGetTickCount();
+        break;
+      }
+      uint32_t sampleDelayUs = sampleHighRateCurrent();
+      if(sampleDelayUs == 0)
+      {
+        // Sampling is off until the next read cycle releases the registers
+        vTaskDelayUntil(&lastTelemetryTaskTick, nextTelemetryTaskTick - lastTelemetryTaskTick);
+        break;
+      }
+      delayMicroseconds(sampleDelayUs);
+    }
+    lastTelemetryTaskTick = nextTelemetryTaskTick;
   }
   /* USER CODE END 5 */
 }
@@ -5,12 +5,14 @@
 #include "printTask.h"
 #include "main.h"
 #include "telemetryTask.h"
+#include "telemetry.h"
 #include "statusUpdateTask.h"
 #include "chargerTask.h"
 #include "cmsis_os.h"
 #include <stdio.h>
 #include "GopherCAN.h"
 #include "alerts.h"
+#include "burstCapture.h"
 
 /* ==================================================================== */
 /* ============================== STRUCTS ============================= */
@@ -40,10 +42,14 @@ static bool printActiveAlerts(Alert_S** alerts, uint16_t num_alerts);
 static void printEnergyData(Pack_Monitor_S* packMon);
 static void printPackMonDiag(Pack_Monitor_S* packMon);
 
+static void printRateGroupTiming(telemetryTaskData_S* telemetryData);
+
 static void printImdData(imdData_S* imdData);
 
 static void printCharger(chargerTaskData_S* chargerTaskData);
 
+static void printBurstCapture();
+
 /* ==================================================================== */
 /* =================== LOCAL FUNCTION DEFINITIONS ===================== */
 /* ==================================================================== */
@@ -62,28 +68,28 @@ static void printCellVoltages(telemetryTaskData_S* telemetryData)
         printf("|    %02ld    |", i+1);
         for(int32_t j = 0; j < NUM_CELL_MON_IN_ACCUMULATOR; j++)
         {
-            if((telemetryData->bmb[j].cellVoltageStatus[i] == GOOD) && (telemetryData->bmbStatus[j] == GOOD))
+            if((telemetryData->cells.cellVoltageStatus[CELL_INDEX(j, i)] == GOOD) && (telemetryData->bmbStatus[j] == GOOD))
             {
-                if((telemetryData->bmb[j].cellVoltage[i] < 0.0f) || telemetryData->bmb[j].cellVoltage[i] >= 100.0f)
+                if((telemetryData->cells.cellVoltage[CELL_INDEX(j, i)] < 0.0f) || telemetryData->cells.cellVoltage[CELL_INDEX(j, i)] >= 100.0f)
                 {
-                    if(telemetryData->bmb[j].cellBalancingActive[i])
+                    if(telemetryData->cells.cellBalancingActive[CELL_INDEX(j, i)])
                     {
-                        printf("  %5.3f*  |", telemetryData->bmb[j].cellVoltage[i]);
+                        printf("  %5.3f*  |", telemetryData->cells.cellVoltage[CELL_INDEX(j, i)]);
                     }
                     else
                     {
-                        printf("  %5.3f   |", telemetryData->bmb[j].cellVoltage[i]);
+                        printf("  %5.3f   |", telemetryData->cells.cellVoltage[CELL_INDEX(j, i)]);
                     }
                 }
                 else
                 {
-                    if(telemetryData->bmb[j].cellBalancingActive[i])
+                    if(telemetryData->cells.cellBalancingActive[CELL_INDEX(j, i)])
                     {
-                        printf("   %5.3f*  |", telemetryData->bmb[j].cellVoltage[i]);
+                        printf("   %5.3f*  |", telemetryData->cells.cellVoltage[CELL_INDEX(j, i)]);
                     }
                     else
                     {
-                        printf("   %5.3f   |", telemetryData->bmb[j].cellVoltage[i]);
+                        printf("   %5.3f   |", telemetryData->cells.cellVoltage[CELL_INDEX(j, i)]);
                     }
                 }
             }
@@ -111,15 +117,15 @@ static void printCellTemps(telemetryTaskData_S* telemetryData)
         printf("|    %02ld    |", i+1);
         for(int32_t j = 0; j < NUM_CELL_MON_IN_ACCUMULATOR; j++)
         {
-            if((telemetryData->bmb[j].cellTempStatus[i] == GOOD) && (telemetryData->bmbStatus[j] == GOOD))
+            if((telemetryData->cells.cellTempStatus[CELL_INDEX(j, i)] == GOOD) && (telemetryData->bmbStatus[j] == GOOD))
             {
-                if((telemetryData->bmb[j].cellTemp[i] < 0.0f) || telemetryData->bmb[j].cellTemp[i] >= 100.0f)
+                if((telemetryData->cells.cellTemp[CELL_INDEX(j, i)] < 0.0f) || telemetryData->cells.cellTemp[CELL_INDEX(j, i)] >= 100.0f)
                 {
-                    printf("   %3.1f   |", (double)telemetryData->bmb[j].cellTemp[i]);
+                    printf("   %3.1f   |", (double)telemetryData->cells.cellTemp[CELL_INDEX(j, i)]);
                 }
                 else
                 {
-                    printf("    %3.1f   |", (double)telemetryData->bmb[j].cellTemp[i]);
+                    printf("    %3.1f   |", (double)telemetryData->cells.cellTemp[CELL_INDEX(j, i)]);
                 }
             }
             else
@@ -211,6 +217,7 @@ static void printEnergyData(Pack_Monitor_S* packMon)
     // printf("Pack Mon Board Temp: %f\n", packMon->boardTemp);
     // printf("Shunt Temp 1: %f\n", packMon->shuntTemp1);
     // printf("Shunt Temp 2: %f\n", packMon->shuntTemp2);
+    // printf("Shunt Element Temp: %f\n", packMon->shuntElementTemp);
     // printf("Shunt Resistance uOhm: %f\n", packMon->shuntResistanceMicroOhms);
     // printf("Pre Temp 1: %f\n", packMon->prechargeTemp);
     // printf("Dis Temp 2: %f\n", packMon->dischargeTemp);
@@ -236,6 +243,30 @@ static void printPackMonDiag(Pack_Monitor_S* packMon)
 
 }
 
+static void printRateGroupTiming(telemetryTaskData_S* telemetryData)
+{
+    const char* rateGroupNames[NUM_RATE_GROUPS] = { "CELL VOLTAGE", "TEMPERATURE", "STATUS", "DIAGNOSTICS" };
+
+    printf("|   RATE GROUP   | WORST (us) |  AVG (us)  |\n");
+    for(uint32_t i = 0; i < NUM_RATE_GROUPS; i++)
+    {
+        printf("| %-14s | %10lu | %10.1f |\n", rateGroupNames[i], telemetryData->rateGroupTiming[i].worstCaseTimeUs, (double)telemetryData->rateGroupTiming[i].averageTimeUs);
+    }
+    printf("\n");
+
+    printf("| BLOCK | RETRIES | STEPS RETRIED |\n");
+    for(uint32_t i = 0; i < NUM_TELEMETRY_COMMAND_BLOCKS; i++)
+    {
+        printf("|  %02lu   | %7lu | %13lu |\n", i, telemetryData->commandBlockRetry[i].numRetries, telemetryData->commandBlockRetry[i].numStepsRetried);
+    }
+    printf("\n");
+
+    printf("Cycle time: %lu us, worst %lu us\n", telemetryData->cycleBudget.lastCycleTimeUs, telemetryData->cycleBudget.worstCycleTimeUs);
+    printf("Overruns: %lu, deferred blocks: %lu\n\n", telemetryData->cycleBudget.numOverruns, telemetryData->cycleBudget.numDeferredBlocks);
+
+    printf("Telemetry period: %lu ms, data age: %lu us\n\n", telemetryData->telemetryPeriodMs, getTelemetryDataAgeUs(telemetryData));
+}
+
 
 // static void printTestData(Cell_Monitor_S* bmb)
 // {
@@ -356,6 +387,33 @@ static void printCharger(chargerTaskData_S* chargerTaskData)
     }
 }
 
+static void printBurstCapture()
+{
+    // Frozen captures are drained a few frames per print so the UART never holds up the print task
+    Burst_Frame_S frame;
+    BURST_TRIGGER_E trigger;
+    int32_t frameIndex;
+    for(uint32_t i = 0; (i < BURST_DRAIN_FRAMES_PER_CALL) && drainBurstCapture(&frame, &trigger, &frameIndex); i++)
+    {
+        printf("BURST,%d,%ld,%lu,%d", trigger, frameIndex, frame.timeUs, frame.packVoltage);
+        for(uint32_t j = 0; j < NUM_BURST_TEMPS; j++)
+        {
+            printf(",%d", frame.temp[j]);
+        }
+        printf(",I,%lu", frame.currentSampleDecimation);
+        for(uint32_t j = 0; j < frame.numCurrentSamples; j++)
+        {
+            printf(",%d", frame.packCurrent[j]);
+        }
+        printf(",V");
+        for(uint32_t j = 0; j < NUM_CELLS_IN_ACCUMULATOR; j++)
+        {
+            printf(",%d", frame.cellVoltage[j]);
+        }
+        printf("\n");
+    }
+}
+
 /* ==================================================================== */
 /* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
 /* ==================================================================== */
@@ -436,6 +494,8 @@ void runPrintTask()
 
     printEnergyData(&printTaskInputData.telemetryTaskData.packMonitor);
 
+    // printRateGroupTiming(&printTaskInputData.telemetryTaskData);
+
     // printImdData(&printTaskInputData.statusUpdateTaskData.imdData);
     // for(uint32_t i = 0; i < NUM_SDC_SENSE_INPUTS; i++)
     // {
@@ -448,4 +508,5 @@ void runPrintTask()
 
     // printf("SOE: %f\n", soeByOCV_percent.data);
 
+    printBurstCapture();
 }
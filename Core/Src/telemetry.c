@@ -11,7 +11,9 @@
 #include "packData.h"
 #include "telemetryStatistics.h"
 #include "soc.h"
+#include "commPassthrough.h"
 #include <stdlib.h>
+#include <math.h>
 
 /* ==================================================================== */
 /* ============================= DEFINES ============================== */
@@ -40,6 +42,12 @@
 #define SHUNT_REF_TEMP_C                25.0f
 #define SHUNT_RESISTANCE_GAIN_UOHM      0.005f
 
+// Lumped shunt thermal model, the resistive element heats by I^2R above the board sensors
+// through a single thermal resistance and time constant
+#define SHUNT_THERMAL_RESISTANCE_C_PER_W    2.0f
+#define SHUNT_THERMAL_TIME_CONSTANT_S       4.0f
+#define MICROWATTS_PER_WATT                 1000000.0f
+
 // Conversion counter information
 #define PACK_MON_ACCN_SETTING           ACCUMULATE_24_SAMPLES
 #define ACCUMULATION_REGISTER_COUNT     ((PACK_MON_ACCN_SETTING + 1) * 4)
@@ -48,14 +56,149 @@
 
 #define ACCUMULATED_CURRENT_THRES_UV    100
 
-#define MICROVOLTS_PER_VOLT             1000000.0f;
+// Current channel fusion, the channels agree within a fixed floor plus a fraction of the current
+#define CURRENT_CHANNEL_AGREE_THRES_A   0.5f
+#define CURRENT_CHANNEL_AGREE_GAIN      0.02f
+#define CURRENT_DIVERGENCE_FILTER_GAIN  0.1f    // Divergence is low pass filtered so noise alone never excludes a channel
+#define MICROVOLTS_PER_MILLIVOLT        1000.0f
+
+// Cell voltage registers read when not balancing. Averaged cell voltages are read in the same
+// snapshot as the pack monitor accumulators, so cell voltage and pack current share a window end
+#define IDLE_CELL_VOLTAGE_TYPE          AVERAGED_CELL_VOLTAGE
+
+#define MICROVOLTS_PER_VOLT             1000000.0f
 
 #define MAX_13BIT_UINT                  0x1FFF
 
+// Conversion results are double buffered, one being filled while the other is published
+#define NUM_RESULT_BUFFERS              2
+
 #define CONVERSION_BUFFER_SIZE          100
 
+// Conversion period and phase fit over the counter buffer
+#define CONVERSION_FIT_MIN_POINTS       10
+#define CONVERSION_FIT_OUTLIER_GAIN     3.0f    // Points further than this many RMS residuals from the first fit are rejected
+#define CONVERSION_FIT_MIN_OUTLIER_US   50.0f   // Never reject points closer than this, timer jitter alone reaches it
+
+// Wake the telemetry task this long after the predicted end of the next accumulation window
+#define CONVERSION_WAKE_MARGIN_US       500
+#define MAX_WAKE_DELAY_MS               (2U * TELEMETRY_TASK_PERIOD_MS)
+
+// Activity adaptive rate, each level doubles the cycle period up to TELEMETRY_RATE_MAX_LEVEL
+// Activity returns to full rate at once, rest has to hold for a number of cycles before each step down
+// Alerts are only evaluated once per cycle, so a slow cycle adds up to one full period to their debounce
+#define REST_QUALIFY_CYCLES             20
+#define ACTIVITY_CURRENT_THRES_A        20.0f
+#define REST_CURRENT_THRES_A            5.0f
+#define ACTIVITY_PACK_DVDT_THRES_V_S    2.0f
+#define REST_PACK_DVDT_THRES_V_S        0.5f
+#define ACTIVITY_CELL_VOLTAGE_MARGIN_V  0.05f   // Cells this close to a warning limit count as activity
+#define REST_CELL_VOLTAGE_MARGIN_V      0.1f
+#define ACTIVITY_CELL_TEMP_MARGIN_C     5.0f
+#define REST_CELL_TEMP_MARGIN_C         8.0f
+#define ACCUMULATION_WINDOW_PHASE_COUNTS    (ACCUMULATION_REGISTER_COUNT * PHASE_COUNTS_PER_CONVERSION)
+
 #define DISCHARGE_PWM                   100.0f
 
+// Discharge is muted this long before the snapshot so the cells settle, reads are overlapped with the wait
+#define BALANCING_MUTE_SETTLE_US        2000
+
+// Balancing offload, the device discharge timers keep balancing between slow re-plans
+#define BALANCING_OFFLOAD_ENABLED       1
+#define BALANCING_REPLAN_PERIOD_MS      60000
+// Config B is only written with a balancing plan, its thresholds are read back in between
+#define CONFIG_B_VERIFY_PERIOD_MS       1000
+#define BALANCING_RESISTANCE_OHM        30.0f
+#define MILLIAMPS_IN_AMP                1000.0f
+
+// Redundant ADC comparison is done on chip, full S-ADC voltages are only read periodically or on a mismatch
+#define REDUNDANT_ADC_COMPARE_THRESHOLD COMPARE_THRESHOLD_10_mV
+
+// Read back S-ADC voltages are compared against the last C-ADC voltages, which may be filtered and a conversion older
+#define REDUNDANT_ADC_FAULT_THRES_V     0.05f
+#define REDUNDANT_ADC_FAULT_COUNT       3
+
+// Hardware OV/UV comparators trip at the cell fault limits
+#define HW_OVERVOLTAGE_THRES_V          MAX_BRICK_FAULT_VOLTAGE
+#define HW_UNDERVOLTAGE_THRES_V         MIN_BRICK_FAULT_VOLTAGE
+
+// Pack monitor hardware overcurrent comparators trip at the discharge current limit
+// The OC ADCs are signed but each comparator trips on the magnitude of its result against an unsigned 7 bit
+// threshold, so there is no per direction setting. A separate charge threshold would also trip on discharge
+// above 15 A, and the charge limit is under one 2.5 mV LSB on the 100 uOhm shunt, so charge stays software only
+#define HW_OVERCURRENT_THRES_MV         ((ABS_MAX_DISCHARGE_CURRENT_A * SHUNT_REF_RESISTANCE_UOHM) / 1000.0f)
+#define HW_OVERCURRENT_GAIN_SETTING     OVERCURRENT_GAIN_2_5_mV
+#define HW_OVERCURRENT_ADC_LSB_MV       2.5f    // One overcurrent ADC count at HW_OVERCURRENT_GAIN_SETTING
+#define HW_OVERCURRENT_DEGLITCH         DEGLITCH_2_OUT_OF_3
+
+// Cell monitor conversion counters hold the same 13 bit phase count format as the pack monitor
+#define CELL_MON_PHASE_COUNTS_PER_CONVERSION    4
+#define PHASE_TIME_FILTER_GAIN          0.1f
+
+// Current is only held at the nearest sample when the requested time is within this gap of it
+#define CURRENT_INTERPOLATION_MAX_GAP_US    5000
+
+// Full rate thermistor mode converts the other mux half while the registers are released,
+// so both halves are refreshed on every temperature cycle
+#define TEMPERATURE_FULL_RATE_MODE      1
+#define TEMP_MUX_SETTLE_US              500
+#define AUX_CONVERSION_TIME_US          2000
+
+// Precharge monitoring, link and pack voltage are sampled with the high rate current
+// Detection runs at a slow rate until the link starts rising, then at the pack V ADC rate
+#define PRECHARGE_ARM_RATIO             0.5f    // Link below this fraction of the pack arms precharge detection
+#define PRECHARGE_COMPLETE_RATIO        0.95f
+#define PRECHARGE_START_RISE_V          5.0f    // Link rise above the armed baseline that marks the start of precharge
+#define PRECHARGE_MIN_PACK_VOLTAGE_V    50.0f
+#define PRECHARGE_TIMEOUT_US            5000000
+#define PRECHARGE_IDLE_PERIOD_US        20000
+#define PRECHARGE_FIT_MIN_POINTS        5
+#define PRECHARGE_FIT_MIN_HEADROOM      0.01f   // Link within this fraction of the pack is too close for the log fit
+#define PACK_VOLTAGE_CONVERSION_TIME_US 1000    // A V ADC restart before a conversion of all channels completes aborts it
+#define LINK_CONVERSION_ATTEMPTS        2
+#define MICROSECONDS_IN_SECOND          (MICROSECONDS_IN_MILLISECOND * MILLISECONDS_IN_SECOND)
+
+// Time per cycle given to queued I2C/SPI pass-through transfers
+#define COMM_PASSTHROUGH_BUDGET_US      2000
+
+// Rate group periods and phase offsets in telemetry cycles
+// Temperature runs on odd cycles and status on even cycles so the slow groups never share a cycle
+// Diagnostics run one budgeted slice every cycle
+#define CELL_VOLTAGE_PERIOD_CYCLES      1
+#define CELL_VOLTAGE_PHASE_CYCLES       0
+#define TEMPERATURE_PERIOD_CYCLES       4
+#define TEMPERATURE_PHASE_CYCLES        1
+#define STATUS_PERIOD_CYCLES            10
+#define STATUS_PHASE_CYCLES             0
+#define DIAGNOSTICS_PERIOD_CYCLES       1
+#define DIAGNOSTICS_PHASE_CYCLES        0
+
+// Optional command blocks are deferred when they would push the cycle past this budget
+// The rest of the period is left for high rate current sampling and the other tasks
+#define CYCLE_BUDGET_US                 20000
+#define CYCLE_PERIOD_US                 (TELEMETRY_TASK_PERIOD_MS * MICROSECONDS_IN_MILLISECOND)
+#define BLOCK_COST_DECAY_SHIFT          3
+#define MAX_CONSECUTIVE_DEFERRALS       5
+
+// Open wire tests
+#define CELL_OPEN_WIRE_SOAK_TIME_MS     40
+#define AUX_OPEN_WIRE_SOAK_TIME_MS      10
+#define CELL_OPEN_WIRE_THRES_V          0.4f    // S-ADC reading under pull down this far from the C-ADC reading is an open wire
+#define AUX_OPEN_WIRE_THRES_V           1.0f    // Pull up and pull down readings this far apart are an open thermistor input
+
+// Low power cell monitoring park mode
+#define LPCM_PARK_CURRENT_THRES_A       1.0f
+#define LPCM_PARK_ENTRY_TIME_MS         60000
+#define LPCM_FLAG_POLL_PERIOD_MS        1000
+#define LPCM_MONITORING_PERIOD          LPCM_PERIOD_1_S
+#define LPCM_CELL_MONITOR_MASK          0xFFFF
+#define LPCM_CELL_DELTA_THRES_V         0.1f
+// Only the thermistors on the active mux half are monitored while parked
+#define LPCM_GPIO_MONITOR_MASK          0x00FF
+#define LPCM_GPIO_UNDERVOLTAGE_V        0.3f    // Thermistor divider voltage below this is an overtemp
+#define LPCM_GPIO_OVERVOLTAGE_V         2.9f    // Thermistor divider voltage above this is an open sensor
+#define LPCM_GPIO_DELTA_THRES_V         0.5f
+
 /* ==================================================================== */
 /* ========================= ENUMERATED TYPES========================== */
 /* ==================================================================== */
@@ -67,49 +210,356 @@ typedef enum
     NUM_CONVERSION_BUFFER_INDEXES
 } CONVERSION_BUFFER_INDEX_E;
 
+// Command block steps, a read without a command counter error verifies every step before it
+typedef enum
+{
+    PREPARE_CHAIN_CHECK_STEP = 0,
+    PREPARE_MUTE_STEP,
+    PREPARE_VERIFY_STEP
+} PREPARE_READ_CYCLE_STEP_E;
+
+typedef enum
+{
+    READ_CYCLE_SNAPSHOT_STEP = 0,
+    READ_CYCLE_VERIFY_STEP
+} READ_CYCLE_STEP_E;
+
+typedef enum
+{
+    RELEASE_UNFREEZE_STEP = 0,
+    RELEASE_VERIFY_STEP
+} RELEASE_READ_CYCLE_STEP_E;
+
+typedef enum
+{
+    DEVICE_STATUS_A_STEP = 0,
+    DEVICE_STATUS_B_STEP,
+    DEVICE_STATUS_D_STEP,
+    DEVICE_STATUS_E_STEP
+} DEVICE_STATUS_STEP_E;
+
+typedef enum
+{
+    AUX_READ_STEP = 0,
+    AUX_START_CELL_MONITOR_STEP,
+    AUX_START_PACK_MONITOR_STEP,
+    AUX_MUX_WRITE_STEP,
+    AUX_VERIFY_STEP
+} AUX_TELEMETRY_STEP_E;
+
+typedef enum
+{
+    ALT_TEMP_MUX_WRITE_STEP = 0,
+    ALT_TEMP_START_STEP,
+    ALT_TEMP_READ_STEP,
+    ALT_TEMP_RESTART_STEP,
+    ALT_TEMP_VERIFY_STEP
+} ALTERNATE_TEMPERATURE_STEP_E;
+
+// Diagnostic tests are split into slices, one slice runs per cycle
+typedef enum
+{
+    REDUNDANT_CELL_READ_SLICE = 0,
+    REDUNDANT_AUX_READ_SLICE
+} REDUNDANT_ADC_SLICE_E;
+
+typedef enum
+{
+    OPEN_WIRE_START_SLICE = 0,
+    OPEN_WIRE_SOAK_SLICE,
+    OPEN_WIRE_READ_SLICE,
+    OPEN_WIRE_RESTORE_SLICE
+} OPEN_WIRE_SLICE_E;
+
+typedef enum
+{
+    ADC_MISMATCH_READ_STEP = 0,
+    ADC_MISMATCH_CLEAR_STEP
+} ADC_MISMATCH_STEP_E;
+
+typedef enum
+{
+    HW_FAULT_OVUV_READ_STEP = 0,
+    HW_FAULT_OVUV_CLEAR_STEP,
+    HW_FAULT_OVERCURRENT_READ_STEP,
+    HW_FAULT_OVERCURRENT_CLEAR_STEP
+} HARDWARE_FAULT_STEP_E;
+
+/* ==================================================================== */
+/* ============================== STRUCTS ============================= */
+/* ==================================================================== */
+
+typedef struct
+{
+    uint32_t periodCycles;
+    uint32_t phaseCycles;
+} Rate_Group_S;
+
+// Conversion phase of one device at the last snapshot, used to timestamp its data
+typedef struct
+{
+    bool valid;
+    uint32_t phaseCount;
+    uint32_t timeUs;
+    float phaseTimeUs;
+} Conversion_Phase_S;
+
+// Running sums of the precharge fit, log of the link headroom against time since precharge start
+typedef struct
+{
+    uint32_t numPoints;
+    float sumT;
+    float sumY;
+    float sumTT;
+    float sumTY;
+} Precharge_Fit_S;
+
+typedef struct
+{
+    TRANSACTION_STATUS_E (*commandBlock)(telemetryTaskData_S*);
+    RATE_GROUP_E rateGroup;
+
+    // Optional blocks may be deferred by the cycle budget governor, required blocks always run
+    bool optional;
+} Command_Block_S;
+
+// Cycle budget governor state of one command block
+typedef struct
+{
+    // Worst case cost with a slow decay, and whether the block is owed a run from an earlier cycle
+    uint32_t costEstimateUs;
+    bool deferred;
+    uint32_t consecutiveDeferrals;
+} Command_Block_State_S;
 
 /* ==================================================================== */
 /* ========================= LOCAL VARIABLES ========================== */
 /* ==================================================================== */
 
-static ADBMS_BatteryData batteryData;
+// Reads decode into the back buffers batteryData points at, a complete read is flipped to the front
+// Statistics, SOC and alerts are translated from the front only, so a failed read never reaches them
+static ADBMS_VoltageData voltageDataBuffer[NUM_RESULT_BUFFERS];
+static ADBMS_AuxData auxDataBuffer[NUM_RESULT_BUFFERS];
+static ADBMS_VoltageData *frontVoltageData = &voltageDataBuffer[1];
+static ADBMS_AuxData *frontAuxData = &auxDataBuffer[1];
+
+// Bumped on every voltage flip so readers in other tasks can tell a flip landed mid copy
+static volatile uint32_t voltageDataSequence = 0;
+
+// Chain state, configs and status mirrors carry over from one read to the next and are never flipped
+static ADBMS_BatteryData batteryData = { .voltageData = &voltageDataBuffer[0], .auxData = &auxDataBuffer[0] };
 
 static uint32_t conversionCounterBuffer[NUM_CONVERSION_BUFFER_INDEXES][CONVERSION_BUFFER_SIZE];
 static uint32_t counterBufferIndex = 0;
 
+// Read cycle snapshot time and the predicted wake time of the next cycle, both in htim5 microseconds
+static uint32_t snapshotTimeUs = 0;
+
+// Time discharge was muted ahead of the snapshot
+static uint32_t muteTimeUs = 0;
+static bool dischargeMuted = false;
+static uint32_t nextWakeTimeUs = 0;
+static bool wakePredictionValid = false;
+
+// Adaptive rate state, the sampler may raise the rate between cycles
+static uint32_t telemetryRateLevel = 0;
+static uint32_t restCycles = 0;
+static float lastRatePackVoltage = 0.0f;
+static uint32_t lastRateTimeUs = 0;
+static bool rateVoltageValid = false;
+static bool activityWakeRequested = false;
+
+static uint32_t lastParkActivityTick = 0;
+static uint32_t lastParkPollTick = 0;
+
+static const Rate_Group_S rateGroups[NUM_RATE_GROUPS] =
+{
+    [RATE_GROUP_CELL_VOLTAGE] = { CELL_VOLTAGE_PERIOD_CYCLES, CELL_VOLTAGE_PHASE_CYCLES },
+    [RATE_GROUP_TEMPERATURE]  = { TEMPERATURE_PERIOD_CYCLES,  TEMPERATURE_PHASE_CYCLES },
+    [RATE_GROUP_STATUS]       = { STATUS_PERIOD_CYCLES,       STATUS_PHASE_CYCLES },
+    [RATE_GROUP_DIAGNOSTICS]  = { DIAGNOSTICS_PERIOD_CYCLES,  DIAGNOSTICS_PHASE_CYCLES }
+};
+static uint32_t rateGroupCycle = 0;
+static bool rateGroupScheduled[NUM_RATE_GROUPS];
+
+// First step of the running command block not yet verified by a read, kept across retries
+static uint32_t commandBlockCheckpoint = 0;
+static uint32_t commandBlockStepsRun = 0;
+
+// Mux state each cell monitor is switched to after its aux read, so a retried write never toggles twice
+static uint8_t nextMuxState[NUM_CELL_MON_IN_ACCUMULATOR];
+
+// Start of the running cycle, the governor budgets optional blocks against it
+static uint32_t cycleStartTimeUs = 0;
+
+// Diagnostic scheduler state
+static ADC_DIAG_STATE_E diagnosticState = REDUNDANT_ADC_DIAG_STATE;
+static uint32_t diagnosticSlice = 0;
+static uint32_t openWireSoakStartTick = 0;
+static bool cellOpenWireActive = false;
+static bool auxOpenWireActive = false;
+
+// Set once the redundant cell voltages have been read back and compared in the current cycle
+static bool redundantCellsRead = false;
+
+// Partial open wire results, assembled once the complementary test completes
+static bool cellOpenWireEven[NUM_CELLS_IN_ACCUMULATOR];
+static bool cellOpenWireOdd[NUM_CELLS_IN_ACCUMULATOR];
+static float auxPullDownVoltage[NUM_CELL_MON_IN_ACCUMULATOR][NUM_CELL_TEMP_ADCS];
+static uint8_t auxPullDownMuxState[NUM_CELL_MON_IN_ACCUMULATOR];
+
+// High rate current samples, only written by the telemetry task and read lock free by other tasks
+static Current_Sample_S currentSampleBuffer[CURRENT_SAMPLE_BUFFER_SIZE];
+_Static_assert(CURRENT_SAMPLE_BUFFER_SIZE >= MAX_CURRENT_SAMPLES_PER_CYCLE, "Current sample buffer must hold a full cycle at the slowest rate");
+static volatile uint32_t currentSampleWriteIndex = 0;
+static uint32_t nextCurrentSampleTimeUs = 0;
+static bool currentSamplingEnabled = false;
+static float currentSampleShuntResistance = SHUNT_REF_RESISTANCE_UOHM;
+static float peakSampleCurrent = 0.0f;
+
+// Current channels excluded by the fusion stage, shared with the high rate sampler
+static bool currentChannelExcluded[NUM_CURRENT_CHANNELS];
+
+// Shunt thermal model state
+static float shuntElementTempRise = 0.0f;
+static uint32_t lastShuntModelTimeUs = 0;
+static bool shuntModelStarted = false;
+
+// Conversion phase calibration of every device and the start of the aux conversions being read next
+static Conversion_Phase_S packMonitorPhase;
+static Conversion_Phase_S cellMonitorPhase[NUM_CELL_MON_IN_ACCUMULATOR];
+static uint32_t auxConversionStartTimeUs = 0;
+
+// Full rate thermistor sequencing times
+static uint32_t muxSwitchTimeUs = 0;
+static uint32_t alternateConversionStartTimeUs = 0;
+
+// Precharge monitoring state, the complete event is published to other tasks through the count
+static PRECHARGE_STATE_E prechargeState = PRECHARGE_IDLE;
+static Precharge_Fit_S prechargeFit;
+static float prechargeBaselineVoltage = 0.0f;
+static uint32_t prechargeStartTimeUs = 0;
+static float prechargeTimeConstantS = 0.0f;
+static float prechargeTimeRemainingS = 0.0f;
+static uint32_t nextPrechargeSampleTimeUs = 0;
+static uint32_t packVoltageStartTimeUs = 0;
+static volatile uint32_t prechargeCompleteCount = 0;
+static volatile uint32_t prechargeCompleteTimeUs = 0;
+
 extern TIM_HandleTypeDef htim5;
 
 /* ==================================================================== */
 /* =================== LOCAL FUNCTION DECLARATIONS ==================== */
 /* ==================================================================== */
 
-static TRANSACTION_STATUS_E runCommandBlock(TRANSACTION_STATUS_E (*telemetryFunction)(telemetryTaskData_S*), telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E runCommandBlock(TRANSACTION_STATUS_E (*telemetryFunction)(telemetryTaskData_S*), telemetryTaskData_S *taskData, Command_Block_Retry_S *retry);
+static bool stepPending(uint32_t step);
+static void setCheckpoint(uint32_t step, TRANSACTION_STATUS_E status);
+static void waitSettleTime(uint32_t startTimeUs, uint32_t settleTimeUs);
 
 static TRANSACTION_STATUS_E initChain(telemetryTaskData_S *taskData);
 
+static TRANSACTION_STATUS_E prepareReadCycle(telemetryTaskData_S *taskData);
 static TRANSACTION_STATUS_E startNewReadCycle(telemetryTaskData_S *taskData);
 static TRANSACTION_STATUS_E updateDeviceStatus(telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E updateConversionStatus(telemetryTaskData_S *taskData);
 static TRANSACTION_STATUS_E updateAuxPackTelemetry(telemetryTaskData_S *taskData);
+static void translateAuxVoltages(telemetryTaskData_S *taskData);
+static void updateCellTemps(telemetryTaskData_S *taskData, bool alternateHalf, uint32_t sampleTimeUs);
+static void publishVoltageData(void);
+static void publishAuxData(void);
+static TRANSACTION_STATUS_E updateAlternateTemperatures(telemetryTaskData_S *taskData);
 static TRANSACTION_STATUS_E updatePrimaryPackTelemetry(telemetryTaskData_S *taskData);
+static void updateAdcFaults(telemetryTaskData_S *taskData);
+static void updateCurrentFusion(telemetryTaskData_S *taskData, float channel1Uv, float channel2Uv);
+static float fuseCurrentChannels(float channel1Uv, float channel2Uv);
+static void updateShuntThermalModel(telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E samplePrechargeVoltages(uint32_t sampleTimeUs);
+static TRANSACTION_STATUS_E restartLinkVoltageConversions(void);
+static void updatePrechargeState(float packVoltage, float linkVoltage, uint32_t timeUs);
+static void updatePrechargeFit(float packVoltage, float linkVoltage, uint32_t timeUs);
+static float getPhaseCountTimeUs(telemetryTaskData_S *taskData);
+static void fitConversionPhase(telemetryTaskData_S *taskData, uint32_t newestIndex, uint32_t *fittedTimeUs);
+static void updateConversionPhase(Conversion_Phase_S *phase, uint32_t phaseCount);
+static uint32_t getConversionEndTimeUs(Conversion_Phase_S *phase, uint32_t timeUs, uint32_t boundaryPhaseCounts);
+static void predictNextConversion(telemetryTaskData_S *taskData);
+static void updateTelemetryRate(telemetryTaskData_S *taskData);
+static bool adcMismatchPresent(telemetryTaskData_S *taskData);
 static TRANSACTION_STATUS_E runDeviceDiagnostics(telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E verifyAdcMismatch(telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E runRedundantAdcSlice(telemetryTaskData_S *taskData, bool *testComplete);
+static TRANSACTION_STATUS_E runCellOpenWireSlice(telemetryTaskData_S *taskData, ADC_MODE_CELL_OPEN_WIRE_E openWireMode, bool *testComplete);
+static TRANSACTION_STATUS_E runAuxOpenWireSlice(telemetryTaskData_S *taskData, ADC_MODE_AUX_OPEN_WIRE_E openWireMode, bool *testComplete);
+static TRANSACTION_STATUS_E updatePackStatistics(telemetryTaskData_S *taskData);
+static uint32_t calculateDischargeMinutes(float cellVoltage, float targetVoltage);
 static TRANSACTION_STATUS_E updateBalancingSwitches(telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E pollHardwareFaults(telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E updateCommPassthrough(telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E releaseReadCycle(telemetryTaskData_S *taskData);
+
+static bool parkModeQualified(telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E enterParkMode(telemetryTaskData_S *taskData);
+static TRANSACTION_STATUS_E runParkMode(telemetryTaskData_S *taskData);
+
+static void updateRateGroupTiming(Rate_Group_Timing_S *timing, uint32_t elapsedTimeUs);
+static bool blockScheduled(uint32_t blockIndex, bool *rateGroupScheduled);
+static bool deferOptionalBlock(uint32_t blockIndex, bool *rateGroupScheduled);
+static void updateBlockCost(Command_Block_State_S *blockState, uint32_t elapsedTimeUs);
+
+// Command blocks in execution order, each only runs in the cycles its rate group is scheduled
+// Diagnostics must read the frozen snapshot so they run before the release, the other optional blocks run last
+// Balancing is required since it is the block that turns discharge off on overtemperature or when disabled
+static const Command_Block_S commandBlocks[] =
+{
+    // Command block                Rate group                  Optional
+    { prepareReadCycle,             RATE_GROUP_CELL_VOLTAGE,    false },
+    { pollHardwareFaults,           RATE_GROUP_CELL_VOLTAGE,    false },
+    { updateDeviceStatus,           RATE_GROUP_STATUS,          false },
+    { startNewReadCycle,            RATE_GROUP_CELL_VOLTAGE,    false },
+    { updateConversionStatus,       RATE_GROUP_CELL_VOLTAGE,    false },
+    { updateAuxPackTelemetry,       RATE_GROUP_TEMPERATURE,     false },
+    { updatePrimaryPackTelemetry,   RATE_GROUP_CELL_VOLTAGE,    false },
+    { pollHardwareFaults,           RATE_GROUP_CELL_VOLTAGE,    false },
+    { runDeviceDiagnostics,         RATE_GROUP_DIAGNOSTICS,     true },
+    { verifyAdcMismatch,            RATE_GROUP_CELL_VOLTAGE,    false },
+    { releaseReadCycle,             RATE_GROUP_CELL_VOLTAGE,    false },
+    { updateAlternateTemperatures,  RATE_GROUP_TEMPERATURE,     false },
+    { updatePackStatistics,         RATE_GROUP_CELL_VOLTAGE,    false },
+    { updateBalancingSwitches,      RATE_GROUP_CELL_VOLTAGE,    false },
+    { updateCommPassthrough,        RATE_GROUP_CELL_VOLTAGE,    true }
+};
+#define NUM_COMMAND_BLOCKS (sizeof(commandBlocks) / sizeof(commandBlocks[0]))
+_Static_assert(NUM_COMMAND_BLOCKS == NUM_TELEMETRY_COMMAND_BLOCKS, "Command block table does not match NUM_TELEMETRY_COMMAND_BLOCKS");
+
+static Command_Block_State_S commandBlockState[NUM_COMMAND_BLOCKS];
 
 /* ==================================================================== */
 /* =================== LOCAL FUNCTION DEFINITIONS ===================== */
 /* ==================================================================== */
 
 
-static TRANSACTION_STATUS_E runCommandBlock(TRANSACTION_STATUS_E (*telemetryFunction)(telemetryTaskData_S*), telemetryTaskData_S *taskData)
+static TRANSACTION_STATUS_E runCommandBlock(TRANSACTION_STATUS_E (*telemetryFunction)(telemetryTaskData_S*), telemetryTaskData_S *taskData, Command_Block_Retry_S *retry)
 {
+    // Every command block starts at its first step, retries resume at the checkpoint
+    commandBlockCheckpoint = 0;
+
     for(uint32_t attempt = 0; attempt < NUM_COMMAND_BLOCK_RETRYS; attempt++)
     {
         // Run the telemetry function
+        commandBlockStepsRun = 0;
         TRANSACTION_STATUS_E status = telemetryFunction(taskData);
 
+        // Track the retry cost, blocks without checkpoints count as a single step
+        if((attempt > 0) && (retry != NULL))
+        {
+            retry->numRetries++;
+            retry->numStepsRetried += (commandBlockStepsRun) ? (commandBlockStepsRun) : 1;
+        }
+
         // Check return status
         if(status == TRANSACTION_COMMAND_COUNTER_ERROR)
         {
-            // On command counter error, retry the command block
+            // On command counter error, retry the command block from the last verified step
             Debug("Command counter mismatch! Retrying command block!\n");
             continue;
         }
@@ -124,6 +574,46 @@ static TRANSACTION_STATUS_E runCommandBlock(TRANSACTION_STATUS_E (*telemetryFunc
     return TRANSACTION_COMMAND_COUNTER_ERROR;
 }
 
+static bool stepPending(uint32_t step)
+{
+    // Steps before the checkpoint were verified on an earlier attempt
+    if(step < commandBlockCheckpoint)
+    {
+        return false;
+    }
+
+    commandBlockStepsRun++;
+    return true;
+}
+
+static void setCheckpoint(uint32_t step, TRANSACTION_STATUS_E status)
+{
+    // A read without a command counter error confirms every command up to and including this step
+    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        commandBlockCheckpoint = step + 1;
+    }
+}
+
+static void waitSettleTime(uint32_t startTimeUs, uint32_t settleTimeUs)
+{
+    // Block on a microsecond one shot for the remainder so lower priority tasks run during the wait
+    // The registers are still released, so pack current keeps being sampled on its own grid
+    uint32_t elapsedTimeUs = __HAL_TIM_GetCounter(&htim5) - startTimeUs;
+    while(elapsedTimeUs < settleTimeUs)
+    {
+        uint32_t delayUs = settleTimeUs - elapsedTimeUs;
+        uint32_t sampleDelayUs = sampleHighRateCurrent();
+        if((sampleDelayUs != 0) && (sampleDelayUs < delayUs))
+        {
+            delayUs = sampleDelayUs;
+        }
+
+        delayMicroseconds(delayUs);
+        elapsedTimeUs = __HAL_TIM_GetCounter(&htim5) - startTimeUs;
+    }
+}
+
 static TRANSACTION_STATUS_E initChain(telemetryTaskData_S *taskData)
 {
     wakeChain(&batteryData);
@@ -140,6 +630,36 @@ static TRANSACTION_STATUS_E initChain(telemetryTaskData_S *taskData)
     batteryData.chainInfo.localCommandCounter[CELL_MONITOR] = 0;
     batteryData.chainInfo.localCommandCounter[PACK_MONITOR] = 0;
 
+    // Force a full decode of all status groups after init
+    invalidateStatusMirror(&batteryData);
+
+    // Any reset takes the cell monitors out of low power cell monitoring
+    taskData->lpcmParked = false;
+
+    // Pass-through sequences cannot survive a chain reset
+    resetCommPassthrough();
+
+    // Restart the rate group schedule so status is refreshed on the first cycle
+    rateGroupCycle = 0;
+
+    // Fall back to the fixed task period until the conversion time is recalibrated
+    wakePredictionValid = false;
+
+    // A chain reset clears any discharge mute
+    dischargeMuted = false;
+
+    // Conversions are restarted without open wire currents, so restart the diagnostic rotation
+    diagnosticState = REDUNDANT_ADC_DIAG_STATE;
+    diagnosticSlice = 0;
+    cellOpenWireActive = false;
+    auxOpenWireActive = false;
+
+    // Current sampling resumes once the first read cycle releases the registers
+    currentSamplingEnabled = false;
+
+    // Device conversion clocks restart, so the phase calibration starts over
+    memset(&packMonitorPhase, 0, sizeof(packMonitorPhase));
+    memset(cellMonitorPhase, 0, sizeof(cellMonitorPhase));
 
     status = checkChainStatus(&batteryData);
     if(status == TRANSACTION_SPI_ERROR)
@@ -164,6 +684,7 @@ static TRANSACTION_STATUS_E initChain(telemetryTaskData_S *taskData)
     for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
     {
         batteryData.cellMonitor[i].configGroupA.referenceOn = 1;
+        batteryData.cellMonitor[i].configGroupA.comparisonThreshold = REDUNDANT_ADC_COMPARE_THRESHOLD;
         batteryData.cellMonitor[i].configGroupA.digitalFilterSetting = FILTER_CUTOFF_10_HZ;
 
         batteryData.cellMonitor[i].configGroupA.gpo1State = 1;
@@ -186,12 +707,37 @@ static TRANSACTION_STATUS_E initChain(telemetryTaskData_S *taskData)
     batteryData.packMonitor.configGroupA.gpo1HighZMode = 0;
     batteryData.packMonitor.configGroupA.gpo1State = 1;
 
+    batteryData.packMonitor.configGroupA.overcurrentAdcsEnabled = 1;
+
     status = writeConfigA(&batteryData);
     if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
     {
         return status;
     }
 
+    // Set hardware OV/UV thresholds in config B, rewritten with every balancing plan and read back in between
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        batteryData.cellMonitor[i].configGroupB.overvoltageThreshold = HW_OVERVOLTAGE_THRES_V;
+        batteryData.cellMonitor[i].configGroupB.undervoltageThreshold = HW_UNDERVOLTAGE_THRES_V;
+    }
+
+    // Set hardware overcurrent thresholds in pack monitor config B
+    // All three comparators guard the same limit, and being magnitude comparators they cover both current directions
+    batteryData.packMonitor.configGroupB.oc1GainControl = HW_OVERCURRENT_GAIN_SETTING;
+    batteryData.packMonitor.configGroupB.oc2GainControl = HW_OVERCURRENT_GAIN_SETTING;
+    batteryData.packMonitor.configGroupB.oc3GainControl = HW_OVERCURRENT_GAIN_SETTING;
+    batteryData.packMonitor.configGroupB.oc1Threshold = encodeOvercurrentThreshold(HW_OVERCURRENT_THRES_MV, HW_OVERCURRENT_GAIN_SETTING);
+    batteryData.packMonitor.configGroupB.oc2Threshold = encodeOvercurrentThreshold(HW_OVERCURRENT_THRES_MV, HW_OVERCURRENT_GAIN_SETTING);
+    batteryData.packMonitor.configGroupB.oc3Threshold = encodeOvercurrentThreshold(HW_OVERCURRENT_THRES_MV, HW_OVERCURRENT_GAIN_SETTING);
+    batteryData.packMonitor.configGroupB.ocDeglitchMode = HW_OVERCURRENT_DEGLITCH;
+
+    status = writeConfigB(&batteryData);
+    if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        return status;
+    }
+
     // for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
     // {
     //     for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
@@ -224,7 +770,7 @@ static TRANSACTION_STATUS_E initChain(telemetryTaskData_S *taskData)
         return status;
     }
 
-    status = startCellConversions(&batteryData, NON_REDUNDANT_MODE, CONTINOUS_MODE, DISCHARGE_DISABLED, FILTER_RESET, CELL_OPEN_WIRE_DISABLED);
+    status = startCellConversions(&batteryData, REDUNDANT_MODE, CONTINOUS_MODE, DISCHARGE_DISABLED, FILTER_RESET, CELL_OPEN_WIRE_DISABLED);
     if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
     {
         return status;
@@ -239,6 +785,7 @@ static TRANSACTION_STATUS_E initChain(telemetryTaskData_S *taskData)
     }
 
     status = startPackVoltageConversions(&batteryData, PACK_ALL_CHANNELS, PACK_OPEN_WIRE_DISABLED);
+    packVoltageStartTimeUs = __HAL_TIM_GetCounter(&htim5);
     if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
     {
         return status;
@@ -247,56 +794,107 @@ static TRANSACTION_STATUS_E initChain(telemetryTaskData_S *taskData)
     return readSerialId(&batteryData);
 }
 
-static TRANSACTION_STATUS_E startNewReadCycle(telemetryTaskData_S *taskData)
+static TRANSACTION_STATUS_E prepareReadCycle(telemetryTaskData_S *taskData)
 {
     readyChain(&batteryData);
 
-    TRANSACTION_STATUS_E status;
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
 
     // If the chain is broken in anyway, attempt to correct the chain at the start of a new cycle
     // If a correction occurs, and a POR or command counter error is detected as a result, that will be returned by status
-    status = checkChainStatus(&batteryData);
-
-    // If charging is enabled, mute balancing, wait 2ms to ensure a new conversion finishes, then toggle freeze
-    if(taskData->balancingEnabled)
+    if(stepPending(PREPARE_CHAIN_CHECK_STEP))
     {
-        if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
-        {
-            status = muteDischarge(&batteryData);
-            vTaskDelay(2);
-        }
-    } 
+        status = checkChainStatus(&batteryData);
+        setCheckpoint(PREPARE_CHAIN_CHECK_STEP, status);
+    }
 
-    // Unfreeze read registers
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    if(!taskData->balancingEnabled)
     {
-        status = unfreezeRegisters(&batteryData);
+        return status;
     }
 
-    // Freeze read registers for new read cycle
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    // If balancing is enabled, mute discharge now so the cells settle while the blocks before the snapshot run
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(PREPARE_MUTE_STEP))
     {
-        status = freezeRegisters(&batteryData);
+        status = muteDischarge(&batteryData);
+        muteTimeUs = __HAL_TIM_GetCounter(&htim5);
+        dischargeMuted = true;
     }
 
-    // Update local conversion phase counter timer
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    // Verify command counter after the mute command
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(PREPARE_VERIFY_STEP))
     {
-        conversionCounterBuffer[TIMER_INDEX][counterBufferIndex] = __HAL_TIM_GetCounter(&htim5);
+        status = readSerialId(&batteryData);
+        setCheckpoint(PREPARE_VERIFY_STEP, status);
     }
 
-    if(taskData->balancingEnabled)
+    return status;
+}
+
+static TRANSACTION_STATUS_E startNewReadCycle(telemetryTaskData_S *taskData)
+{
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+
+    // The snapshot is only confirmed by the serial id read, so a failed verify retakes the whole snapshot
+    if(stepPending(READ_CYCLE_SNAPSHOT_STEP))
     {
+        if(taskData->balancingEnabled)
+        {
+            // A retaken snapshot has already unmuted, so mute again and settle for the full window
+            if(!dischargeMuted)
+            {
+                status = muteDischarge(&batteryData);
+                muteTimeUs = __HAL_TIM_GetCounter(&htim5);
+                dischargeMuted = true;
+            }
+
+            // Only wait out whatever is left of the settle window after the overlapped reads
+            waitSettleTime(muteTimeUs, BALANCING_MUTE_SETTLE_US);
+        }
+
+        // Current samples would be stale once the registers are frozen
+        currentSamplingEnabled = false;
+
+        // Unfreeze read registers
+        if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            status = unfreezeRegisters(&batteryData);
+        }
+
+        // Freeze read registers for new read cycle
+        if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            status = freezeRegisters(&batteryData);
+        }
+
+        // Update local conversion phase counter timer
         if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
         {
-            status = unmuteDischarge(&batteryData);
+            snapshotTimeUs = __HAL_TIM_GetCounter(&htim5);
+            conversionCounterBuffer[TIMER_INDEX][counterBufferIndex] = snapshotTimeUs;
+
+            // Record the settle time achieved before the snapshot
+            if(taskData->balancingEnabled)
+            {
+                taskData->balancingSettleTimeUs = snapshotTimeUs - muteTimeUs;
+            }
+        }
+
+        if(taskData->balancingEnabled)
+        {
+            if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                status = unmuteDischarge(&batteryData);
+                dischargeMuted = false;
+            }
         }
     }
 
     // Verify command counter after freeze commands
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(READ_CYCLE_VERIFY_STEP))
     {
         status = readSerialId(&batteryData);
+        setCheckpoint(READ_CYCLE_VERIFY_STEP, status);
     }
 
     return status;
@@ -304,122 +902,155 @@ static TRANSACTION_STATUS_E startNewReadCycle(telemetryTaskData_S *taskData)
 
 static TRANSACTION_STATUS_E updateDeviceStatus(telemetryTaskData_S *taskData)
 {
-    TRANSACTION_STATUS_E status;
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
 
-    // Record the last phase count stored in the static battery data struct. 0 on init
-    uint32_t lastPhaseCount = batteryData.packMonitor.statusGroupC.conversionCounter1;
-
-    // Update all status registers
-    status = readStatusA(&batteryData);
-
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
-    {
-        status = readStatusB(&batteryData);
-    }
-
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    // Update the slow status registers, status C is read every cycle by updateConversionStatus
+    if(stepPending(DEVICE_STATUS_A_STEP))
     {
-        status = readStatusC(&batteryData);
+        status = readStatusA(&batteryData);
+        setCheckpoint(DEVICE_STATUS_A_STEP, status);
     }
 
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(DEVICE_STATUS_B_STEP))
     {
-        // Check for reset pack monitor
-        if(batteryData.packMonitor.statusGroupC.resetDetected)
-        {
-            // Reset conversion counter buffer
-            memset(conversionCounterBuffer[COUNTER_INDEX], 0, (CONVERSION_BUFFER_SIZE * sizeof(uint32_t)));
-            // counterBufferIndex = 0;
-
-            return TRANSACTION_POR_ERROR;
-        }
-
-        for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
-        {
-            // Check for sleepy BMBs
-            if(batteryData.cellMonitor[i].statusGroupC.sleepDetected)
-            {
-                return TRANSACTION_POR_ERROR;
-            }
-        }
+        status = readStatusB(&batteryData);
+        setCheckpoint(DEVICE_STATUS_B_STEP, status);
     }
 
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(DEVICE_STATUS_D_STEP))
     {
         status = readStatusD(&batteryData);
+        setCheckpoint(DEVICE_STATUS_D_STEP, status);
     }
 
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(DEVICE_STATUS_E_STEP))
     {
         status = readStatusE(&batteryData);
+        setCheckpoint(DEVICE_STATUS_E_STEP, status);
     }
 
     for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
     {
-        // Check for sleepy BMBs
-        if(batteryData.cellMonitor[i].statusGroupC.sleepDetected)
+        // Cell monitor status sensors, only copied when the device register bytes changed
+
+        if(batteryData.statusGroupChanged[STATUS_GROUP_A] & (1UL << i))
         {
-            return TRANSACTION_POR_ERROR;
+            // Update reference voltage
+            taskData->bmb[i].referenceVoltage = batteryData.cellMonitor[i].statusGroupA.referenceVoltage;
+            taskData->bmb[i].referenceVoltageStatus = GOOD;
+
+            // Update die temp
+            taskData->bmb[i].dieTemp = batteryData.cellMonitor[i].statusGroupA.dieTemp;
+            taskData->bmb[i].dieTempStatus = GOOD;
+        }
+
+        if(batteryData.statusGroupChanged[STATUS_GROUP_B] & (1UL << i))
+        {
+            // Update digital supply voltage
+            taskData->bmb[i].digitalSupplyVoltage = batteryData.cellMonitor[i].statusGroupB.digitalSupplyVoltage;
+            taskData->bmb[i].digitalSupplyVoltageStatus = GOOD;
+
+            // Update analog supply voltage
+            taskData->bmb[i].analogSupplyVoltage = batteryData.cellMonitor[i].statusGroupB.analogSupplyVoltage;
+            taskData->bmb[i].analogSupplyVoltageStatus = GOOD;
+
+            // Update reference resistor voltage
+            taskData->bmb[i].referenceResistorVoltage = batteryData.cellMonitor[i].statusGroupB.referenceResistorVoltage;
+            taskData->bmb[i].referenceResistorVoltageStatus = GOOD;
         }
+    }
 
-        // Cell monitor status sensors
+    // Pack monitor status sensors
 
-        // Update reference voltage
-        taskData->bmb[i].referenceVoltage = batteryData.cellMonitor[i].statusGroupA.referenceVoltage;
-        taskData->bmb[i].referenceVoltageStatus = GOOD;
+    if(batteryData.statusGroupChanged[STATUS_GROUP_A] & STATUS_CHANGED_PACK_MONITOR)
+    {
+        // Reference voltage
+        taskData->packMonitor.referenceVoltage1P25 = batteryData.packMonitor.statusGroupA.referenceVoltage1P25;
+        taskData->packMonitor.referenceVoltage1P25Status = GOOD;
 
-        // Update die temp
-        taskData->bmb[i].dieTemp = batteryData.cellMonitor[i].statusGroupA.dieTemp;
-        taskData->bmb[i].dieTempStatus = GOOD;
+        // Die Temp 1
+        taskData->packMonitor.dieTemp1 = batteryData.packMonitor.statusGroupA.dieTemp1;
+        taskData->packMonitor.dieTemp1Status = GOOD;
 
-        // Update digital supply voltage
-        taskData->bmb[i].digitalSupplyVoltage = batteryData.cellMonitor[i].statusGroupB.digitalSupplyVoltage;
-        taskData->bmb[i].digitalSupplyVoltageStatus = GOOD;
+        // Regulator voltage
+        taskData->packMonitor.regulatorVoltage = batteryData.packMonitor.statusGroupA.regulatorVoltage;
+        taskData->packMonitor.regulatorVoltageStatus = GOOD;
+    }
 
-        // Update analog supply voltage
-        taskData->bmb[i].analogSupplyVoltage = batteryData.cellMonitor[i].statusGroupB.analogSupplyVoltage;
-        taskData->bmb[i].analogSupplyVoltageStatus = GOOD;
+    if(batteryData.statusGroupChanged[STATUS_GROUP_B] & STATUS_CHANGED_PACK_MONITOR)
+    {
+        // Supply voltage
+        taskData->packMonitor.supplyVoltage = batteryData.packMonitor.statusGroupB.supplyVoltage;
+        taskData->packMonitor.supplyVoltageStatus = GOOD;
 
-        // Update reference resistor voltage
-        taskData->bmb[i].referenceResistorVoltage = batteryData.cellMonitor[i].statusGroupB.referenceResistorVoltage;
-        taskData->bmb[i].referenceResistorVoltageStatus = GOOD;
+        // Digital supply voltage
+        taskData->packMonitor.digitalSupplyVoltage = batteryData.packMonitor.statusGroupB.digitalSupplyVoltage;
+        taskData->packMonitor.digitalSupplyVoltageStatus = GOOD;
 
+        // Ground pad voltage
+        taskData->packMonitor.groundPadVoltage = batteryData.packMonitor.statusGroupB.groundPadVoltage;
+        taskData->packMonitor.groundPadVoltageStatus = GOOD;
     }
 
-    // Pack monitor status sensors
+    if(batteryData.statusGroupChanged[STATUS_GROUP_D] & STATUS_CHANGED_PACK_MONITOR)
+    {
+        // Resistor reference
+        taskData->packMonitor.referenceResistorVoltage = batteryData.packMonitor.statusGroupD.referenceResistorVoltage;
+        taskData->packMonitor.referenceResistorVoltageStatus = GOOD;
+
+        // Die temp 2
+        taskData->packMonitor.dieTemp2 = batteryData.packMonitor.statusGroupD.dieTemp2;
+        taskData->packMonitor.dieTemp2Status = GOOD;
+    }
 
-    // Reference voltage
-    taskData->packMonitor.referenceVoltage1P25 = batteryData.packMonitor.statusGroupA.referenceVoltage1P25;
-    taskData->packMonitor.referenceVoltage1P25Status = GOOD;
+    return status;
+}
 
-    // Die Temp 1
-    taskData->packMonitor.dieTemp1 = batteryData.packMonitor.statusGroupA.dieTemp1;
-    taskData->packMonitor.dieTemp1Status = GOOD;
+static TRANSACTION_STATUS_E updateConversionStatus(telemetryTaskData_S *taskData)
+{
+    TRANSACTION_STATUS_E status;
 
-    // Regulator voltage
-    taskData->packMonitor.regulatorVoltage = batteryData.packMonitor.statusGroupA.regulatorVoltage;
-    taskData->packMonitor.regulatorVoltageStatus = GOOD;
+    // Record the last phase count stored in the static battery data struct. 0 on init
+    uint32_t lastPhaseCount = batteryData.packMonitor.statusGroupC.conversionCounter1;
 
-    // Supply voltage
-    taskData->packMonitor.supplyVoltage = batteryData.packMonitor.statusGroupB.supplyVoltage;
-    taskData->packMonitor.supplyVoltageStatus = GOOD;
+    // Status C carries the conversion counter and reset flags, so it is read every cycle
+    status = readStatusC(&batteryData);
+    if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        return status;
+    }
 
-    // Digital supply voltage
-    taskData->packMonitor.digitalSupplyVoltage = batteryData.packMonitor.statusGroupB.digitalSupplyVoltage;
-    taskData->packMonitor.digitalSupplyVoltageStatus = GOOD;
+    // Check for reset pack monitor
+    if(batteryData.packMonitor.statusGroupC.resetDetected)
+    {
+        // Reset conversion counter buffer
+        memset(conversionCounterBuffer[COUNTER_INDEX], 0, (CONVERSION_BUFFER_SIZE * sizeof(uint32_t)));
+        // counterBufferIndex = 0;
 
-    // Ground pad voltage
-    taskData->packMonitor.groundPadVoltage = batteryData.packMonitor.statusGroupB.groundPadVoltage;
-    taskData->packMonitor.groundPadVoltageStatus = GOOD;
+        return TRANSACTION_POR_ERROR;
+    }
 
-    // Resistor reference
-    taskData->packMonitor.referenceResistorVoltage = batteryData.packMonitor.statusGroupD.referenceResistorVoltage;
-    taskData->packMonitor.referenceResistorVoltageStatus = GOOD;
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        // Check for sleepy BMBs
+        if(batteryData.cellMonitor[i].statusGroupC.sleepDetected)
+        {
+            return TRANSACTION_POR_ERROR;
+        }
 
-    // Die temp 2
-    taskData->packMonitor.dieTemp2 = batteryData.packMonitor.statusGroupD.dieTemp2;
-    taskData->packMonitor.dieTemp2Status = GOOD;
+        // Each cell monitor runs its own conversion clock, so each is calibrated against the snapshot separately
+        updateConversionPhase(&cellMonitorPhase[i], batteryData.cellMonitor[i].statusGroupC.conversionCounter & MAX_13BIT_UINT);
 
+        // The S-ADC is taken over by the cell open wire test, so the comparison results are not valid
+        if((batteryData.statusGroupChanged[STATUS_GROUP_C] & (1UL << i)) && !cellOpenWireActive)
+        {
+            // Update on chip redundant ADC comparison results
+            for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+            {
+                taskData->cells.cellAdcMismatch[CELL_INDEX(i, j)] = batteryData.cellMonitor[i].statusGroupC.cellAdcMismatchFault[j];
+            }
+        }
+    }
 
     //TODO fix this mess
 
@@ -433,38 +1064,25 @@ static TRANSACTION_STATUS_E updateDeviceStatus(telemetryTaskData_S *taskData)
 
         conversionCounterBuffer[COUNTER_INDEX][counterBufferIndex] = taskData->packMonitor.adcConversionPhaseCounter;
 
-        uint32_t currentCounter = conversionCounterBuffer[COUNTER_INDEX][counterBufferIndex];
-        uint32_t currentTimer = conversionCounterBuffer[TIMER_INDEX][counterBufferIndex];
+        // Fit the conversion period and phase over the whole buffer, a single jittery timestamp no longer skews it
+        uint32_t fittedSnapshotTimeUs = snapshotTimeUs;
+        fitConversionPhase(taskData, counterBufferIndex, &fittedSnapshotTimeUs);
 
         // Counter buffer index
         counterBufferIndex++;
         counterBufferIndex %= CONVERSION_BUFFER_SIZE;
 
-        uint32_t pastCounter = conversionCounterBuffer[COUNTER_INDEX][counterBufferIndex];
-        uint32_t pastTimer = conversionCounterBuffer[TIMER_INDEX][counterBufferIndex];
-
-        uint32_t deltaCounter = (currentCounter - pastCounter);
-
-        // If there is a 0 stored in the next buffer index, the buffer is not full, and the conversion time calibration is not preformed
-        if((pastCounter) && (deltaCounter))
-        {
-            uint32_t deltaTimerUS = (currentTimer - pastTimer);
-            float deltaTimerPhaseCounts = ((float)deltaTimerUS / MICROSECONDS_IN_MILLISECOND) * PHASE_COUNTS_PER_CONVERSION;
-
-            taskData->packMonitor.adcConversionTimeMS = (deltaTimerPhaseCounts) / (deltaCounter);
-
-        }
-        else
-        {
-            // Do nothing?? Let it be 0 or unchanged?
-            // taskData->packMonitor.adcConversionTimeMS = 1.0f;
-        }
-
+        // The pack monitor phase uses the long baseline calibration above
+        packMonitorPhase.valid = true;
+        packMonitorPhase.phaseCount = taskData->packMonitor.adcConversionPhaseCounter;
+        packMonitorPhase.timeUs = fittedSnapshotTimeUs;
+        packMonitorPhase.phaseTimeUs = getPhaseCountTimeUs(taskData);
     }
     else
     {
         // Reset conversion counter buffer
         memset(conversionCounterBuffer[COUNTER_INDEX], 0, (CONVERSION_BUFFER_SIZE * sizeof(uint32_t)));
+        memset(&packMonitorPhase, 0, sizeof(packMonitorPhase));
     }
 
     return status;
@@ -472,102 +1090,224 @@ static TRANSACTION_STATUS_E updateDeviceStatus(telemetryTaskData_S *taskData)
 
 static TRANSACTION_STATUS_E updateAuxPackTelemetry(telemetryTaskData_S *taskData)
 {
-    TRANSACTION_STATUS_E status;
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+
+    // The aux open wire test owns the aux ADC and mux until it restores normal conversions
+    if(auxOpenWireActive)
+    {
+        return status;
+    }
 
     // Cell monitor data: all cell temps, S1N voltage, HV supply voltage
     // Pack monitor data: all aux voltages, reference and redundance reference voltage
-    status = readAuxVoltages(&batteryData);
-
-    // Filter and assign all cell temps and board temps
-    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    if(stepPending(AUX_READ_STEP))
     {
-        // Cell indexes are offset depending on the mux state, which is set by gpio10
-        uint32_t cellOffset = batteryData.cellMonitor[i].configGroupA.gpo10State;
+        status = readAuxVoltages(&batteryData);
 
-        // Cell temps
-        for(uint32_t j = 0; j < NUM_CELL_TEMP_ADCS; j++)
+        // Latch the mux state to switch to while the config still matches the data just read
+        for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
         {
-            float cellTemp = lookup(batteryData.cellMonitor[i].auxVoltage[j], &cellMonTempTable);
-            taskData->bmb[i].cellTemp[(j * 2) + cellOffset] = cellTemp;
-
-            if(fequals(cellTemp, MIN_TEMP_SENSOR_VALUE_C) || fequals(cellTemp, MAX_TEMP_SENSOR_VALUE_C))
-            {
-                taskData->bmb[i].cellTempStatus[(j * 2) + cellOffset] = BAD;
-            }
-            else
-            {
-                taskData->bmb[i].cellTempStatus[(j * 2) + cellOffset] = GOOD;
-            }
+            nextMuxState[i] = !batteryData.cellMonitor[i].configGroupA.gpo10State;
         }
 
-        // Board temp
-        taskData->bmb[i].boardTemp = lookup(batteryData.cellMonitor[i].auxVoltage[BOARD_TEMP_ADC_INDEX], &cellMonTempTable);
-        taskData->bmb[i].boardTempStatus = GOOD;
-    }
-
-    // Translate pack monitor aux voltages
+        setCheckpoint(AUX_READ_STEP, status);
 
-    // Regulator temp
-    taskData->packMonitor.boardTemp = lookup(batteryData.packMonitor.auxVoltage[REG_TEMP_AUX_INDEX], &packMonTempTable);
-    taskData->packMonitor.boardTempStatus = GOOD;
+        // Only a complete read is flipped to the front, a failed one leaves the last good readings translated
+        if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            publishAuxData();
 
-    // Shunt temp 1
-    taskData->packMonitor.shuntTemp1 = lookup(batteryData.packMonitor.auxVoltage[SHUNT_TEMP1_AUX_INDEX], &packMonTempTable);
-    taskData->packMonitor.shuntTemp1Status = GOOD;
+            // The readings come from the conversions started on the last temperature cycle
+            taskData->auxSampleTimeUs = auxConversionStartTimeUs;
+            translateAuxVoltages(taskData);
+        }
+    }
+
+    // In full rate mode the cell monitor conversions and mux are sequenced once the registers are released
+    // Restart cell monitor AUX adcs
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && !TEMPERATURE_FULL_RATE_MODE && stepPending(AUX_START_CELL_MONITOR_STEP))
+    {
+        status = startAuxConversions(&batteryData, AUX_ALL_CHANNELS, AUX_OPEN_WIRE_DISABLED);
+        auxConversionStartTimeUs = __HAL_TIM_GetCounter(&htim5);
+    }
+
+    // Restart pack monitor AUX adcs
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(AUX_START_PACK_MONITOR_STEP))
+    {
+        status = startPackVoltageConversions(&batteryData, PACK_ALL_CHANNELS, PACK_OPEN_WIRE_DISABLED);
+        packVoltageStartTimeUs = __HAL_TIM_GetCounter(&htim5);
+    }
+
+    // Toggle temperature sensor mux
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && !TEMPERATURE_FULL_RATE_MODE && stepPending(AUX_MUX_WRITE_STEP))
+    {
+        for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+        {
+            batteryData.cellMonitor[i].configGroupA.gpo10State = nextMuxState[i];
+        }
+        status = writeConfigA(&batteryData);
+    }
+
+    // Verify command counter and mux states
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(AUX_VERIFY_STEP))
+    {
+        status = readConfigA(&batteryData);
+        setCheckpoint(AUX_VERIFY_STEP, status);
+    }
+
+    return status;
+
+}
+
+static void translateAuxVoltages(telemetryTaskData_S *taskData)
+{
+    // Filter and assign all cell temps and board temps
+    updateCellTemps(taskData, false, taskData->auxSampleTimeUs);
+
+    // Translate pack monitor aux voltages
+
+    // Regulator temp
+    taskData->packMonitor.boardTemp = lookup(frontAuxData->packMonitor.auxVoltage[REG_TEMP_AUX_INDEX], &packMonTempTable);
+    taskData->packMonitor.boardTempStatus = GOOD;
+
+    // Shunt temp 1
+    taskData->packMonitor.shuntTemp1 = lookup(frontAuxData->packMonitor.auxVoltage[SHUNT_TEMP1_AUX_INDEX], &packMonTempTable);
+    taskData->packMonitor.shuntTemp1Status = GOOD;
 
     // Shunt temp 2
-    taskData->packMonitor.shuntTemp2 = lookup(batteryData.packMonitor.auxVoltage[SHUNT_TEMP2_AUX_INDEX], &packMonTempTable);
+    taskData->packMonitor.shuntTemp2 = lookup(frontAuxData->packMonitor.auxVoltage[SHUNT_TEMP2_AUX_INDEX], &packMonTempTable);
     taskData->packMonitor.shuntTemp2Status = GOOD;
 
     // Precharge Temp
-    taskData->packMonitor.prechargeTemp = lookup(batteryData.packMonitor.auxVoltage[PRECHARGE_TEMP_AUX_INDEX], &packMonTempTable);
+    taskData->packMonitor.prechargeTemp = lookup(frontAuxData->packMonitor.auxVoltage[PRECHARGE_TEMP_AUX_INDEX], &packMonTempTable);
     taskData->packMonitor.prechargeTempStatus = GOOD;
 
     // Discharge Temp
-    taskData->packMonitor.dischargeTemp = lookup(batteryData.packMonitor.auxVoltage[DISCHARGE_TEMP_AUX_INDEX], &packMonTempTable);
+    taskData->packMonitor.dischargeTemp = lookup(frontAuxData->packMonitor.auxVoltage[DISCHARGE_TEMP_AUX_INDEX], &packMonTempTable);
     taskData->packMonitor.dischargeTempStatus = GOOD;
 
     // Link voltage
     // Link+ and Link- measured referenced to 1.25v ref, subtract to get link voltage
-    float linkVoltage = LINK_DIVIDER_INV_GAIN * (batteryData.packMonitor.auxVoltage[LINK_PLUS_AUX_INDEX] - batteryData.packMonitor.auxVoltage[LINK_MINUS_AUX_INDEX]);
+    float linkVoltage = LINK_DIVIDER_INV_GAIN * (frontAuxData->packMonitor.auxVoltage[LINK_PLUS_AUX_INDEX] - frontAuxData->packMonitor.auxVoltage[LINK_MINUS_AUX_INDEX]);
     taskData->packMonitor.linkVoltage = linkVoltage;
     taskData->packMonitor.linkVoltageStatus = GOOD;
 
     // TODO add error checking on shunt temp
-    // Calculate the shunt resistance
-    float shuntRes = SHUNT_REF_RESISTANCE_UOHM + SHUNT_RESISTANCE_GAIN_UOHM * (taskData->packMonitor.shuntTemp1 - SHUNT_REF_TEMP_C);
-    taskData->packMonitor.shuntResistanceMicroOhms = shuntRes;
+    // Shunt resistance is compensated every cycle from the shunt thermal model
+}
 
-    // Restart cell monitor AUX adcs
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+static void updateCellTemps(telemetryTaskData_S *taskData, bool alternateHalf, uint32_t sampleTimeUs)
+{
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
     {
-        status = startAuxConversions(&batteryData, AUX_ALL_CHANNELS, AUX_OPEN_WIRE_DISABLED);
+        // Cell indexes are offset depending on the mux state, which is set by gpio10
+        // The snapshot holds the half the mux was on at the read, the alternate half is the one it switches to
+        uint32_t cellOffset = (alternateHalf) ? (nextMuxState[i]) : (!nextMuxState[i]);
+
+        // Cell temps
+        for(uint32_t j = 0; j < NUM_CELL_TEMP_ADCS; j++)
+        {
+            float cellTemp = lookup(frontAuxData->cellMonitor[i].auxVoltage[j], &cellMonTempTable);
+            taskData->cells.cellTemp[CELL_INDEX(i, (j * 2) + cellOffset)] = cellTemp;
+            taskData->cells.cellTempSampleTimeUs[CELL_INDEX(i, (j * 2) + cellOffset)] = sampleTimeUs;
+
+            if(fequals(cellTemp, MIN_TEMP_SENSOR_VALUE_C) || fequals(cellTemp, MAX_TEMP_SENSOR_VALUE_C) || taskData->cells.cellTempOpenWire[CELL_INDEX(i, (j * 2) + cellOffset)])
+            {
+                taskData->cells.cellTempStatus[CELL_INDEX(i, (j * 2) + cellOffset)] = BAD;
+            }
+            else
+            {
+                taskData->cells.cellTempStatus[CELL_INDEX(i, (j * 2) + cellOffset)] = GOOD;
+            }
+        }
+
+        // Board temp
+        taskData->bmb[i].boardTemp = lookup(frontAuxData->cellMonitor[i].auxVoltage[BOARD_TEMP_ADC_INDEX], &cellMonTempTable);
+        taskData->bmb[i].boardTempStatus = GOOD;
     }
+}
 
-    // Restart pack monitor AUX adcs
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+static void publishVoltageData(void)
+{
+    // Flip the completed back buffer to the front, the old front is refilled by the next read
+    ADBMS_VoltageData *completedData = batteryData.voltageData;
+    batteryData.voltageData = frontVoltageData;
+
+    // The completed buffer must be fully written before other tasks can see it
+    __DMB();
+    frontVoltageData = completedData;
+    voltageDataSequence++;
+}
+
+static void publishAuxData(void)
+{
+    // Aux data is only consumed by the telemetry task, so no barrier is needed
+    ADBMS_AuxData *completedData = batteryData.auxData;
+    batteryData.auxData = frontAuxData;
+    frontAuxData = completedData;
+}
+
+static TRANSACTION_STATUS_E updateAlternateTemperatures(telemetryTaskData_S *taskData)
+{
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+
+    // The aux open wire test owns the aux ADC and mux until it restores normal conversions
+    if(!TEMPERATURE_FULL_RATE_MODE || auxOpenWireActive)
     {
-        status = startPackVoltageConversions(&batteryData, PACK_ALL_CHANNELS, PACK_OPEN_WIRE_DISABLED);
+        return status;
     }
 
-    // Toggle temperature sensor mux
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    // Switch every mux to the half that was not in the snapshot
+    if(stepPending(ALT_TEMP_MUX_WRITE_STEP))
     {
         for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
         {
-            batteryData.cellMonitor[i].configGroupA.gpo10State ^= 1;
+            batteryData.cellMonitor[i].configGroupA.gpo10State = nextMuxState[i];
         }
         status = writeConfigA(&batteryData);
+        muxSwitchTimeUs = __HAL_TIM_GetCounter(&htim5);
+    }
+
+    // Convert the alternate half once the thermistor inputs have settled
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(ALT_TEMP_START_STEP))
+    {
+        waitSettleTime(muxSwitchTimeUs, TEMP_MUX_SETTLE_US);
+
+        status = startAuxConversions(&batteryData, AUX_ALL_CHANNELS, AUX_OPEN_WIRE_DISABLED);
+        alternateConversionStartTimeUs = __HAL_TIM_GetCounter(&htim5);
+        taskData->tempMuxSettleTimeUs = alternateConversionStartTimeUs - muxSwitchTimeUs;
+    }
+
+    // The registers are released, so the read returns the conversion just started
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(ALT_TEMP_READ_STEP))
+    {
+        waitSettleTime(alternateConversionStartTimeUs, AUX_CONVERSION_TIME_US);
+
+        status = readAuxVoltages(&batteryData);
+        setCheckpoint(ALT_TEMP_READ_STEP, status);
+
+        if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            publishAuxData();
+            updateCellTemps(taskData, true, alternateConversionStartTimeUs);
+        }
+    }
+
+    // Convert this half again so the next snapshot holds fresh data, the mux stays put so no settle is needed
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(ALT_TEMP_RESTART_STEP))
+    {
+        status = startAuxConversions(&batteryData, AUX_ALL_CHANNELS, AUX_OPEN_WIRE_DISABLED);
+        auxConversionStartTimeUs = __HAL_TIM_GetCounter(&htim5);
     }
 
     // Verify command counter and mux states
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(ALT_TEMP_VERIFY_STEP))
     {
         status = readConfigA(&batteryData);
+        setCheckpoint(ALT_TEMP_VERIFY_STEP, status);
     }
 
     return status;
-
 }
 
 static TRANSACTION_STATUS_E updatePrimaryPackTelemetry(telemetryTaskData_S *taskData)
@@ -582,38 +1322,101 @@ static TRANSACTION_STATUS_E updatePrimaryPackTelemetry(telemetryTaskData_S *task
     }
     else
     {
-        status = readCellVoltages(&batteryData, FILTERED_CELL_VOLTAGE);
+        status = readCellVoltages(&batteryData, IDLE_CELL_VOLTAGE_TYPE);
+    }
+
+    // A failed read is never flipped to the front, the task data keeps what was translated from the last good read
+    if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        return status;
     }
 
+    publishVoltageData();
+
     // Filter and assign all voltages to task data struct
     for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
     {
         for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
         {
             // Add filtering here
-            taskData->bmb[i].cellVoltage[j] = batteryData.cellMonitor[i].cellVoltage[j];
-            taskData->bmb[i].cellVoltageStatus[j] = GOOD;
+            // A cell with an open sense wire reads a meaningless voltage, so it is not trusted or balanced
+            taskData->cells.cellVoltage[CELL_INDEX(i, j)] = frontVoltageData->cellMonitor[i].cellVoltage[j];
+            taskData->cells.cellVoltageStatus[CELL_INDEX(i, j)] = (taskData->cells.cellAdcFault[CELL_INDEX(i, j)] || taskData->cells.cellOpenWire[CELL_INDEX(i, j)]) ? (BAD) : (GOOD);
 
-            // if(fequals(taskData->bmb[i].cellVoltage[j], CELL_MON_AUX_ADC_OFFSET))
+            // if(fequals(taskData->cells.cellVoltage[CELL_INDEX(i, j)], CELL_MON_AUX_ADC_OFFSET))
             // {
-            //     taskData->bmb[i].cellVoltageStatus[j] = BAD;
+            //     taskData->cells.cellVoltageStatus[CELL_INDEX(i, j)] = BAD;
             // }
             // else
             // {
-            //     taskData->bmb[i].cellVoltageStatus[j] = GOOD;
+            //     taskData->cells.cellVoltageStatus[CELL_INDEX(i, j)] = GOOD;
             // }
         }
     }
 
     // Translate pack monitor sensors
 
-    // Pack current
-    taskData->packMonitor.packCurrent = batteryData.packMonitor.currentAdc1uV / (taskData->packMonitor.shuntResistanceMicroOhms);
-    taskData->packMonitor.packCurrentStatus = GOOD;
+    // Predict the shunt element temperature at this snapshot before converting current
+    updateShuntThermalModel(taskData);
+
+    if(!taskData->balancingEnabled && (IDLE_CELL_VOLTAGE_TYPE == AVERAGED_CELL_VOLTAGE))
+    {
+        // Use the accumulation window averages to match the averaged cell voltages
+        float averageCurrent1Uv = (float)frontVoltageData->packMonitor.currentAdcAccumulator1uV / ACCUMULATION_REGISTER_COUNT;
+        float averageCurrent2Uv = (float)frontVoltageData->packMonitor.currentAdcAccumulator2uV / ACCUMULATION_REGISTER_COUNT;
+        updateCurrentFusion(taskData, averageCurrent1Uv, averageCurrent2Uv);
+        float averageCurrentUv = fuseCurrentChannels(averageCurrent1Uv, averageCurrent2Uv);
+        float averageBatteryVoltage = (float)frontVoltageData->packMonitor.batteryVoltageAccumulator1uV / ACCUMULATION_REGISTER_COUNT / MICROVOLTS_PER_VOLT;
+
+        // Pack current
+        taskData->packMonitor.packCurrent = averageCurrentUv / (taskData->packMonitor.shuntResistanceMicroOhms);
+        taskData->packMonitor.packCurrentStatus = GOOD;
+
+        // Pack voltage
+        taskData->packMonitor.packVoltage = averageBatteryVoltage * VBAT_DIVIDER_INV_GAIN;
+        taskData->packMonitor.packVoltageStatus = GOOD;
+    }
+    else
+    {
+        // Pack current
+        updateCurrentFusion(taskData, frontVoltageData->packMonitor.currentAdc1uV, frontVoltageData->packMonitor.currentAdc2uV);
+        float currentUv = fuseCurrentChannels(frontVoltageData->packMonitor.currentAdc1uV, frontVoltageData->packMonitor.currentAdc2uV);
+        taskData->packMonitor.packCurrent = currentUv / (taskData->packMonitor.shuntResistanceMicroOhms);
+        taskData->packMonitor.packCurrentStatus = GOOD;
+
+        // Pack voltage
+        taskData->packMonitor.packVoltage = frontVoltageData->packMonitor.batteryVoltage1 * VBAT_DIVIDER_INV_GAIN;
+        taskData->packMonitor.packVoltageStatus = GOOD;
+    }
+
+    // Timestamp the snapshot data at the end of the last raw conversion or accumulation window before the snapshot
+    uint32_t boundaryPhaseCounts = (taskData->balancingEnabled) ? PHASE_COUNTS_PER_CONVERSION : ACCUMULATION_WINDOW_PHASE_COUNTS;
+    taskData->packMonitor.currentSampleTimeUs = getConversionEndTimeUs(&packMonitorPhase, snapshotTimeUs, boundaryPhaseCounts);
+
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        taskData->bmb[i].snapshotTimeUs = getConversionEndTimeUs(&cellMonitorPhase[i], snapshotTimeUs, CELL_MON_PHASE_COUNTS_PER_CONVERSION);
+    }
+
+    // Data age at read time
+    if(packMonitorPhase.phaseTimeUs > 0.0f)
+    {
+        taskData->dataAgeUs = __HAL_TIM_GetCounter(&htim5) - taskData->packMonitor.currentSampleTimeUs;
+    }
+
+    // Peak current over the samples taken since the last cycle, including this cycle's reading
+    if(fabsf(taskData->packMonitor.packCurrent) > fabsf(peakSampleCurrent))
+    {
+        peakSampleCurrent = taskData->packMonitor.packCurrent;
+    }
+    taskData->packMonitor.peakPackCurrent = peakSampleCurrent;
+    peakSampleCurrent = 0.0f;
 
-    // Pack voltage
-    taskData->packMonitor.packVoltage = batteryData.packMonitor.batteryVoltage1 * VBAT_DIVIDER_INV_GAIN;
-    taskData->packMonitor.packVoltageStatus = GOOD;
+    // Precharge progress from the high rate link voltage samples
+    taskData->packMonitor.prechargeState = prechargeState;
+    taskData->packMonitor.prechargeTimeConstantMs = prechargeTimeConstantS * MILLISECONDS_IN_SECOND;
+    taskData->packMonitor.prechargeTimeRemainingMs = prechargeTimeRemainingS * MILLISECONDS_IN_SECOND;
+    taskData->packMonitor.prechargeCompleteTimeUs = prechargeCompleteTimeUs;
 
     // Pack Energy
     taskData->packMonitor.packPower = taskData->packMonitor.packCurrent * taskData->packMonitor.packVoltage;
@@ -623,19 +1426,24 @@ static TRANSACTION_STATUS_E updatePrimaryPackTelemetry(telemetryTaskData_S *task
     // Update accumulation data
     if(taskData->packMonitor.adcConversionPhaseCounter >= taskData->packMonitor.nextQualifiedPhaseCount)
     {
-        // Calculate next valid conversion phase count
-        taskData->packMonitor.nextQualifiedPhaseCount += (ACCUMULATION_REGISTER_COUNT * PHASE_COUNTS_PER_CONVERSION);
+        // Windows completed since the last accumulation, the registers only hold the newest one
+        // so any missed window is filled with it rather than counting a stale window twice later
+        uint32_t windowsElapsed = 1 + ((taskData->packMonitor.adcConversionPhaseCounter - taskData->packMonitor.nextQualifiedPhaseCount) / ACCUMULATION_WINDOW_PHASE_COUNTS);
+
+        // Schedule the next qualified count on the first window boundary after the current count
+        taskData->packMonitor.nextQualifiedPhaseCount += (windowsElapsed * ACCUMULATION_WINDOW_PHASE_COUNTS);
 
         // Update coulomb counter
-        float accumulatedCurrent = batteryData.packMonitor.currentAdcAccumulator1uV / (taskData->packMonitor.shuntResistanceMicroOhms);
-        taskData->packMonitor.socData.milliCoulombCounter += (accumulatedCurrent * taskData->packMonitor.adcConversionTimeMS);
+        float accumulatedCurrentUv = fuseCurrentChannels(frontVoltageData->packMonitor.currentAdcAccumulator1uV, frontVoltageData->packMonitor.currentAdcAccumulator2uV);
+        float accumulatedCurrent = accumulatedCurrentUv / (taskData->packMonitor.shuntResistanceMicroOhms);
+        taskData->packMonitor.socData.milliCoulombCounter += (accumulatedCurrent * taskData->packMonitor.adcConversionTimeMS * windowsElapsed);
 
         // Update energy counter
-        float accumulatedVoltage = batteryData.packMonitor.batteryVoltageAccumulator1uV / MICROVOLTS_PER_VOLT;
-        taskData->packMonitor.packEnergyMilliJoules += (accumulatedVoltage * accumulatedCurrent * taskData->packMonitor.adcConversionTimeMS);
+        float accumulatedVoltage = frontVoltageData->packMonitor.batteryVoltageAccumulator1uV / MICROVOLTS_PER_VOLT;
+        taskData->packMonitor.packEnergyMilliJoules += (accumulatedVoltage * accumulatedCurrent * taskData->packMonitor.adcConversionTimeMS * windowsElapsed);
 
         // Update soc by ocv qualification timer
-        if(abs(batteryData.packMonitor.currentAdcAccumulator1uV) > ACCUMULATED_CURRENT_THRES_UV)
+        if(fabsf(accumulatedCurrentUv) > ACCUMULATED_CURRENT_THRES_UV)
         {
             clearTimer(&taskData->packMonitor.socData.socByOcvQualificationTimer);
         }
@@ -648,158 +1456,1280 @@ static TRANSACTION_STATUS_E updatePrimaryPackTelemetry(telemetryTaskData_S *task
     return status;
 }
 
-static TRANSACTION_STATUS_E runDeviceDiagnostics(telemetryTaskData_S *taskData)
+static void updateAdcFaults(telemetryTaskData_S *taskData)
 {
-    TRANSACTION_STATUS_E status = readRedundantCellVoltages(&batteryData);
+    static uint32_t adcMismatchCount[NUM_CELLS_IN_ACCUMULATOR];
 
-    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
     {
-        status = readRedundantAuxVoltages(&batteryData);
-    }
+        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+        {
+            uint32_t cell = CELL_INDEX(i, j);
+            float adcDifference = fabsf(batteryData.cellMonitor[i].redundantCellVoltage[j] - frontVoltageData->cellMonitor[i].cellVoltage[j]);
 
-    return status;
+            // A single disagreement can be a conversion boundary, only a persistent one faults the cell
+            if(adcDifference > REDUNDANT_ADC_FAULT_THRES_V)
+            {
+                if(adcMismatchCount[cell] < REDUNDANT_ADC_FAULT_COUNT)
+                {
+                    adcMismatchCount[cell]++;
+                }
+            }
+            else
+            {
+                adcMismatchCount[cell] = 0;
+            }
+
+            taskData->cells.cellAdcFault[cell] = (adcMismatchCount[cell] >= REDUNDANT_ADC_FAULT_COUNT);
+        }
+    }
 }
 
-static TRANSACTION_STATUS_E updateBalancingSwitches(telemetryTaskData_S *taskData)
+static void updateCurrentFusion(telemetryTaskData_S *taskData, float channel1Uv, float channel2Uv)
 {
-    if(taskData->balancingEnabled)
+    float shuntResistance = taskData->packMonitor.shuntResistanceMicroOhms;
+    float current1 = channel1Uv / shuntResistance;
+    float current2 = channel2Uv / shuntResistance;
+
+    // A steady offset between the channels is drift, a sample to sample difference is noise
+    taskData->packMonitor.currentChannelDivergence += CURRENT_DIVERGENCE_FILTER_GAIN * ((current1 - current2) - taskData->packMonitor.currentChannelDivergence);
+
+    bool channelsSuspect = false;
+    float agreeThres = CURRENT_CHANNEL_AGREE_THRES_A + (CURRENT_CHANNEL_AGREE_GAIN * fabsf(0.5f * (current1 + current2)));
+    if(fabsf(taskData->packMonitor.currentChannelDivergence) <= agreeThres)
     {
-        if((taskData->minCellVoltage + 0.05f) > taskData->balancingFloor)
-        {
-            taskData->balancingFloor = (taskData->minCellVoltage + 0.05f);
-        }
+        currentChannelExcluded[CURRENT_CHANNEL_1] = false;
+        currentChannelExcluded[CURRENT_CHANNEL_2] = false;
     }
     else
     {
-        taskData->balancingFloor = MIN_BRICK_WARNING_VOLTAGE;
+        // The overcurrent ADC measures the same shunt independently, but its coarse reading can only
+        // pick the drifting channel once the channels are more than one of its counts apart
+        float referenceResolution = (HW_OVERCURRENT_ADC_LSB_MV * MICROVOLTS_PER_MILLIVOLT) / shuntResistance;
+        if(fabsf(current1 - current2) > referenceResolution)
+        {
+            float referenceCurrent = (frontVoltageData->packMonitor.overcurrentStatusGroup.overCurrentAdc1 * MICROVOLTS_PER_MILLIVOLT) / shuntResistance;
+            bool channel1Drifting = (fabsf(current1 - referenceCurrent) > fabsf(current2 - referenceCurrent));
+            currentChannelExcluded[CURRENT_CHANNEL_1] = channel1Drifting;
+            currentChannelExcluded[CURRENT_CHANNEL_2] = !channel1Drifting;
+        }
+        else
+        {
+            // Neither channel can be trusted over the other, keep averaging both but flag them
+            currentChannelExcluded[CURRENT_CHANNEL_1] = false;
+            currentChannelExcluded[CURRENT_CHANNEL_2] = false;
+            channelsSuspect = true;
+        }
     }
 
-    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    for(uint32_t i = 0; i < NUM_CURRENT_CHANNELS; i++)
     {
+        taskData->packMonitor.currentChannelStatus[i] = (currentChannelExcluded[i] || channelsSuspect) ? (BAD) : (GOOD);
+    }
+}
 
-        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
-        {
-            bool balancingDis = !(taskData->balancingEnabled);
-            bool cellBad = (taskData->bmb[i].cellVoltageStatus[j] != GOOD);
-            bool lowCell = taskData->bmb[i].cellVoltage[j] <= taskData->balancingFloor; 
+static float fuseCurrentChannels(float channel1Uv, float channel2Uv)
+{
+    // Averaging two agreeing channels halves the noise power at the same sample rate
+    if(currentChannelExcluded[CURRENT_CHANNEL_1])
+    {
+        return channel2Uv;
+    }
+    else if(currentChannelExcluded[CURRENT_CHANNEL_2])
+    {
+        return channel1Uv;
+    }
 
-            bool isCell = ((i == 2) && ((j == 6) || (j == 7)));
+    return 0.5f * (channel1Uv + channel2Uv);
+}
 
-            if(balancingDis || cellBad || lowCell || isCell)
-            {
-                batteryData.cellMonitor[i].configGroupB.dischargeCell[j] = false;
-                taskData->bmb[i].cellBalancingActive[j] = false;
-            }
-            else
-            {
-                static uint32_t overTempTimeout = 0;
+static void updateShuntThermalModel(telemetryTaskData_S *taskData)
+{
+    // The board sensors sit next to the shunt, use the mean of the good ones as the heatsink temp
+    float sensorTemp = 0.0f;
+    uint32_t numSensors = 0;
+    if(taskData->packMonitor.shuntTemp1Status == GOOD)
+    {
+        sensorTemp += taskData->packMonitor.shuntTemp1;
+        numSensors++;
+    }
+    if(taskData->packMonitor.shuntTemp2Status == GOOD)
+    {
+        sensorTemp += taskData->packMonitor.shuntTemp2;
+        numSensors++;
+    }
+    sensorTemp = (numSensors > 0) ? (sensorTemp / numSensors) : (SHUNT_REF_TEMP_C);
 
-                if(taskData->maxCellTemp >= 50.0f || taskData->maxBoardTemp >= 100.0f || taskData->maxDieTemp > 125.0f)
-                {
-                    overTempTimeout = HAL_GetTick() + 60000UL;
-                }
+    // Heat dissipated over the interval since the last snapshot, from the current converted last cycle
+    if(shuntModelStarted)
+    {
+        float dtS = (float)(snapshotTimeUs - lastShuntModelTimeUs) / (MICROSECONDS_IN_MILLISECOND * MILLISECONDS_IN_SECOND);
+        float packCurrent = taskData->packMonitor.packCurrent;
+        float shuntPowerW = (packCurrent * packCurrent * taskData->packMonitor.shuntResistanceMicroOhms) / MICROWATTS_PER_WATT;
 
-                if(HAL_GetTick() >= overTempTimeout)
-                {
-                    batteryData.cellMonitor[i].configGroupB.dischargeCell[j] = true;
-                    taskData->bmb[i].cellBalancingActive[j] = true;
-                }
-                else
-                {
-                    batteryData.cellMonitor[i].configGroupB.dischargeCell[j] = false;
-                    taskData->bmb[i].cellBalancingActive[j] = false;
-                }
-            }
-        }
+        // Forward euler step of dT/dt = (P * Rth - T) / tau, clamped to one time constant after long gaps
+        float stepGain = fminf(dtS / SHUNT_THERMAL_TIME_CONSTANT_S, 1.0f);
+        shuntElementTempRise += stepGain * ((shuntPowerW * SHUNT_THERMAL_RESISTANCE_C_PER_W) - shuntElementTempRise);
     }
+    lastShuntModelTimeUs = snapshotTimeUs;
+    shuntModelStarted = true;
 
-    return writeConfigB(&batteryData);
+    taskData->packMonitor.shuntElementTemp = sensorTemp + shuntElementTempRise;
+    taskData->packMonitor.shuntResistanceMicroOhms = SHUNT_REF_RESISTANCE_UOHM + SHUNT_RESISTANCE_GAIN_UOHM * (taskData->packMonitor.shuntElementTemp - SHUNT_REF_TEMP_C);
 }
 
-/* ==================================================================== */
-/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
-/* ==================================================================== */
+static float getPhaseCountTimeUs(telemetryTaskData_S *taskData)
+{
+    // Conversion time is only calibrated once the pack monitor counter buffer has filled
+    if(!batteryData.packMonitor.statusGroupE.revisionCode || (taskData->packMonitor.adcConversionTimeMS <= 0.0f))
+    {
+        return 0.0f;
+    }
 
-TRANSACTION_STATUS_E updateBatteryTelemetry(telemetryTaskData_S *taskData)
+    return (taskData->packMonitor.adcConversionTimeMS * MICROSECONDS_IN_MILLISECOND) / PHASE_COUNTS_PER_CONVERSION;
+}
+
+static void fitConversionPhase(telemetryTaskData_S *taskData, uint32_t newestIndex, uint32_t *fittedTimeUs)
 {
-    TRANSACTION_STATUS_E telemetryStatus;
+    // Points are taken relative to the newest one so the sums stay well inside float precision
+    uint32_t refCounter = conversionCounterBuffer[COUNTER_INDEX][newestIndex];
+    uint32_t refTimer = conversionCounterBuffer[TIMER_INDEX][newestIndex];
 
-    if(taskData->chainInitialized)
+    bool inlier[CONVERSION_BUFFER_SIZE];
+    uint32_t numPoints = 0;
+    for(uint32_t i = 0; i < CONVERSION_BUFFER_SIZE; i++)
     {
-        telemetryStatus = runCommandBlock(startNewReadCycle, taskData);
+        // A 0 counter marks a slot not yet filled since the last reset
+        inlier[i] = (conversionCounterBuffer[COUNTER_INDEX][i] != 0);
+        numPoints += inlier[i];
+    }
 
-        if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
+    float slopeUs = 0.0f;
+    float interceptUs = 0.0f;
+    float residualRmsUs = 0.0f;
+    uint32_t numInliers = 0;
+
+    // Least squares fit of timer against phase count, refit once without the outliers of the first pass
+    for(uint32_t pass = 0; pass < 2; pass++)
+    {
+        float sumX = 0.0f;
+        float sumY = 0.0f;
+        numInliers = 0;
+        for(uint32_t i = 0; i < CONVERSION_BUFFER_SIZE; i++)
         {
-            telemetryStatus = runCommandBlock(updateDeviceStatus, taskData);
+            if(inlier[i])
+            {
+                sumX += (float)(int32_t)(conversionCounterBuffer[COUNTER_INDEX][i] - refCounter);
+                sumY += (float)(int32_t)(conversionCounterBuffer[TIMER_INDEX][i] - refTimer);
+                numInliers++;
+            }
         }
 
-        if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
+        if(numInliers < CONVERSION_FIT_MIN_POINTS)
         {
-            telemetryStatus = runCommandBlock(updateAuxPackTelemetry, taskData);
+            return;
         }
 
-        if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
+        // Centered sums avoid the cancellation of the textbook normal equations
+        float meanX = sumX / numInliers;
+        float meanY = sumY / numInliers;
+        float sumXX = 0.0f;
+        float sumXY = 0.0f;
+        for(uint32_t i = 0; i < CONVERSION_BUFFER_SIZE; i++)
         {
-            telemetryStatus = runCommandBlock(updatePrimaryPackTelemetry, taskData);
+            if(inlier[i])
+            {
+                float dx = (float)(int32_t)(conversionCounterBuffer[COUNTER_INDEX][i] - refCounter) - meanX;
+                float dy = (float)(int32_t)(conversionCounterBuffer[TIMER_INDEX][i] - refTimer) - meanY;
+                sumXX += dx * dx;
+                sumXY += dx * dy;
+            }
         }
 
-        if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
+        // A stalled counter gives no period information
+        if(sumXX <= 0.0f)
         {
-            telemetryStatus = runCommandBlock(runDeviceDiagnostics, taskData);
+            return;
         }
 
-        if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
-        {
-            // Update statistics
-            updateBatteryStatistics(taskData);
+        slopeUs = sumXY / sumXX;
+        interceptUs = meanY - (slopeUs * meanX);
 
-            // Update SOC
-            updateSocSoe(&taskData->packMonitor.socData, taskData->minCellVoltage);
+        float sumSquaredResidual = 0.0f;
+        for(uint32_t i = 0; i < CONVERSION_BUFFER_SIZE; i++)
+        {
+            if(inlier[i])
+            {
+                float x = (float)(int32_t)(conversionCounterBuffer[COUNTER_INDEX][i] - refCounter);
+                float y = (float)(int32_t)(conversionCounterBuffer[TIMER_INDEX][i] - refTimer);
+                float residual = y - (interceptUs + (slopeUs * x));
+                sumSquaredResidual += residual * residual;
+            }
         }
+        residualRmsUs = sqrtf(sumSquaredResidual / numInliers);
 
-        if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
+        if(pass == 0)
         {
-            telemetryStatus = runCommandBlock(updateBalancingSwitches, taskData);
+            float outlierThresUs = fmaxf(CONVERSION_FIT_OUTLIER_GAIN * residualRmsUs, CONVERSION_FIT_MIN_OUTLIER_US);
+            for(uint32_t i = 0; i < CONVERSION_BUFFER_SIZE; i++)
+            {
+                if(inlier[i])
+                {
+                    float x = (float)(int32_t)(conversionCounterBuffer[COUNTER_INDEX][i] - refCounter);
+                    float y = (float)(int32_t)(conversionCounterBuffer[TIMER_INDEX][i] - refTimer);
+                    inlier[i] = (fabsf(y - (interceptUs + (slopeUs * x))) <= outlierThresUs);
+                }
+            }
         }
     }
 
-    if(!taskData->chainInitialized || (telemetryStatus == TRANSACTION_POR_ERROR))
+    if(slopeUs <= 0.0f)
     {
-        Debug("Initializing chain...\n");
+        return;
+    }
+
+    // Slope is the time per phase count, the intercept is the fitted time of the newest counter read
+    taskData->packMonitor.adcConversionTimeMS = (slopeUs * PHASE_COUNTS_PER_CONVERSION) / MICROSECONDS_IN_MILLISECOND;
+    taskData->packMonitor.adcPhaseFitResidualUs = residualRmsUs;
+    taskData->packMonitor.adcPhaseFitConfidence = (float)numInliers / numPoints;
+    *fittedTimeUs = refTimer + (int32_t)lroundf(interceptUs);
+}
 
-        telemetryStatus = runCommandBlock(initChain, taskData);
+static void updateConversionPhase(Conversion_Phase_S *phase, uint32_t phaseCount)
+{
+    // A cycle is far shorter than the 13 bit counter rollover, so the masked delta is the true count
+    uint32_t deltaPhaseCount = (phaseCount - phase->phaseCount) & MAX_13BIT_UINT;
+    uint32_t deltaTimeUs = snapshotTimeUs - phase->timeUs;
 
-        if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
+    if(phase->valid && deltaPhaseCount)
+    {
+        float phaseTimeUs = (float)deltaTimeUs / deltaPhaseCount;
+
+        // Each cycle only resolves the phase to one count, so the estimate is low pass filtered
+        if(phase->phaseTimeUs <= 0.0f)
         {
-            Debug("Chain initialization successful!\n");
-            taskData->chainInitialized = true;
+            phase->phaseTimeUs = phaseTimeUs;
         }
         else
         {
-            Debug("Chain failed to initialize!\n");
-            taskData->chainInitialized = false;
+            phase->phaseTimeUs += PHASE_TIME_FILTER_GAIN * (phaseTimeUs - phase->phaseTimeUs);
         }
     }
 
-    // Set chain status    
+    phase->valid = true;
+    phase->phaseCount = phaseCount;
+    phase->timeUs = snapshotTimeUs;
+}
 
-    if(taskData->chainInfo.chainStatus == MULTIPLE_CHAIN_BREAK)
+static uint32_t getConversionEndTimeUs(Conversion_Phase_S *phase, uint32_t timeUs, uint32_t boundaryPhaseCounts)
+{
+    // Without a calibrated phase the data is stamped with the time it was captured
+    if(!phase->valid || (phase->phaseTimeUs <= 0.0f))
     {
-        uint32_t numBmbsA;
-        uint32_t numBmbsB;
-        if(taskData->chainInfo.packMonitorPort == PORTA)
-        {
-            if(taskData->chainInfo.availableDevices[PORTA] >= 1)
-            {
-                taskData->packMonitorStatus = GOOD;
-            }
-            else
-            {
-                taskData->packMonitorStatus = BAD;
-            }
+        return timeUs;
+    }
 
-            numBmbsA = taskData->chainInfo.availableDevices[PORTA] - 1;
-            numBmbsB = taskData->chainInfo.availableDevices[PORTB];
+    // Project the phase count forward from the snapshot, then step back to the last conversion boundary
+    float phaseCounts = (phase->phaseCount % boundaryPhaseCounts) + ((float)(int32_t)(timeUs - phase->timeUs) / phase->phaseTimeUs);
+    float phaseCountsSinceBoundary = fmodf(phaseCounts, (float)boundaryPhaseCounts);
+    if(phaseCountsSinceBoundary < 0.0f)
+    {
+        phaseCountsSinceBoundary += boundaryPhaseCounts;
+    }
+
+    return timeUs - (uint32_t)(phaseCountsSinceBoundary * phase->phaseTimeUs);
+}
+
+static void updateTelemetryRate(telemetryTaskData_S *taskData)
+{
+    // Pack voltage slew between cycles
+    float packDvdt = 0.0f;
+    uint32_t sampleTimeUs = taskData->packMonitor.currentSampleTimeUs;
+    if(rateVoltageValid && (sampleTimeUs != lastRateTimeUs))
+    {
+        packDvdt = fabsf(taskData->packMonitor.packVoltage - lastRatePackVoltage) * MICROSECONDS_IN_SECOND / (float)(sampleTimeUs - lastRateTimeUs);
+    }
+    lastRatePackVoltage = taskData->packMonitor.packVoltage;
+    lastRateTimeUs = sampleTimeUs;
+    rateVoltageValid = true;
+
+    float packCurrent = fmaxf(fabsf(taskData->packMonitor.packCurrent), fabsf(taskData->packMonitor.peakPackCurrent));
+
+    // Activity and rest use separate thresholds so the rate does not hunt around a single limit
+    bool active = ((packCurrent > ACTIVITY_CURRENT_THRES_A) ||
+                   (packDvdt > ACTIVITY_PACK_DVDT_THRES_V_S) ||
+                   (taskData->maxCellVoltage > (MAX_BRICK_WARNING_VOLTAGE - ACTIVITY_CELL_VOLTAGE_MARGIN_V)) ||
+                   (taskData->minCellVoltage < (MIN_BRICK_WARNING_VOLTAGE + ACTIVITY_CELL_VOLTAGE_MARGIN_V)) ||
+                   (taskData->maxCellTemp > (MAX_BRICK_TEMP_WARNING_C - ACTIVITY_CELL_TEMP_MARGIN_C)) ||
+                   (prechargeState == PRECHARGE_ACTIVE));
+
+    bool resting = ((packCurrent < REST_CURRENT_THRES_A) &&
+                    (packDvdt < REST_PACK_DVDT_THRES_V_S) &&
+                    (taskData->maxCellVoltage < (MAX_BRICK_WARNING_VOLTAGE - REST_CELL_VOLTAGE_MARGIN_V)) &&
+                    (taskData->minCellVoltage > (MIN_BRICK_WARNING_VOLTAGE + REST_CELL_VOLTAGE_MARGIN_V)) &&
+                    (taskData->maxCellTemp < (MAX_BRICK_TEMP_WARNING_C - REST_CELL_TEMP_MARGIN_C)) &&
+                    (prechargeState != PRECHARGE_ACTIVE));
+
+    if(active)
+    {
+        telemetryRateLevel = 0;
+        restCycles = 0;
+    }
+    else if(resting)
+    {
+        restCycles++;
+        if((restCycles >= REST_QUALIFY_CYCLES) && (telemetryRateLevel < TELEMETRY_RATE_MAX_LEVEL))
+        {
+            telemetryRateLevel++;
+            restCycles = 0;
+        }
+    }
+    else
+    {
+        // Between the thresholds the rate holds
+        restCycles = 0;
+    }
+
+    taskData->telemetryPeriodMs = getTelemetryPeriodMs();
+}
+
+static void predictNextConversion(telemetryTaskData_S *taskData)
+{
+    float phaseCountTimeUs = getPhaseCountTimeUs(taskData);
+    if(phaseCountTimeUs <= 0.0f)
+    {
+        wakePredictionValid = false;
+        return;
+    }
+
+    // Accumulation windows start at the pack monitor reset, so window ends fall on multiples of the window length
+    uint32_t phaseCountsToWindowEnd = ACCUMULATION_WINDOW_PHASE_COUNTS - (taskData->packMonitor.adcConversionPhaseCounter % ACCUMULATION_WINDOW_PHASE_COUNTS);
+    nextWakeTimeUs = packMonitorPhase.timeUs + (uint32_t)(phaseCountsToWindowEnd * phaseCountTimeUs) + CONVERSION_WAKE_MARGIN_US;
+
+    // If this cycle overran the window end, wait for the window after it
+    uint32_t windowTimeUs = (uint32_t)(ACCUMULATION_WINDOW_PHASE_COUNTS * phaseCountTimeUs);
+    uint32_t currentTimeUs = __HAL_TIM_GetCounter(&htim5);
+    while((int32_t)(nextWakeTimeUs - currentTimeUs) <= 0)
+    {
+        nextWakeTimeUs += windowTimeUs;
+    }
+
+    // At a reduced rate skip whole windows, the coulomb counter fills the windows skipped
+    nextWakeTimeUs += (((1 << telemetryRateLevel) - 1) * windowTimeUs);
+
+    wakePredictionValid = true;
+}
+
+static bool adcMismatchPresent(telemetryTaskData_S *taskData)
+{
+    // The cell monitors compare the C-ADC and S-ADC results on chip and report mismatches in status C
+    bool mismatchPresent = false;
+    for(uint32_t i = 0; i < NUM_CELLS_IN_ACCUMULATOR; i++)
+    {
+        mismatchPresent |= taskData->cells.cellAdcMismatch[i];
+    }
+
+    return mismatchPresent;
+}
+
+static TRANSACTION_STATUS_E runDeviceDiagnostics(telemetryTaskData_S *taskData)
+{
+    TRANSACTION_STATUS_E status;
+    bool testComplete = false;
+
+    switch(diagnosticState)
+    {
+        case REDUNDANT_ADC_DIAG_STATE:
+            status = runRedundantAdcSlice(taskData, &testComplete);
+            break;
+        case OPEN_WIRE_EVEN_DIAG_STATE:
+            status = runCellOpenWireSlice(taskData, CELL_OPEN_WIRE_EVEN, &testComplete);
+            break;
+        case OPEN_WIRE_ODD_DIAG_STATE:
+            status = runCellOpenWireSlice(taskData, CELL_OPEN_WIRE_ODD, &testComplete);
+            break;
+        case AUX_OPEN_WIRE_PULL_DOWN_DIAG_STATE:
+            status = runAuxOpenWireSlice(taskData, AUX_OPEN_WIRE_PULL_DOWN, &testComplete);
+            break;
+        case AUX_OPEN_WIRE_PULL_UP_DIAG_STATE:
+            status = runAuxOpenWireSlice(taskData, AUX_OPEN_WIRE_PULL_UP, &testComplete);
+            break;
+        default:
+            diagnosticState = REDUNDANT_ADC_DIAG_STATE;
+            diagnosticSlice = 0;
+            return TRANSACTION_SUCCESS;
+    }
+
+    if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        // The slice is rerun from the same point on the next attempt
+        return status;
+    }
+
+    if(testComplete)
+    {
+        // Record how often each test covers the chain
+        Diagnostic_Coverage_S *coverage = &taskData->diagnosticCoverage[diagnosticState];
+        uint32_t currentTick = HAL_GetTick();
+        if(coverage->numPasses)
+        {
+            coverage->coverageIntervalMs = currentTick - coverage->lastCompleteTick;
+        }
+        coverage->lastCompleteTick = currentTick;
+        coverage->numPasses++;
+
+        // Rotate to the next test
+        diagnosticState = (diagnosticState + 1) % NUM_ADC_DIAG_STATES;
+        diagnosticSlice = 0;
+    }
+
+    return status;
+}
+
+static TRANSACTION_STATUS_E runRedundantAdcSlice(telemetryTaskData_S *taskData, bool *testComplete)
+{
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+
+    switch(diagnosticSlice)
+    {
+        case REDUNDANT_CELL_READ_SLICE:
+            status = readRedundantCellVoltages(&batteryData);
+
+            // Unreached devices hand back zeroed registers, so only a complete read is compared
+            if(status == TRANSACTION_SUCCESS)
+            {
+                updateAdcFaults(taskData);
+                redundantCellsRead = true;
+            }
+
+            if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                diagnosticSlice++;
+            }
+            break;
+
+        case REDUNDANT_AUX_READ_SLICE:
+        default:
+            status = readRedundantAuxVoltages(&batteryData);
+
+            // Clear the latched mismatch bits so a persistent fault sets them again on the next conversion
+            if(adcMismatchPresent(taskData) && ((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)))
+            {
+                status = clearCellAdcMismatchFlags(&batteryData);
+            }
+
+            *testComplete = ((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR));
+            break;
+    }
+
+    return status;
+}
+
+static TRANSACTION_STATUS_E runCellOpenWireSlice(telemetryTaskData_S *taskData, ADC_MODE_CELL_OPEN_WIRE_E openWireMode, bool *testComplete)
+{
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+    bool *openWireResult = (openWireMode == CELL_OPEN_WIRE_EVEN) ? cellOpenWireEven : cellOpenWireOdd;
+
+    switch(diagnosticSlice)
+    {
+        case OPEN_WIRE_START_SLICE:
+            // Run the S-ADC continuously with the open wire pull down current on even or odd cells
+            status = startRedundantCellConversions(&batteryData, CONTINOUS_MODE, DISCHARGE_DISABLED, openWireMode);
+            if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                cellOpenWireActive = true;
+                openWireSoakStartTick = HAL_GetTick();
+                diagnosticSlice++;
+            }
+            break;
+
+        case OPEN_WIRE_SOAK_SLICE:
+            // The other command blocks keep running while the pull down current soaks, this test only waits
+            if((HAL_GetTick() - openWireSoakStartTick) >= CELL_OPEN_WIRE_SOAK_TIME_MS)
+            {
+                diagnosticSlice++;
+            }
+            break;
+
+        case OPEN_WIRE_READ_SLICE:
+            status = readRedundantCellVoltages(&batteryData);
+
+            // An open sense wire lets the pull down drag the S-ADC reading away from the C-ADC reading
+            // Unreached devices hand back zeroed registers, so a partial read keeps the previous results
+            if(status == TRANSACTION_SUCCESS)
+            {
+                for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+                {
+                    for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+                    {
+                        float delta = batteryData.cellMonitor[i].redundantCellVoltage[j] - taskData->cells.cellVoltage[CELL_INDEX(i, j)];
+                        openWireResult[CELL_INDEX(i, j)] = (fabsf(delta) > CELL_OPEN_WIRE_THRES_V);
+                    }
+                }
+            }
+
+            if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                diagnosticSlice++;
+            }
+            break;
+
+        case OPEN_WIRE_RESTORE_SLICE:
+        default:
+            // Hand the S-ADC back to redundant cell conversions without resetting the filter
+            status = startCellConversions(&batteryData, REDUNDANT_MODE, CONTINOUS_MODE, DISCHARGE_DISABLED, NO_FILTER_RESET, CELL_OPEN_WIRE_DISABLED);
+
+            // Comparisons made during the test are invalid
+            if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                status = clearCellAdcMismatchFlags(&batteryData);
+            }
+
+            if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                cellOpenWireActive = false;
+
+                // Restarting ADCV resets the cell monitor conversion counters, so each phase is re-based
+                // on the next snapshot instead of being fitted across the restart
+                for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+                {
+                    cellMonitorPhase[i].valid = false;
+                }
+
+                // Assemble the chain result from the latest even and odd passes
+                for(uint32_t i = 0; i < NUM_CELLS_IN_ACCUMULATOR; i++)
+                {
+                    taskData->cells.cellOpenWire[i] = cellOpenWireEven[i] || cellOpenWireOdd[i];
+                }
+                *testComplete = true;
+            }
+            break;
+    }
+
+    return status;
+}
+
+static TRANSACTION_STATUS_E runAuxOpenWireSlice(telemetryTaskData_S *taskData, ADC_MODE_AUX_OPEN_WIRE_E openWireMode, bool *testComplete)
+{
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+
+    switch(diagnosticSlice)
+    {
+        case OPEN_WIRE_START_SLICE:
+            // Hold off the temperature group so it does not restart the aux ADC or toggle the mux
+            auxOpenWireActive = true;
+            status = startAuxConversions(&batteryData, AUX_ALL_CHANNELS, openWireMode);
+            if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                openWireSoakStartTick = HAL_GetTick();
+                diagnosticSlice++;
+            }
+            break;
+
+        case OPEN_WIRE_SOAK_SLICE:
+            if((HAL_GetTick() - openWireSoakStartTick) >= AUX_OPEN_WIRE_SOAK_TIME_MS)
+            {
+                diagnosticSlice++;
+            }
+            break;
+
+        case OPEN_WIRE_READ_SLICE:
+            status = readAuxVoltages(&batteryData);
+
+            // As with the cell test, a partial read keeps the previous results
+            if(status == TRANSACTION_SUCCESS)
+            {
+                for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+                {
+                    uint8_t muxState = batteryData.cellMonitor[i].configGroupA.gpo10State;
+
+                    // Open wire readings are compared straight from the back buffer and never published
+                    for(uint32_t j = 0; j < NUM_CELL_TEMP_ADCS; j++)
+                    {
+                        float auxVoltage = batteryData.auxData->cellMonitor[i].auxVoltage[j];
+
+                        if(openWireMode == AUX_OPEN_WIRE_PULL_DOWN)
+                        {
+                            auxPullDownVoltage[i][j] = auxVoltage;
+                        }
+                        else if(muxState == auxPullDownMuxState[i])
+                        {
+                            // A connected thermistor holds the input, an open input follows the pull current
+                            bool openWire = ((auxVoltage - auxPullDownVoltage[i][j]) > AUX_OPEN_WIRE_THRES_V);
+                            taskData->cells.cellTempOpenWire[CELL_INDEX(i, (j * 2) + muxState)] = openWire;
+                        }
+                    }
+
+                    // Pull up results are only paired with pull down results taken on the same mux state
+                    if(openWireMode == AUX_OPEN_WIRE_PULL_DOWN)
+                    {
+                        auxPullDownMuxState[i] = muxState;
+                    }
+                }
+            }
+
+            if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                diagnosticSlice++;
+            }
+            break;
+
+        case OPEN_WIRE_RESTORE_SLICE:
+        default:
+            // Restart normal aux conversions so the temperature group reads valid data
+            status = startAuxConversions(&batteryData, AUX_ALL_CHANNELS, AUX_OPEN_WIRE_DISABLED);
+            if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                auxOpenWireActive = false;
+                *testComplete = true;
+            }
+            break;
+    }
+
+    return status;
+}
+
+static TRANSACTION_STATUS_E verifyAdcMismatch(telemetryTaskData_S *taskData)
+{
+    // A mismatch is read back in the cycle it is seen rather than on the next redundant ADC pass
+    // Skipped when that pass already read back this cycle, or while the open wire test owns the S-ADC
+    if(!adcMismatchPresent(taskData) || redundantCellsRead || cellOpenWireActive)
+    {
+        return TRANSACTION_SUCCESS;
+    }
+
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+
+    if(stepPending(ADC_MISMATCH_READ_STEP))
+    {
+        status = readRedundantCellVoltages(&batteryData);
+
+        // Unreached devices hand back zeroed registers, so only a complete read is compared
+        if(status == TRANSACTION_SUCCESS)
+        {
+            updateAdcFaults(taskData);
+            redundantCellsRead = true;
+        }
+
+        setCheckpoint(ADC_MISMATCH_READ_STEP, status);
+    }
+
+    // Clear the latched mismatch bits so a persistent fault sets them again on the next conversion
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(ADC_MISMATCH_CLEAR_STEP))
+    {
+        status = clearCellAdcMismatchFlags(&batteryData);
+    }
+
+    return status;
+}
+
+static TRANSACTION_STATUS_E updatePackStatistics(telemetryTaskData_S *taskData)
+{
+    // Update statistics
+    updateBatteryStatistics(taskData);
+
+    // Update SOC
+    updateSocSoe(&taskData->packMonitor.socData, taskData->minCellVoltage);
+
+    return TRANSACTION_SUCCESS;
+}
+
+static uint32_t calculateDischargeMinutes(float cellVoltage, float targetVoltage)
+{
+    if(cellVoltage <= targetVoltage)
+    {
+        return 0;
+    }
+
+    // Charge to remove comes from the OCV curve, drained at the discharge resistor current
+    float dischargeSoc = lookup(cellVoltage, &socByOcvTable) - lookup(targetVoltage, &socByOcvTable);
+    float dischargeMah = dischargeSoc * CELL_CAPACITY_MAH * NUM_PARALLEL_CELLS;
+    float dischargeMa = (cellVoltage / BALANCING_RESISTANCE_OHM) * MILLIAMPS_IN_AMP;
+
+    if(dischargeMah <= 0.0f)
+    {
+        return 0;
+    }
+
+    return (uint32_t)ceilf((dischargeMah / dischargeMa) * MINUTES_IN_HOUR);
+}
+
+static TRANSACTION_STATUS_E updateBalancingSwitches(telemetryTaskData_S *taskData)
+{
+    static uint32_t overTempTimeout = 0;
+    static uint32_t lastBalancingPlanTick = 0;
+    static bool balancingPlanActive = false;
+    static bool balancingPlanEnabled = false;
+    static bool balancingPlanPending = false;
+    static uint32_t lastConfigVerifyTick = 0;
+    static uint32_t dischargeStartTick[NUM_CELL_MON_IN_ACCUMULATOR];
+    static uint32_t dischargeDurationMs[NUM_CELL_MON_IN_ACCUMULATOR];
+
+    if(taskData->balancingEnabled)
+    {
+        if((taskData->minCellVoltage + 0.05f) > taskData->balancingFloor)
+        {
+            taskData->balancingFloor = (taskData->minCellVoltage + 0.05f);
+        }
+    }
+    else
+    {
+        taskData->balancingFloor = MIN_BRICK_WARNING_VOLTAGE;
+    }
+
+    bool overTemp = (taskData->maxCellTemp >= 50.0f || taskData->maxBoardTemp >= 100.0f || taskData->maxDieTemp > 125.0f);
+    if(overTemp)
+    {
+        overTempTimeout = HAL_GetTick() + 60000UL;
+    }
+
+#if BALANCING_OFFLOAD_ENABLED
+    // A device stops discharging on its own when its discharge timer expires, so the published state follows it
+    bool timerRunning = false;
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        if((dischargeDurationMs[i] > 0) && ((HAL_GetTick() - dischargeStartTick[i]) >= dischargeDurationMs[i]))
+        {
+            dischargeDurationMs[i] = 0;
+
+            for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+            {
+                batteryData.cellMonitor[i].configGroupB.dischargeCell[j] = false;
+                taskData->cells.cellBalancingActive[CELL_INDEX(i, j)] = false;
+            }
+        }
+
+        timerRunning |= (dischargeDurationMs[i] > 0);
+    }
+    balancingPlanActive &= timerRunning;
+
+    // Between plans the device discharge timers balance on their own, only stopping balancing is urgent
+    bool stopRequired = balancingPlanActive && (!taskData->balancingEnabled || overTemp);
+    bool replanDue = ((HAL_GetTick() - lastBalancingPlanTick) >= BALANCING_REPLAN_PERIOD_MS);
+    bool startRequired = !balancingPlanEnabled && taskData->balancingEnabled;
+
+    // A device whose thresholds no longer read back as written is rewritten along with a fresh plan
+    bool configLost = false;
+    if((HAL_GetTick() - lastConfigVerifyTick) >= CONFIG_B_VERIFY_PERIOD_MS)
+    {
+        uint32_t mismatchMask = 0;
+        TRANSACTION_STATUS_E status = verifyConfigBThresholds(&batteryData, &mismatchMask);
+        if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            return status;
+        }
+
+        lastConfigVerifyTick = HAL_GetTick();
+        configLost = (mismatchMask != 0);
+    }
+
+    if(!stopRequired && !replanDue && !startRequired && !balancingPlanPending && !configLost)
+    {
+        return TRANSACTION_SUCCESS;
+    }
+#endif
+
+    bool planActive = false;
+
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        // One discharge timer per device, sized to the smallest need so no cell is discharged past the floor
+        uint32_t dischargeTimeoutMinutes = 0;
+
+        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+        {
+            bool balancingDis = !(taskData->balancingEnabled);
+            bool cellBad = (taskData->cells.cellVoltageStatus[CELL_INDEX(i, j)] != GOOD);
+            bool lowCell = taskData->cells.cellVoltage[CELL_INDEX(i, j)] <= taskData->balancingFloor; 
+
+            bool isCell = ((i == 2) && ((j == 6) || (j == 7)));
+
+            bool dischargeCell = !(balancingDis || cellBad || lowCell || isCell) && (HAL_GetTick() >= overTempTimeout);
+
+#if BALANCING_OFFLOAD_ENABLED
+            if(dischargeCell)
+            {
+                uint32_t cellMinutes = calculateDischargeMinutes(taskData->cells.cellVoltage[CELL_INDEX(i, j)], taskData->balancingFloor);
+                if(cellMinutes == 0)
+                {
+                    dischargeCell = false;
+                }
+                else if((dischargeTimeoutMinutes == 0) || (cellMinutes < dischargeTimeoutMinutes))
+                {
+                    dischargeTimeoutMinutes = cellMinutes;
+                }
+            }
+#endif
+
+            batteryData.cellMonitor[i].configGroupB.dischargeCell[j] = dischargeCell;
+            taskData->cells.cellBalancingActive[CELL_INDEX(i, j)] = dischargeCell;
+            planActive |= dischargeCell;
+        }
+
+        batteryData.cellMonitor[i].configGroupB.dischargeTimeoutMinutes = dischargeTimeoutMinutes;
+    }
+
+    TRANSACTION_STATUS_E status = writeConfigB(&batteryData);
+    if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        // The devices may still hold the previous plan, keep its state and plan again next cycle
+        balancingPlanPending = true;
+        return status;
+    }
+
+    balancingPlanPending = false;
+    lastBalancingPlanTick = HAL_GetTick();
+    balancingPlanActive = planActive;
+    balancingPlanEnabled = taskData->balancingEnabled;
+
+    // The timers restart on the write, with the timeout as rounded by the register encoding
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        dischargeStartTick[i] = lastBalancingPlanTick;
+        dischargeDurationMs[i] = batteryData.cellMonitor[i].configGroupB.dischargeTimeoutMinutes * SECONDS_IN_MINUTE * MILLISECONDS_IN_SECOND;
+    }
+
+    return status;
+}
+
+static TRANSACTION_STATUS_E pollHardwareFaults(telemetryTaskData_S *taskData)
+{
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+
+    if(stepPending(HW_FAULT_OVUV_READ_STEP))
+    {
+        status = readCellOvUvFlags(&batteryData);
+        if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            return status;
+        }
+        setCheckpoint(HW_FAULT_OVUV_READ_STEP, status);
+    }
+
+    // Flags from every poll in a cycle are accumulated so a short crossing is not lost
+    // A retry that resumes past the read reuses the stored flags
+    bool flagPresent = false;
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        uint16_t overVoltageFlags = batteryData.cellMonitor[i].statusGroupD.cellOverVoltageFlags;
+        uint16_t underVoltageFlags = batteryData.cellMonitor[i].statusGroupD.cellUnderVoltageFlags;
+
+        taskData->bmb[i].cellOverVoltageFlags |= overVoltageFlags;
+        taskData->bmb[i].cellUnderVoltageFlags |= underVoltageFlags;
+
+        flagPresent |= ((overVoltageFlags | underVoltageFlags) != 0);
+    }
+
+    // The device latches OV/UV flags, only clear them once set so the next poll reflects new conversions
+    if(flagPresent && stepPending(HW_FAULT_OVUV_CLEAR_STEP))
+    {
+        status = clearCellOvUvFlags(&batteryData);
+        if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            return status;
+        }
+    }
+
+    if(stepPending(HW_FAULT_OVERCURRENT_READ_STEP))
+    {
+        status = readOvercurrentFaults(&batteryData);
+        if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            return status;
+        }
+        setCheckpoint(HW_FAULT_OVERCURRENT_READ_STEP, status);
+    }
+
+    bool overcurrent1Fault = batteryData.packMonitor.statusGroupC.overcurrent1Fault;
+    bool overcurrent2Fault = batteryData.packMonitor.statusGroupC.overcurrent2Fault;
+    bool overcurrent3Fault = batteryData.packMonitor.statusGroupC.overcurrent3Fault;
+
+    taskData->packMonitor.overcurrent1Fault |= overcurrent1Fault;
+    taskData->packMonitor.overcurrent2Fault |= overcurrent2Fault;
+    taskData->packMonitor.overcurrent3Fault |= overcurrent3Fault;
+
+    // Overcurrent faults are latched by the pack monitor as well
+    if((overcurrent1Fault || overcurrent2Fault || overcurrent3Fault) && stepPending(HW_FAULT_OVERCURRENT_CLEAR_STEP))
+    {
+        status = clearOvercurrentFaults(&batteryData);
+    }
+
+    return status;
+}
+
+static TRANSACTION_STATUS_E updateCommPassthrough(telemetryTaskData_S *taskData)
+{
+    return runCommPassthrough(&batteryData, COMM_PASSTHROUGH_BUDGET_US);
+}
+
+static TRANSACTION_STATUS_E releaseReadCycle(telemetryTaskData_S *taskData)
+{
+    TRANSACTION_STATUS_E status = TRANSACTION_SUCCESS;
+
+    // Every snapshot read is done, release the registers so pack current can be sampled until the next snapshot
+    if(stepPending(RELEASE_UNFREEZE_STEP))
+    {
+        status = unfreezeRegisters(&batteryData);
+    }
+
+    // Verify command counter after the unfreeze command
+    if(((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR)) && stepPending(RELEASE_VERIFY_STEP))
+    {
+        status = readSerialId(&batteryData);
+        setCheckpoint(RELEASE_VERIFY_STEP, status);
+    }
+
+    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        // Samples are scaled with the shunt resistance of the last temperature update
+        currentSampleShuntResistance = taskData->packMonitor.shuntResistanceMicroOhms;
+        nextCurrentSampleTimeUs = __HAL_TIM_GetCounter(&htim5);
+        currentSamplingEnabled = true;
+    }
+
+    return status;
+}
+
+static bool parkModeQualified(telemetryTaskData_S *taskData)
+{
+    bool currentFlow = (fabsf(taskData->packMonitor.packCurrent) > LPCM_PARK_CURRENT_THRES_A);
+
+    // Only park a healthy, idle chain
+    if(taskData->balancingEnabled || currentFlow || (batteryData.chainInfo.chainStatus != CHAIN_COMPLETE))
+    {
+        lastParkActivityTick = HAL_GetTick();
+        return false;
+    }
+
+    return ((HAL_GetTick() - lastParkActivityTick) >= LPCM_PARK_ENTRY_TIME_MS);
+}
+
+static TRANSACTION_STATUS_E enterParkMode(telemetryTaskData_S *taskData)
+{
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        // The last cell monitor in the chain generates the heartbeat, monitoring is handed to the chain
+        batteryData.cellMonitor[i].lpcmConfig.monitoringPeriod = LPCM_MONITORING_PERIOD;
+        batteryData.cellMonitor[i].lpcmConfig.manualHeartbeat = 0;
+        batteryData.cellMonitor[i].lpcmConfig.heartbeatDirection = 0;
+        batteryData.cellMonitor[i].lpcmConfig.bottomDevice = (i == (NUM_CELL_MON_IN_ACCUMULATOR - 1));
+        batteryData.cellMonitor[i].lpcmConfig.numDevices = NUM_CELL_MON_IN_ACCUMULATOR;
+        batteryData.cellMonitor[i].lpcmConfig.cellMonitorMask = LPCM_CELL_MONITOR_MASK;
+        batteryData.cellMonitor[i].lpcmConfig.gpioMonitorMask = LPCM_GPIO_MONITOR_MASK;
+
+        batteryData.cellMonitor[i].lpcmThreshold.cellUnderVoltage = MIN_BRICK_WARNING_VOLTAGE;
+        batteryData.cellMonitor[i].lpcmThreshold.cellOverVoltage = MAX_BRICK_WARNING_VOLTAGE;
+        batteryData.cellMonitor[i].lpcmThreshold.cellDeltaVoltage = LPCM_CELL_DELTA_THRES_V;
+        batteryData.cellMonitor[i].lpcmThreshold.gpioUnderVoltage = LPCM_GPIO_UNDERVOLTAGE_V;
+        batteryData.cellMonitor[i].lpcmThreshold.gpioOverVoltage = LPCM_GPIO_OVERVOLTAGE_V;
+        batteryData.cellMonitor[i].lpcmThreshold.gpioDeltaVoltage = LPCM_GPIO_DELTA_THRES_V;
+    }
+
+    // Release the read registers so pack current polls return live data
+    TRANSACTION_STATUS_E status = unfreezeRegisters(&batteryData);
+
+    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        status = writeLpcmConfig(&batteryData);
+    }
+
+    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        status = writeLpcmThresholds(&batteryData);
+    }
+
+    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        status = clearLpcmFlags(&batteryData);
+    }
+
+    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        status = enableLpcm(&batteryData);
+    }
+
+    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        Debug("Entering LPCM park mode\n");
+        taskData->lpcmParked = true;
+        currentSamplingEnabled = false;
+        lastParkPollTick = HAL_GetTick();
+    }
+
+    return status;
+}
+
+static TRANSACTION_STATUS_E runParkMode(telemetryTaskData_S *taskData)
+{
+    // Only the LPCM flags and pack current are polled at a slow rate while parked
+    if(!taskData->balancingEnabled && ((HAL_GetTick() - lastParkPollTick) < LPCM_FLAG_POLL_PERIOD_MS))
+    {
+        return TRANSACTION_SUCCESS;
+    }
+
+    wakeChain(&batteryData);
+
+    TRANSACTION_STATUS_E status = readLpcmFlags(&batteryData);
+
+    if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        status = readPackCurrent(&batteryData);
+    }
+
+    if((status != TRANSACTION_SUCCESS) && (status != TRANSACTION_CHAIN_BREAK_ERROR))
+    {
+        return status;
+    }
+
+    lastParkPollTick = HAL_GetTick();
+
+    // A lone current read is used straight from the back buffer, the next full read overwrites it before any flip
+    float currentUv = fuseCurrentChannels(batteryData.voltageData->packMonitor.currentAdc1uV, batteryData.voltageData->packMonitor.currentAdc2uV);
+    taskData->packMonitor.packCurrent = currentUv / (taskData->packMonitor.shuntResistanceMicroOhms);
+
+    bool flagPresent = false;
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        ADBMS_LpcmFlagsCellMonitor *flags = &batteryData.cellMonitor[i].lpcmFlags;
+        flagPresent |= (flags->cellUnderVoltage || flags->cellOverVoltage || flags->cellDelta || flags->gpioUnderVoltage || flags->gpioOverVoltage || flags->gpioDelta || flags->heartbeatFault);
+    }
+
+    bool currentFlow = (fabsf(taskData->packMonitor.packCurrent) > LPCM_PARK_CURRENT_THRES_A);
+
+    // Resume full telemetry on any flag, current flow, or a balancing request
+    if(flagPresent || currentFlow || taskData->balancingEnabled)
+    {
+        Debug("Exiting LPCM park mode\n");
+
+        status = disableLpcm(&batteryData);
+
+        if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            status = clearLpcmFlags(&batteryData);
+        }
+
+        if((status == TRANSACTION_SUCCESS) || (status == TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            taskData->lpcmParked = false;
+            lastParkActivityTick = HAL_GetTick();
+
+            // Reinitialize the chain to restart continuous conversions
+            taskData->chainInitialized = false;
+        }
+    }
+
+    return status;
+}
+
+static void updateRateGroupTiming(Rate_Group_Timing_S *timing, uint32_t elapsedTimeUs)
+{
+    if(elapsedTimeUs > timing->worstCaseTimeUs)
+    {
+        timing->worstCaseTimeUs = elapsedTimeUs;
+    }
+
+    // Running mean over every cycle the group was scheduled
+    timing->numRuns++;
+    timing->averageTimeUs += ((float)elapsedTimeUs - timing->averageTimeUs) / timing->numRuns;
+}
+
+static bool blockScheduled(uint32_t blockIndex, bool *rateGroupScheduled)
+{
+    // A deferred block is owed a run even in cycles its rate group is not scheduled
+    return (rateGroupScheduled[commandBlocks[blockIndex].rateGroup] || commandBlockState[blockIndex].deferred);
+}
+
+static bool deferOptionalBlock(uint32_t blockIndex, bool *rateGroupScheduled)
+{
+    // A block deferred too many cycles in a row runs regardless, so a persistently slow cycle cannot starve it
+    if(commandBlockState[blockIndex].consecutiveDeferrals >= MAX_CONSECUTIVE_DEFERRALS)
+    {
+        return false;
+    }
+
+    // The required blocks still to come this cycle are reserved first, so safety reads are never squeezed out
+    uint32_t reservedTimeUs = commandBlockState[blockIndex].costEstimateUs;
+    for(uint32_t i = blockIndex + 1; i < NUM_COMMAND_BLOCKS; i++)
+    {
+        if(!commandBlocks[i].optional && blockScheduled(i, rateGroupScheduled))
+        {
+            reservedTimeUs += commandBlockState[i].costEstimateUs;
+        }
+    }
+
+    uint32_t elapsedTimeUs = __HAL_TIM_GetCounter(&htim5) - cycleStartTimeUs;
+    return ((elapsedTimeUs + reservedTimeUs) > CYCLE_BUDGET_US);
+}
+
+static void updateBlockCost(Command_Block_State_S *blockState, uint32_t elapsedTimeUs)
+{
+    // Track increases immediately and let the estimate relax slowly, so one quiet cycle does not hide a slow block
+    if(elapsedTimeUs > blockState->costEstimateUs)
+    {
+        blockState->costEstimateUs = elapsedTimeUs;
+    }
+    else
+    {
+        blockState->costEstimateUs -= (blockState->costEstimateUs - elapsedTimeUs) >> BLOCK_COST_DECAY_SHIFT;
+    }
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+TRANSACTION_STATUS_E updateBatteryTelemetry(telemetryTaskData_S *taskData)
+{
+    TRANSACTION_STATUS_E telemetryStatus;
+
+    if(taskData->chainInitialized)
+    {
+        if(taskData->lpcmParked)
+        {
+            wakePredictionValid = false;
+            telemetryStatus = runCommandBlock(runParkMode, taskData, NULL);
+        }
+        else
+        {
+            uint32_t rateGroupTimeUs[NUM_RATE_GROUPS] = {0};
+
+            for(uint32_t i = 0; i < NUM_RATE_GROUPS; i++)
+            {
+                rateGroupScheduled[i] = ((rateGroupCycle % rateGroups[i].periodCycles) == rateGroups[i].phaseCycles);
+            }
+
+            // Hardware OV/UV and overcurrent flags are polled twice per cycle as a fast fault path
+            for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+            {
+                taskData->bmb[i].cellOverVoltageFlags = 0;
+                taskData->bmb[i].cellUnderVoltageFlags = 0;
+            }
+            taskData->packMonitor.overcurrent1Fault = false;
+            taskData->packMonitor.overcurrent2Fault = false;
+            taskData->packMonitor.overcurrent3Fault = false;
+
+            // Optional blocks are budgeted against the time since the cycle started
+            cycleStartTimeUs = __HAL_TIM_GetCounter(&htim5);
+            redundantCellsRead = false;
+
+            // Run the command blocks of every rate group scheduled this cycle, and any deferred blocks
+            telemetryStatus = TRANSACTION_SUCCESS;
+            for(uint32_t i = 0; i < NUM_COMMAND_BLOCKS; i++)
+            {
+                if((telemetryStatus != TRANSACTION_SUCCESS) && (telemetryStatus != TRANSACTION_CHAIN_BREAK_ERROR))
+                {
+                    break;
+                }
+
+                const Command_Block_S *block = &commandBlocks[i];
+                Command_Block_State_S *blockState = &commandBlockState[i];
+                if(!blockScheduled(i, rateGroupScheduled))
+                {
+                    continue;
+                }
+
+                if(block->optional && deferOptionalBlock(i, rateGroupScheduled))
+                {
+                    blockState->deferred = true;
+                    blockState->consecutiveDeferrals++;
+                    taskData->cycleBudget.numDeferredBlocks++;
+                    continue;
+                }
+
+                blockState->deferred = false;
+                blockState->consecutiveDeferrals = 0;
+
+                uint32_t startTime = __HAL_TIM_GetCounter(&htim5);
+                telemetryStatus = runCommandBlock(block->commandBlock, taskData, &taskData->commandBlockRetry[i]);
+                uint32_t blockTimeUs = __HAL_TIM_GetCounter(&htim5) - startTime;
+
+                updateBlockCost(blockState, blockTimeUs);
+                rateGroupTimeUs[block->rateGroup] += blockTimeUs;
+            }
+
+            // Record the cycle time against the task period, overruns push back every consumer of the data
+            uint32_t cycleTimeUs = __HAL_TIM_GetCounter(&htim5) - cycleStartTimeUs;
+            taskData->cycleBudget.lastCycleTimeUs = cycleTimeUs;
+            if(cycleTimeUs > taskData->cycleBudget.worstCycleTimeUs)
+            {
+                taskData->cycleBudget.worstCycleTimeUs = cycleTimeUs;
+            }
+            if(cycleTimeUs > CYCLE_PERIOD_US)
+            {
+                taskData->cycleBudget.numOverruns++;
+            }
+
+            // Only complete cycles are counted so aborted cycles do not skew the timing
+            if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                for(uint32_t i = 0; i < NUM_RATE_GROUPS; i++)
+                {
+                    if(rateGroupScheduled[i])
+                    {
+                        updateRateGroupTiming(&taskData->rateGroupTiming[i], rateGroupTimeUs[i]);
+                    }
+                }
+            }
+
+            rateGroupCycle++;
+
+            // Schedule the next cycle from the calibrated conversion phase at the rate the pack activity calls for
+            if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
+            {
+                updateTelemetryRate(taskData);
+                predictNextConversion(taskData);
+            }
+            else
+            {
+                wakePredictionValid = false;
+                currentSamplingEnabled = false;
+            }
+
+            // Hand monitoring over to the chain once the pack has been idle long enough
+            if(((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR)) && parkModeQualified(taskData))
+            {
+                telemetryStatus = runCommandBlock(enterParkMode, taskData, NULL);
+            }
+        }
+    }
+
+    if(!taskData->chainInitialized || (telemetryStatus == TRANSACTION_POR_ERROR))
+    {
+        Debug("Initializing chain...\n");
+
+        telemetryStatus = runCommandBlock(initChain, taskData, NULL);
+
+        if((telemetryStatus == TRANSACTION_SUCCESS) || (telemetryStatus == TRANSACTION_CHAIN_BREAK_ERROR))
+        {
+            Debug("Chain initialization successful!\n");
+            taskData->chainInitialized = true;
+        }
+        else
+        {
+            Debug("Chain failed to initialize!\n");
+            taskData->chainInitialized = false;
+        }
+    }
+
+    // Set chain status    
+
+    if(taskData->chainInfo.chainStatus == MULTIPLE_CHAIN_BREAK)
+    {
+        uint32_t numBmbsA;
+        uint32_t numBmbsB;
+        if(taskData->chainInfo.packMonitorPort == PORTA)
+        {
+            if(taskData->chainInfo.availableDevices[PORTA] >= 1)
+            {
+                taskData->packMonitorStatus = GOOD;
+            }
+            else
+            {
+                taskData->packMonitorStatus = BAD;
+            }
+
+            numBmbsA = taskData->chainInfo.availableDevices[PORTA] - 1;
+            numBmbsB = taskData->chainInfo.availableDevices[PORTB];
         }
         else if(taskData->chainInfo.packMonitorPort == PORTB)
         {
@@ -838,3 +2768,405 @@ TRANSACTION_STATUS_E updateBatteryTelemetry(telemetryTaskData_S *taskData)
 
     return telemetryStatus;
 }
+
+uint32_t getTelemetryWakeDelayMs()
+{
+    // 0 tells the caller to fall back to the fixed task period
+    if(!wakePredictionValid)
+    {
+        return 0;
+    }
+
+    int32_t remainingTimeUs = (int32_t)(nextWakeTimeUs - __HAL_TIM_GetCounter(&htim5));
+    if(remainingTimeUs <= 0)
+    {
+        return 1;
+    }
+
+    // Round up so the task never wakes before the window ends
+    uint32_t delayMs = ((uint32_t)remainingTimeUs + MICROSECONDS_IN_MILLISECOND - 1) / MICROSECONDS_IN_MILLISECOND;
+    if(delayMs > (MAX_WAKE_DELAY_MS << telemetryRateLevel))
+    {
+        delayMs = (MAX_WAKE_DELAY_MS << telemetryRateLevel);
+    }
+
+    return delayMs;
+}
+
+uint32_t sampleHighRateCurrent()
+{
+    if(!currentSamplingEnabled)
+    {
+        return 0;
+    }
+
+    uint32_t sampleTimeUs = __HAL_TIM_GetCounter(&htim5);
+    if((int32_t)(sampleTimeUs - nextCurrentSampleTimeUs) < 0)
+    {
+        return nextCurrentSampleTimeUs - sampleTimeUs;
+    }
+
+    // Keep the sample grid, but never queue up a burst of catch up samples after a long read cycle
+    nextCurrentSampleTimeUs += HIGH_RATE_CURRENT_PERIOD_US;
+    if((int32_t)(sampleTimeUs - nextCurrentSampleTimeUs) >= 0)
+    {
+        nextCurrentSampleTimeUs = sampleTimeUs + HIGH_RATE_CURRENT_PERIOD_US;
+    }
+
+    // Single device frames to the pack monitor, the cell monitors are not addressed
+    TRANSACTION_STATUS_E status = readPackCurrent(&batteryData);
+
+    if(status == TRANSACTION_SUCCESS)
+    {
+        status = readPackCurrentAccumulators(&batteryData);
+    }
+
+    // Leave any bus error to the next read cycle to correct
+    if(status != TRANSACTION_SUCCESS)
+    {
+        currentSamplingEnabled = false;
+        return 0;
+    }
+
+    Current_Sample_S *sample = &currentSampleBuffer[currentSampleWriteIndex % CURRENT_SAMPLE_BUFFER_SIZE];
+    sample->timeUs = getConversionEndTimeUs(&packMonitorPhase, sampleTimeUs, PHASE_COUNTS_PER_CONVERSION);
+    // Samples are taken from the back buffer between read cycles, the next full read overwrites them before any flip
+    float instantCurrentUv = fuseCurrentChannels(batteryData.voltageData->packMonitor.currentAdc1uV, batteryData.voltageData->packMonitor.currentAdc2uV);
+    float accumulatedCurrentUv = fuseCurrentChannels(batteryData.voltageData->packMonitor.currentAdcAccumulator1uV, batteryData.voltageData->packMonitor.currentAdcAccumulator2uV);
+    sample->instantCurrent = instantCurrentUv / currentSampleShuntResistance;
+    sample->accumulatedCurrent = (accumulatedCurrentUv / ACCUMULATION_REGISTER_COUNT) / currentSampleShuntResistance;
+
+    if(fabsf(sample->instantCurrent) > fabsf(peakSampleCurrent))
+    {
+        peakSampleCurrent = sample->instantCurrent;
+    }
+
+    // Current picking up while at a reduced rate brings the next cycle forward
+    if((telemetryRateLevel > 0) && (fabsf(sample->instantCurrent) > ACTIVITY_CURRENT_THRES_A))
+    {
+        telemetryRateLevel = 0;
+        restCycles = 0;
+        activityWakeRequested = true;
+    }
+
+    // Publish the sample only once it is completely written
+    __DMB();
+    currentSampleWriteIndex++;
+
+    // Link voltage is sampled in the same released window at its own rate
+    if(samplePrechargeVoltages(sampleTimeUs) != TRANSACTION_SUCCESS)
+    {
+        currentSamplingEnabled = false;
+        return 0;
+    }
+
+    // A sample that ran past the next grid point leaves the shortest wait
+    int32_t sampleDelayUs = (int32_t)(nextCurrentSampleTimeUs - __HAL_TIM_GetCounter(&htim5));
+    return (sampleDelayUs > 0) ? ((uint32_t)sampleDelayUs) : (1);
+}
+
+static TRANSACTION_STATUS_E samplePrechargeVoltages(uint32_t sampleTimeUs)
+{
+    if((int32_t)(sampleTimeUs - nextPrechargeSampleTimeUs) < 0)
+    {
+        return TRANSACTION_SUCCESS;
+    }
+
+    // Never restart the V ADC mid conversion, the aux cycle conversion of all channels would be lost
+    if((sampleTimeUs - packVoltageStartTimeUs) < PACK_VOLTAGE_CONVERSION_TIME_US)
+    {
+        return TRANSACTION_SUCCESS;
+    }
+
+    // The link readings come from the conversion started last
+    uint32_t linkSampleTimeUs = packVoltageStartTimeUs;
+
+    TRANSACTION_STATUS_E status = readPackLinkVoltages(&batteryData);
+
+    // Only the link channels are restarted so the other aux readings are left as converted
+    if(status == TRANSACTION_SUCCESS)
+    {
+        status = restartLinkVoltageConversions();
+    }
+
+    if(status != TRANSACTION_SUCCESS)
+    {
+        return status;
+    }
+
+    // Like the current samples these are used straight from the back buffers
+    float packVoltage = batteryData.voltageData->packMonitor.batteryVoltage1 * VBAT_DIVIDER_INV_GAIN;
+    float linkVoltage = LINK_DIVIDER_INV_GAIN * (batteryData.auxData->packMonitor.auxVoltage[LINK_PLUS_AUX_INDEX] - batteryData.auxData->packMonitor.auxVoltage[LINK_MINUS_AUX_INDEX]);
+    updatePrechargeState(packVoltage, linkVoltage, linkSampleTimeUs);
+
+    // Sample at the conversion rate only while precharge is in progress
+    uint32_t periodUs = (prechargeState == PRECHARGE_ACTIVE) ? (PACK_VOLTAGE_CONVERSION_TIME_US) : (PRECHARGE_IDLE_PERIOD_US);
+    nextPrechargeSampleTimeUs = sampleTimeUs + periodUs;
+
+    return status;
+}
+
+static TRANSACTION_STATUS_E restartLinkVoltageConversions(void)
+{
+    TRANSACTION_STATUS_E status = TRANSACTION_COMMAND_COUNTER_ERROR;
+
+    // The ADV is sent outside any command block, so there is no checkpoint to retry it from
+    // Every pack monitor read checks the command counter, a mismatch right after the ADV means it was lost
+    for(uint32_t attempt = 0; (attempt < LINK_CONVERSION_ATTEMPTS) && (status == TRANSACTION_COMMAND_COUNTER_ERROR); attempt++)
+    {
+        status = startPackVoltageConversions(&batteryData, PACK_V2_V4_V6, PACK_OPEN_WIRE_DISABLED);
+        packVoltageStartTimeUs = __HAL_TIM_GetCounter(&htim5);
+
+        // The counter mismatch resets both counters, so the ADV can be sent again straight away
+        if(status == TRANSACTION_SUCCESS)
+        {
+            status = readPackCurrent(&batteryData);
+        }
+    }
+
+    return status;
+}
+
+static void updatePrechargeState(float packVoltage, float linkVoltage, uint32_t timeUs)
+{
+    switch(prechargeState)
+    {
+        case PRECHARGE_IDLE:
+        case PRECHARGE_COMPLETE:
+            // Arm once the link has discharged well below a valid pack
+            if((packVoltage > PRECHARGE_MIN_PACK_VOLTAGE_V) && (linkVoltage < (PRECHARGE_ARM_RATIO * packVoltage)))
+            {
+                prechargeState = PRECHARGE_ARMED;
+                prechargeBaselineVoltage = linkVoltage;
+            }
+            break;
+
+        case PRECHARGE_ARMED:
+            if(packVoltage <= PRECHARGE_MIN_PACK_VOLTAGE_V)
+            {
+                prechargeState = PRECHARGE_IDLE;
+            }
+            else if(linkVoltage < prechargeBaselineVoltage)
+            {
+                // Follow the link as it bleeds down so the bleed is never taken for a precharge
+                prechargeBaselineVoltage = linkVoltage;
+            }
+            else if(linkVoltage > (prechargeBaselineVoltage + PRECHARGE_START_RISE_V))
+            {
+                prechargeState = PRECHARGE_ACTIVE;
+                prechargeStartTimeUs = timeUs;
+                memset(&prechargeFit, 0, sizeof(prechargeFit));
+                prechargeTimeConstantS = 0.0f;
+                prechargeTimeRemainingS = 0.0f;
+                updatePrechargeFit(packVoltage, linkVoltage, timeUs);
+            }
+            break;
+
+        case PRECHARGE_ACTIVE:
+            if(linkVoltage >= (PRECHARGE_COMPLETE_RATIO * packVoltage))
+            {
+                prechargeState = PRECHARGE_COMPLETE;
+                prechargeTimeRemainingS = 0.0f;
+
+                // Publish the complete event as soon as the threshold is crossed
+                prechargeCompleteTimeUs = timeUs;
+                __DMB();
+                prechargeCompleteCount++;
+            }
+            else if(((timeUs - prechargeStartTimeUs) > PRECHARGE_TIMEOUT_US) || (linkVoltage < prechargeBaselineVoltage))
+            {
+                // Precharge stalled or was opened again, wait for the next attempt
+                prechargeState = PRECHARGE_ARMED;
+                prechargeBaselineVoltage = linkVoltage;
+            }
+            else
+            {
+                updatePrechargeFit(packVoltage, linkVoltage, timeUs);
+            }
+            break;
+
+        default:
+            prechargeState = PRECHARGE_IDLE;
+            break;
+    }
+}
+
+static void updatePrechargeFit(float packVoltage, float linkVoltage, uint32_t timeUs)
+{
+    // Link headroom decays as exp(-t / RC), so its log is a line with slope -1 / RC
+    float headroomV = packVoltage - linkVoltage;
+    if(headroomV < (PRECHARGE_FIT_MIN_HEADROOM * packVoltage))
+    {
+        return;
+    }
+
+    float t = (float)(timeUs - prechargeStartTimeUs) / MICROSECONDS_IN_SECOND;
+    float y = logf(headroomV);
+
+    prechargeFit.numPoints++;
+    prechargeFit.sumT += t;
+    prechargeFit.sumY += y;
+    prechargeFit.sumTT += t * t;
+    prechargeFit.sumTY += t * y;
+
+    if(prechargeFit.numPoints < PRECHARGE_FIT_MIN_POINTS)
+    {
+        return;
+    }
+
+    float n = (float)prechargeFit.numPoints;
+    float denominator = (n * prechargeFit.sumTT) - (prechargeFit.sumT * prechargeFit.sumT);
+    if(denominator <= 0.0f)
+    {
+        return;
+    }
+
+    // Only a decaying headroom is a precharge
+    float slope = ((n * prechargeFit.sumTY) - (prechargeFit.sumT * prechargeFit.sumY)) / denominator;
+    if(slope >= 0.0f)
+    {
+        return;
+    }
+
+    // Time for the headroom to decay from now to the complete threshold
+    prechargeTimeConstantS = -1.0f / slope;
+    prechargeTimeRemainingS = fmaxf(prechargeTimeConstantS * logf(headroomV / ((1.0f - PRECHARGE_COMPLETE_RATIO) * packVoltage)), 0.0f);
+}
+
+uint32_t getTelemetryPeriodMs()
+{
+    return (TELEMETRY_TASK_PERIOD_MS << telemetryRateLevel);
+}
+
+bool telemetryWakeRequested()
+{
+    bool wakeRequested = activityWakeRequested;
+    activityWakeRequested = false;
+    return wakeRequested;
+}
+
+uint32_t getTelemetryDataAgeUs(telemetryTaskData_S *taskData)
+{
+    // Age as seen by the caller, dataAgeUs only covers the time up to the read back
+    return __HAL_TIM_GetCounter(&htim5) - taskData->packMonitor.currentSampleTimeUs;
+}
+
+uint32_t getPrechargeCompleteCount(uint32_t *completeTimeUs)
+{
+    uint32_t count = prechargeCompleteCount;
+    __DMB();
+    *completeTimeUs = prechargeCompleteTimeUs;
+    return count;
+}
+
+uint32_t getBatteryVoltageData(ADBMS_VoltageData *voltageData)
+{
+    uint32_t sequence;
+
+    // The telemetry task may flip and start refilling this buffer mid copy, so copy until no flip landed
+    do
+    {
+        sequence = voltageDataSequence;
+        __DMB();
+        *voltageData = *frontVoltageData;
+        __DMB();
+    } while(sequence != voltageDataSequence);
+
+    return sequence;
+}
+
+uint32_t getCurrentSamples(Current_Sample_S *samples, uint32_t maxSamples, uint32_t *readIndex)
+{
+    uint32_t startIndex = *readIndex;
+    uint32_t writeIndex = currentSampleWriteIndex;
+
+    // A reader that fell more than a buffer behind skips to the oldest sample still held
+    if((writeIndex - startIndex) > CURRENT_SAMPLE_BUFFER_SIZE)
+    {
+        startIndex = writeIndex - CURRENT_SAMPLE_BUFFER_SIZE;
+    }
+
+    uint32_t numSamples = writeIndex - startIndex;
+    if(numSamples > maxSamples)
+    {
+        numSamples = maxSamples;
+    }
+
+    for(uint32_t i = 0; i < numSamples; i++)
+    {
+        samples[i] = currentSampleBuffer[(startIndex + i) % CURRENT_SAMPLE_BUFFER_SIZE];
+    }
+
+    // The telemetry task may have preempted the copy and overwritten the oldest slots, drop those samples
+    __DMB();
+    uint32_t oldestValidIndex = currentSampleWriteIndex - CURRENT_SAMPLE_BUFFER_SIZE + 1;
+    uint32_t numOverwritten = 0;
+    if((int32_t)(oldestValidIndex - startIndex) > 0)
+    {
+        numOverwritten = oldestValidIndex - startIndex;
+        if(numOverwritten > numSamples)
+        {
+            numOverwritten = numSamples;
+        }
+        memmove(samples, &samples[numOverwritten], (numSamples - numOverwritten) * sizeof(Current_Sample_S));
+    }
+
+    *readIndex = startIndex + numSamples;
+    return numSamples - numOverwritten;
+}
+
+bool getCurrentAtTime(uint32_t timeUs, float *current)
+{
+    uint32_t writeIndex = currentSampleWriteIndex;
+
+    // The oldest slot may be overwritten by the next sample, so it is never used
+    uint32_t numSamples = (writeIndex < (CURRENT_SAMPLE_BUFFER_SIZE - 1)) ? writeIndex : (CURRENT_SAMPLE_BUFFER_SIZE - 1);
+
+    Current_Sample_S laterSample;
+    bool laterSampleValid = false;
+
+    // Walk back from the newest sample to the pair around the requested time
+    for(uint32_t i = 1; i <= numSamples; i++)
+    {
+        Current_Sample_S sample = currentSampleBuffer[(writeIndex - i) % CURRENT_SAMPLE_BUFFER_SIZE];
+
+        // Give up if the telemetry task lapped this read
+        if((currentSampleWriteIndex - (writeIndex - i)) >= CURRENT_SAMPLE_BUFFER_SIZE)
+        {
+            return false;
+        }
+
+        if((int32_t)(sample.timeUs - timeUs) > 0)
+        {
+            laterSample = sample;
+            laterSampleValid = true;
+            continue;
+        }
+
+        if(laterSampleValid)
+        {
+            // Linear interpolation between the samples either side of the requested time
+            float fraction = (float)(timeUs - sample.timeUs) / (float)(laterSample.timeUs - sample.timeUs);
+            *current = sample.instantCurrent + (fraction * (laterSample.instantCurrent - sample.instantCurrent));
+            return true;
+        }
+
+        // Requested time is newer than every sample, hold the newest one if it is close enough
+        if((timeUs - sample.timeUs) <= CURRENT_INTERPOLATION_MAX_GAP_US)
+        {
+            *current = sample.instantCurrent;
+            return true;
+        }
+
+        return false;
+    }
+
+    // Requested time is older than every sample, hold the oldest one if it is close enough
+    if(laterSampleValid && ((laterSample.timeUs - timeUs) <= CURRENT_INTERPOLATION_MAX_GAP_US))
+    {
+        *current = laterSample.instantCurrent;
+        return true;
+    }
+
+    return false;
+}
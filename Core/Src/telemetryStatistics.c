@@ -16,17 +16,26 @@
 /* =================== LOCAL FUNCTION DECLARATIONS ==================== */
 /* ==================================================================== */
 
-static void updateCellMonitorStatistics(Cell_Monitor_S *bmb);
+static void updateCellMonitorStatistics(telemetryTaskData_S *taskData);
 
 /* ==================================================================== */
 /* =================== LOCAL FUNCTION DEFINITIONS ===================== */
 /* ==================================================================== */
 
-void updateCellMonitorStatistics(Cell_Monitor_S *bmb)
+void updateCellMonitorStatistics(telemetryTaskData_S *taskData)
 {
+    Cell_Array_S* pCells = &taskData->cells;
+
     for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
     {
-        Cell_Monitor_S* pBmb = &bmb[i];
+        Cell_Monitor_S* pBmb = &taskData->bmb[i];
+
+        // Each BMB owns a contiguous slice of the chain wide cell arrays
+        const float* cellVoltage = &pCells->cellVoltage[CELL_INDEX(i, 0)];
+        const SENSOR_STATUS_E* cellVoltageStatus = &pCells->cellVoltageStatus[CELL_INDEX(i, 0)];
+        const float* cellTemp = &pCells->cellTemp[CELL_INDEX(i, 0)];
+        const SENSOR_STATUS_E* cellTempStatus = &pCells->cellTempStatus[CELL_INDEX(i, 0)];
+
         float maxCellVoltage = MIN_CELLV_SENSOR_VALUE;
         float minCellVoltage = MAX_CELLV_SENSOR_VALUE;
         float sumVoltage = 0.0f;
@@ -37,13 +46,13 @@ void updateCellMonitorStatistics(Cell_Monitor_S *bmb)
         float sumCellTemp = 0.0f;
         uint32_t numGoodCellTemp = 0;
 
-        // Aggregate Cell voltage and temperature data
+        // Aggregate Cell voltage data
         for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
         {
             // Only update stats if sense status is good
-            if(pBmb->cellVoltageStatus[j] == GOOD)
+            if(cellVoltageStatus[j] == GOOD)
             {
-                float cellV = pBmb->cellVoltage[j];
+                float cellV = cellVoltage[j];
 
                 if(cellV > maxCellVoltage)
                 {
@@ -56,22 +65,26 @@ void updateCellMonitorStatistics(Cell_Monitor_S *bmb)
                 numGoodCellVoltage++;
                 sumVoltage += cellV;
             }
+        }
 
+        // Aggregate Cell temperature data
+        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+        {
             // Only update stats if sense status is good
-            if(pBmb->cellTempStatus[j] == GOOD)
+            if(cellTempStatus[j] == GOOD)
             {
-                float cellTemp = pBmb->cellTemp[j];
+                float temp = cellTemp[j];
 
-                if (cellTemp > maxCellTemp)
+                if (temp > maxCellTemp)
                 {
-                    maxCellTemp = cellTemp;
+                    maxCellTemp = temp;
                 }
-                if (cellTemp < minCellTemp)
+                if (temp < minCellTemp)
                 {
-                    minCellTemp = cellTemp;
+                    minCellTemp = temp;
                 }
                 numGoodCellTemp++;
-                sumCellTemp += cellTemp;
+                sumCellTemp += temp;
             }
         }
 
@@ -83,16 +96,16 @@ void updateCellMonitorStatistics(Cell_Monitor_S *bmb)
             pBmb->minCellVoltage = minCellVoltage;
             pBmb->sumCellVoltage = sumVoltage;
             pBmb->avgCellVoltage = (sumVoltage / numGoodCellVoltage);
-            pBmb->numBadCellVoltage = NUM_CELLS_PER_CELL_MONITOR - numGoodCellVoltage;
         }
+        pBmb->numBadCellVoltage = NUM_CELLS_PER_CELL_MONITOR - numGoodCellVoltage;
 
-        if(numGoodCellVoltage > 0)
+        if(numGoodCellTemp > 0)
         {
             pBmb->maxCellTemp = maxCellTemp;
             pBmb->minCellTemp = minCellTemp;
             pBmb->avgCellTemp = (sumCellTemp / numGoodCellTemp);
-            pBmb->numBadCellTemp = NUM_CELLS_PER_CELL_MONITOR - numGoodCellTemp;
         }
+        pBmb->numBadCellTemp = NUM_CELLS_PER_CELL_MONITOR - numGoodCellTemp;
     }
 }
 
@@ -103,7 +116,7 @@ void updateCellMonitorStatistics(Cell_Monitor_S *bmb)
 void updateBatteryStatistics(telemetryTaskData_S *taskData)
 {
     // Update BMB level stats
-	updateCellMonitorStatistics(taskData->bmb);
+	updateCellMonitorStatistics(taskData);
 
 	float maxCellVoltage = MIN_CELLV_SENSOR_VALUE;
     float minCellVoltage = MAX_CELLV_SENSOR_VALUE;
@@ -124,7 +137,7 @@ void updateBatteryStatistics(telemetryTaskData_S *taskData)
     float maxDieTemp = MIN_TEMP_SENSOR_VALUE_C;
     float minDieTemp = 200.0f;
     float sumDieTemp = 0.0f;
-    uint32_t numGoodDieTemp;
+    uint32_t numGoodDieTemp = 0;
 
 	for(int32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
 	{
@@ -15,6 +15,7 @@
 #include "GopherCAN.h"
 #include "gopher_sense.h"
 #include "alerts.h"
+#include "burstCapture.h"
 
 /* ==================================================================== */
 /* ============================= DEFINES ============================== */
@@ -862,6 +863,12 @@ void runTelemetryTask()
     // Alert Monitor
     runTelemetryAlertMonitor(&telemetryTaskDataLocal);
 
+    // Record the cycle for burst capture once the alerts for it are known
+    if(telemetryTaskDataLocal.chainInitialized)
+    {
+        updateBurstCapture(&telemetryTaskDataLocal);
+    }
+
     // TODO Handle case of continous POR / CC errors here
 
     // Copy out new data into global data struct
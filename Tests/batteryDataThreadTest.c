@@ -0,0 +1,199 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+// The unit under test is included directly so its buffers can be checked from the reader thread
+#include "../Core/Src/telemetry.c"
+#include "chainModel.h"
+#include "testUtils.h"
+#include <pthread.h>
+#include <string.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+// Chain index of cell monitor n, the pack monitor sits on port A
+#define CELL_MON_DEVICE(n)  ((n) + 1)
+#define PACK_MON_DEVICE     0
+
+// Raw cell voltage read commands answered by the chain model, private to adbms.c
+#define RDCVA       0x0004
+#define RDCVB       0x0006
+#define RDCVC       0x0008
+#define RDCVD       0x000A
+#define RDCVE       0x0009
+#define RDCVF       0x000B
+
+#define NUM_CELLV_REGISTERS     6
+#define VOLTAGE_16BIT_PER_REG   3
+
+#define NUM_READ_CYCLES     50000
+#define CYCLE_CODE_RANGE    20000
+
+// Every few cycles the last register answers with a bad command counter, after the others were decoded
+#define FAILED_READ_ODDS    7
+
+/* ==================================================================== */
+/* ============================== STRUCTS ============================= */
+/* ==================================================================== */
+
+typedef struct
+{
+    uint32_t numCopies;
+    uint32_t numSequences;
+    uint32_t numTornCopies;
+    uint32_t numFailedReadsSeen;
+    uint32_t numSequenceReversals;
+} Reader_Result_S;
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+int numTestFailures = 0;
+
+static telemetryTaskData_S taskData;
+
+static const uint16_t rawCellRegisterCodes[NUM_CELLV_REGISTERS] =
+{
+    RDCVA, RDCVB, RDCVC, RDCVD, RDCVE, RDCVF
+};
+
+static volatile bool writerDone = false;
+static bool failNextRead = false;
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+static void failLastRegister(uint16_t command)
+{
+    if(failNextRead && (command == RDCVF))
+    {
+        chainModel.counterErrorReads = 1;
+    }
+}
+
+// Load one cell code into every cell of the chain and the same value in uV into the pack current result
+static void loadCycle(int16_t code)
+{
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        for(uint32_t j = 0; j < NUM_CELLV_REGISTERS; j++)
+        {
+            uint8_t *reg = chainModelGetRegister(CELL_MON_DEVICE(i), rawCellRegisterCodes[j]);
+            for(uint32_t k = 0; k < VOLTAGE_16BIT_PER_REG; k++)
+            {
+                reg[k * 2] = (uint8_t)code;
+                reg[(k * 2) + 1] = (uint8_t)((uint16_t)code >> 8);
+            }
+        }
+    }
+
+    uint8_t *reg = chainModelGetRegister(PACK_MON_DEVICE, RDCVA);
+    int32_t value = code;
+    reg[0] = (uint8_t)value;
+    reg[1] = (uint8_t)(value >> 8);
+    reg[2] = (uint8_t)(value >> 16);
+}
+
+// Good cycles load a positive code, failed ones a negative code that must never be published
+static void *runWriter(void *arg)
+{
+    (void)arg;
+
+    for(uint32_t cycle = 1; cycle <= NUM_READ_CYCLES; cycle++)
+    {
+        failNextRead = ((cycle % FAILED_READ_ODDS) == 0);
+        int16_t code = (int16_t)(cycle % CYCLE_CODE_RANGE);
+        loadCycle((failNextRead) ? (-code) : (code));
+
+        updatePrimaryPackTelemetry(&taskData);
+    }
+
+    writerDone = true;
+    return NULL;
+}
+
+static void *runReader(void *arg)
+{
+    Reader_Result_S *result = (Reader_Result_S*)arg;
+    ADBMS_VoltageData copy;
+    uint32_t lastSequence = 0;
+
+    while(!writerDone)
+    {
+        uint32_t sequence = getBatteryVoltageData(&copy);
+
+        // Nothing has been published before the first flip
+        if(sequence == 0)
+        {
+            continue;
+        }
+        result->numCopies++;
+
+        if(sequence < lastSequence)
+        {
+            result->numSequenceReversals++;
+        }
+        else if(sequence > lastSequence)
+        {
+            result->numSequences++;
+        }
+        lastSequence = sequence;
+
+        // Every result in a copy has to come from one read
+        int32_t code = lroundf((copy.cellMonitor[0].cellVoltage[0] - CELL_MON_CELL_ADC_OFFSET) / CELL_MON_CELL_ADC_GAIN);
+        bool torn = (copy.packMonitor.currentAdc1uV != code);
+        for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+        {
+            for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+            {
+                torn |= (copy.cellMonitor[i].cellVoltage[j] != copy.cellMonitor[0].cellVoltage[0]);
+            }
+        }
+
+        result->numTornCopies += (torn) ? (1) : (0);
+        result->numFailedReadsSeen += (code < 0) ? (1) : (0);
+    }
+
+    return NULL;
+}
+
+static void testConcurrentReaderSeesWholeReads()
+{
+    taskData.balancingEnabled = true;
+    taskData.packMonitor.shuntResistanceMicroOhms = 100.0f;
+    chainModelReset(NUM_DEVICES_IN_ACCUMULATOR, PORTA, batteryData.chainInfo.localCommandCounter);
+    chainModel.commandHook = failLastRegister;
+    CHECK(initChain(&taskData) == TRANSACTION_SUCCESS);
+
+    Reader_Result_S result = {0};
+    pthread_t writer;
+    pthread_t reader;
+    pthread_create(&reader, NULL, runReader, &result);
+    pthread_create(&writer, NULL, runWriter, NULL);
+    pthread_join(writer, NULL);
+    pthread_join(reader, NULL);
+
+    printf("%u copies across %u distinct reads\n", result.numCopies, result.numSequences);
+
+    // Only complete reads were flipped, and no copy mixed a published read with the one refilling it
+    CHECK(voltageDataSequence == (NUM_READ_CYCLES - (NUM_READ_CYCLES / FAILED_READ_ODDS)));
+    CHECK(result.numCopies > 0);
+    CHECK(result.numTornCopies == 0);
+    CHECK(result.numFailedReadsSeen == 0);
+    CHECK(result.numSequenceReversals == 0);
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+int main(void)
+{
+    RUN_TEST(testConcurrentReaderSeesWholeReads);
+
+    return (numTestFailures == 0) ? 0 : 1;
+}
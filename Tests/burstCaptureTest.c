@@ -0,0 +1,331 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+// The unit under test is included directly so its capture state can be reached
+#include "../Core/Src/burstCapture.c"
+#include "testUtils.h"
+#include <string.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+// Cell voltage of frame n, a whole number of compact counts so frames can be told apart after the drain
+#define FRAME_CELL_VOLTAGE(n)   (3.0f + ((n) * 10 * BURST_CELL_VOLTAGE_LSB_V))
+#define FRAME_CELL_COUNTS(n)    ((int16_t)lroundf(FRAME_CELL_VOLTAGE(n) / BURST_CELL_VOLTAGE_LSB_V))
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+int numTestFailures = 0;
+
+static telemetryTaskData_S taskData;
+static uint32_t numFramesRecorded = 0;
+
+// High rate samples handed to the capture on its next cycle, up to a full cycle at the slowest rate
+static Current_Sample_S queuedSamples[MAX_CURRENT_SAMPLES_PER_CYCLE];
+static uint32_t numQueuedSamples = 0;
+static uint32_t queuedSampleIndex = 0;
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+// Stands in for the telemetry sampler, handing out the queued samples a chunk at a time
+uint32_t getCurrentSamples(Current_Sample_S *samples, uint32_t maxSamples, uint32_t *readIndex)
+{
+    uint32_t numSamples = numQueuedSamples - queuedSampleIndex;
+    numSamples = (numSamples < maxSamples) ? (numSamples) : (maxSamples);
+    memcpy(samples, &queuedSamples[queuedSampleIndex], numSamples * sizeof(Current_Sample_S));
+    *readIndex += numSamples;
+    queuedSampleIndex += numSamples;
+    if(queuedSampleIndex == numQueuedSamples)
+    {
+        numQueuedSamples = 0;
+        queuedSampleIndex = 0;
+    }
+    return numSamples;
+}
+
+static void setAllAlerts(AlertStatus_E status)
+{
+    for(uint32_t i = 0; i < NUM_TELEMETRY_ALERTS; i++)
+    {
+        telemetryAlerts[i]->alertStatus = status;
+    }
+}
+
+static void resetBurstCapture()
+{
+    memset(&taskData, 0, sizeof(taskData));
+    memset(burstFrames, 0, sizeof(burstFrames));
+    numFramesWritten = 0;
+    firstValidFrame = 0;
+    burstState = BURST_CAPTURE_ARMED;
+    lastAlertMask = 0;
+    manualTriggerPending = false;
+    configPending = false;
+    numFramesRecorded = 0;
+    numQueuedSamples = 0;
+    queuedSampleIndex = 0;
+    setAllAlerts(ALERT_CLEARED);
+
+    Burst_Capture_Config_S config =
+    {
+        .triggerMask = BURST_ALL_TRIGGERS,
+        .preTriggerFrames = 3,
+        .postTriggerFrames = 2,
+        .overcurrentThresA = 100.0f,
+        .cellSagThresV = 0.1f
+    };
+    burstConfig = config;
+}
+
+// Record one telemetry cycle with every cell at the frame's voltage
+static void recordFrame()
+{
+    for(uint32_t i = 0; i < NUM_CELLS_IN_ACCUMULATOR; i++)
+    {
+        taskData.cells.cellVoltage[i] = FRAME_CELL_VOLTAGE(numFramesRecorded);
+    }
+    taskData.packMonitor.currentSampleTimeUs = numFramesRecorded * 1000;
+    numFramesRecorded++;
+
+    updateBurstCapture(&taskData);
+}
+
+static void testCaptureWindow()
+{
+    resetBurstCapture();
+
+    // Frames 0-4 are recorded armed, frame 5 triggers and frames 6-7 complete the window
+    for(uint32_t i = 0; i < 5; i++)
+    {
+        recordFrame();
+        CHECK(burstState == BURST_CAPTURE_ARMED);
+    }
+
+    triggerBurstCapture();
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_TRIGGERED);
+    CHECK(burstTrigger == BURST_TRIGGER_MANUAL);
+
+    Burst_Frame_S frame;
+    BURST_TRIGGER_E trigger;
+    int32_t frameIndex;
+    recordFrame();
+    CHECK(!drainBurstCapture(&frame, &trigger, &frameIndex));
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_FROZEN);
+
+    // Frames recorded while frozen never reach the window
+    recordFrame();
+    recordFrame();
+
+    // Three frames before the trigger, the trigger frame and two after, oldest first
+    for(int32_t i = -3; i <= 2; i++)
+    {
+        CHECK(drainBurstCapture(&frame, &trigger, &frameIndex));
+        CHECK(trigger == BURST_TRIGGER_MANUAL);
+        CHECK(frameIndex == i);
+        CHECK(frame.cellVoltage[0] == FRAME_CELL_COUNTS(5 + i));
+        CHECK(frame.cellVoltage[NUM_CELLS_IN_ACCUMULATOR - 1] == FRAME_CELL_COUNTS(5 + i));
+        CHECK(frame.timeUs == (uint32_t)((5 + i) * 1000));
+    }
+
+    // The last frame taken re-arms the ring empty
+    CHECK(burstState == BURST_CAPTURE_ARMED);
+    CHECK(!drainBurstCapture(&frame, &trigger, &frameIndex));
+
+    // A trigger right after re-arming keeps only the frames recorded since
+    recordFrame();
+    triggerBurstCapture();
+    recordFrame();
+    recordFrame();
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_FROZEN);
+    CHECK(drainBurstCapture(&frame, &trigger, &frameIndex));
+    CHECK(frameIndex == -1);
+    CHECK(frame.cellVoltage[0] == FRAME_CELL_COUNTS(10));
+}
+
+static void testAlertTriggersOnNewlySetAlert()
+{
+    resetBurstCapture();
+    burstConfig.triggerMask = (1 << BURST_TRIGGER_ALERT);
+
+    telemetryAlerts[0]->alertStatus = ALERT_SET;
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_TRIGGERED);
+    CHECK(burstTrigger == BURST_TRIGGER_ALERT);
+
+    recordFrame();
+    recordFrame();
+    Burst_Frame_S frame;
+    BURST_TRIGGER_E trigger;
+    int32_t frameIndex;
+    while(drainBurstCapture(&frame, &trigger, &frameIndex));
+
+    // An alert that stays set does not trigger again
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_ARMED);
+
+    // One alert clearing as another sets leaves the count unchanged, the new alert still triggers
+    telemetryAlerts[0]->alertStatus = ALERT_CLEARED;
+    telemetryAlerts[1]->alertStatus = ALERT_SET;
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_TRIGGERED);
+
+    recordFrame();
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_FROZEN);
+
+    // An alert that set while frozen is already known once the ring re-arms
+    telemetryAlerts[2]->alertStatus = ALERT_SET;
+    recordFrame();
+    while(drainBurstCapture(&frame, &trigger, &frameIndex));
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_ARMED);
+
+    setAllAlerts(ALERT_CLEARED);
+}
+
+static void testTriggerSources()
+{
+    resetBurstCapture();
+    Burst_Frame_S frame;
+    BURST_TRIGGER_E trigger;
+    int32_t frameIndex;
+
+    // A current sample between cycles over the threshold triggers, and is kept at the sampler rate
+    recordFrame();
+    queuedSamples[0].instantCurrent = 20.0f;
+    queuedSamples[1].instantCurrent = 150.0f;
+    queuedSamples[2].instantCurrent = 30.0f;
+    numQueuedSamples = 3;
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_TRIGGERED);
+    CHECK(burstTrigger == BURST_TRIGGER_OVERCURRENT);
+    recordFrame();
+    recordFrame();
+    while(drainBurstCapture(&frame, &trigger, &frameIndex) && (frameIndex != 0));
+    CHECK(frame.numCurrentSamples == 3);
+    CHECK(frame.packCurrent[1] == 1500);
+    while(drainBurstCapture(&frame, &trigger, &frameIndex));
+
+    // A cell dropping past the sag threshold between frames triggers
+    recordFrame();
+    taskData.cells.cellVoltage[7] = 2.5f;
+    updateBurstCapture(&taskData);
+    CHECK(burstState == BURST_CAPTURE_TRIGGERED);
+    CHECK(burstTrigger == BURST_TRIGGER_CELL_SAG);
+    recordFrame();
+    recordFrame();
+    while(drainBurstCapture(&frame, &trigger, &frameIndex));
+
+    // Masked triggers are ignored
+    burstConfig.triggerMask = (1 << BURST_TRIGGER_MANUAL);
+    taskData.packMonitor.overcurrent1Fault = true;
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_ARMED);
+}
+
+static void testSlowCycleCurrentDecimated()
+{
+    resetBurstCapture();
+    burstConfig.triggerMask = (1 << BURST_TRIGGER_MANUAL);
+
+    // A slowest rate cycle of samples with one short spike, more than a frame holds
+    for(uint32_t i = 0; i < MAX_CURRENT_SAMPLES_PER_CYCLE; i++)
+    {
+        queuedSamples[i].instantCurrent = 10.0f;
+    }
+    queuedSamples[77].instantCurrent = -90.0f;
+    numQueuedSamples = MAX_CURRENT_SAMPLES_PER_CYCLE;
+
+    triggerBurstCapture();
+    recordFrame();
+    recordFrame();
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_FROZEN);
+
+    Burst_Frame_S frame;
+    BURST_TRIGGER_E trigger;
+    int32_t frameIndex;
+    CHECK(drainBurstCapture(&frame, &trigger, &frameIndex));
+    CHECK(frameIndex == 0);
+
+    // Halved until the cycle fits, every sampler reading is covered and the spike survives in its bin
+    uint32_t decimation = frame.currentSampleDecimation;
+    CHECK(frame.numCurrentSamples <= BURST_CURRENT_SAMPLES_PER_FRAME);
+    CHECK((frame.numCurrentSamples * decimation) >= MAX_CURRENT_SAMPLES_PER_CYCLE);
+    CHECK(((frame.numCurrentSamples - 1) * decimation) < MAX_CURRENT_SAMPLES_PER_CYCLE);
+    for(uint32_t i = 0; i < frame.numCurrentSamples; i++)
+    {
+        CHECK(frame.packCurrent[i] == ((i == (77 / decimation)) ? (-900) : (100)));
+    }
+
+    // The next cycle without sampler readings falls back to the cycle current
+    CHECK(drainBurstCapture(&frame, &trigger, &frameIndex));
+    CHECK(frame.numCurrentSamples == 1);
+    CHECK(frame.currentSampleDecimation == 1);
+}
+
+static void testConfigurationAppliedBetweenCaptures()
+{
+    resetBurstCapture();
+    Burst_Frame_S frame;
+    BURST_TRIGGER_E trigger;
+    int32_t frameIndex;
+
+    // A window larger than the ring is refused
+    Burst_Capture_Config_S config = burstConfig;
+    config.preTriggerFrames = BURST_CAPTURE_NUM_FRAMES;
+    CHECK(!configureBurstCapture(&config));
+
+    // A configuration sent mid capture waits until the ring re-arms
+    triggerBurstCapture();
+    recordFrame();
+    config.preTriggerFrames = 1;
+    config.postTriggerFrames = 0;
+    CHECK(configureBurstCapture(&config));
+    recordFrame();
+    CHECK(burstConfig.postTriggerFrames == 2);
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_FROZEN);
+    recordFrame();
+    CHECK(burstConfig.postTriggerFrames == 2);
+    while(drainBurstCapture(&frame, &trigger, &frameIndex));
+
+    // The next armed cycle takes it, and the capture after it freezes on the trigger frame
+    recordFrame();
+    CHECK(burstConfig.postTriggerFrames == 0);
+    triggerBurstCapture();
+    recordFrame();
+    CHECK(burstState == BURST_CAPTURE_FROZEN);
+
+    uint32_t numDrained = 0;
+    while(drainBurstCapture(&frame, &trigger, &frameIndex))
+    {
+        numDrained++;
+    }
+    CHECK(numDrained == 2);
+    CHECK(frameIndex == 0);
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+int main(void)
+{
+    RUN_TEST(testCaptureWindow);
+    RUN_TEST(testAlertTriggersOnNewlySetAlert);
+    RUN_TEST(testTriggerSources);
+    RUN_TEST(testSlowCycleCurrentDecimated);
+    RUN_TEST(testConfigurationAppliedBetweenCaptures);
+
+    return (numTestFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+// The unit under test is included directly so its local functions can be exercised
+#include "../Core/Src/commPassthrough.c"
+#include "chainModel.h"
+#include "testUtils.h"
+#include <string.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+#define RDCOMM      0x0722
+#define STCOMM      0x0723
+
+// Chain index of cell monitor n, the pack monitor sits on port A
+#define CELL_MON_DEVICE(n)  ((n) + 1)
+
+#define COMM_TEST_BUDGET_US 10000
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+int numTestFailures = 0;
+
+static ADBMS_BatteryData batteryData;
+static uint32_t numTransfers;
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+// Encode one byte into slot 0 of a COMM register image
+static ADBMS_CommCellMonitor encodeByte(Comm_Transaction_S *transaction, uint32_t byteIndex)
+{
+    ADBMS_CommCellMonitor comm = { 0 };
+    encodeCommByte(transaction, byteIndex, &comm, 0);
+    return comm;
+}
+
+static void checkCommByte(Comm_Transaction_S *transaction, uint32_t byteIndex, uint8_t initialControl, uint8_t data, uint8_t finalControl)
+{
+    ADBMS_CommCellMonitor comm = encodeByte(transaction, byteIndex);
+    CHECK(comm.initialControl[0] == initialControl);
+    CHECK(comm.data[0] == data);
+    CHECK(comm.finalControl[0] == finalControl);
+}
+
+static void testI2cWrite()
+{
+    Comm_Transaction_S transaction = { .bus = COMM_BUS_I2C, .txData = { 0xA0, 0x10, 0x55 }, .numWriteBytes = 3, .numBytes = 3 };
+
+    checkCommByte(&transaction, 0, ICOM_I2C_START, 0xA0, FCOM_I2C_MASTER_NACK);
+    checkCommByte(&transaction, 1, ICOM_I2C_BLANK, 0x10, FCOM_I2C_MASTER_NACK);
+    checkCommByte(&transaction, 2, ICOM_I2C_BLANK, 0x55, FCOM_I2C_MASTER_NACK_STOP);
+}
+
+static void testI2cRegisterRead()
+{
+    // {addr W, reg, addr R, read, read} with a repeated START before the read address
+    Comm_Transaction_S transaction = { .bus = COMM_BUS_I2C, .txData = { 0xA0, 0x10, 0xA1 }, .numWriteBytes = 2, .numBytes = 5, .repeatedStartMask = (1 << 2) };
+
+    checkCommByte(&transaction, 0, ICOM_I2C_START, 0xA0, FCOM_I2C_MASTER_NACK);
+    checkCommByte(&transaction, 1, ICOM_I2C_BLANK, 0x10, FCOM_I2C_MASTER_NACK);
+    checkCommByte(&transaction, 2, ICOM_I2C_START, 0xA1, FCOM_I2C_MASTER_NACK);
+    checkCommByte(&transaction, 3, ICOM_I2C_BLANK, 0xFF, FCOM_I2C_MASTER_ACK);
+    checkCommByte(&transaction, 4, ICOM_I2C_BLANK, 0xFF, FCOM_I2C_MASTER_NACK_STOP);
+}
+
+static void testI2cReadBeforeRestart()
+{
+    // The last read byte ahead of a repeated START is not acknowledged by the master
+    Comm_Transaction_S transaction = { .bus = COMM_BUS_I2C, .txData = { 0xA1, 0xFF, 0xFF, 0xA1 }, .numWriteBytes = 1, .numBytes = 5, .repeatedStartMask = (1 << 3) };
+
+    checkCommByte(&transaction, 1, ICOM_I2C_BLANK, 0xFF, FCOM_I2C_MASTER_ACK);
+    checkCommByte(&transaction, 2, ICOM_I2C_BLANK, 0xFF, FCOM_I2C_MASTER_NACK);
+    checkCommByte(&transaction, 3, ICOM_I2C_START, 0xA1, FCOM_I2C_MASTER_NACK);
+    checkCommByte(&transaction, 4, ICOM_I2C_BLANK, 0xFF, FCOM_I2C_MASTER_NACK_STOP);
+}
+
+static void testSpiFraming()
+{
+    Comm_Transaction_S transaction = { .bus = COMM_BUS_SPI, .txData = { 0x9F, 0x00 }, .numWriteBytes = 2, .numBytes = 2 };
+
+    checkCommByte(&transaction, 0, ICOM_SPI_CSB_LOW, 0x9F, FCOM_SPI_CSB_LOW);
+    checkCommByte(&transaction, 1, ICOM_SPI_CSB_LOW, 0x00, FCOM_SPI_CSB_HIGH);
+}
+
+static void testQueueValidation()
+{
+    Comm_Transaction_S transaction = { .bus = COMM_BUS_I2C, .numWriteBytes = 2, .numBytes = 5, .repeatedStartMask = (1 << 2) };
+    CHECK(queueCommTransaction(0, &transaction));
+    CHECK(transaction.state == COMM_TRANSACTION_QUEUED);
+
+    // Repeated STARTs past the last byte or on an SPI transaction are rejected
+    Comm_Transaction_S outsideMask = { .bus = COMM_BUS_I2C, .numWriteBytes = 2, .numBytes = 5, .repeatedStartMask = (1 << 5) };
+    CHECK(!queueCommTransaction(0, &outsideMask));
+    Comm_Transaction_S spiMask = { .bus = COMM_BUS_SPI, .numWriteBytes = 2, .numBytes = 5, .repeatedStartMask = (1 << 2) };
+    CHECK(!queueCommTransaction(0, &spiMask));
+
+    // A full length transaction may restart on its last byte
+    Comm_Transaction_S fullLength = { .bus = COMM_BUS_I2C, .numWriteBytes = 1, .numBytes = COMM_MAX_TRANSACTION_BYTES, .repeatedStartMask = (1U << (COMM_MAX_TRANSACTION_BYTES - 1)) };
+    CHECK(queueCommTransaction(0, &fullLength));
+
+    Comm_Transaction_S empty = { .bus = COMM_BUS_I2C };
+    CHECK(!queueCommTransaction(0, &empty));
+    CHECK(!queueCommTransaction(NUM_CELL_MON_IN_ACCUMULATOR, &transaction));
+
+    // Reset fails everything still queued
+    resetCommPassthrough();
+    CHECK(transaction.state == COMM_TRANSACTION_FAILED);
+    CHECK(fullLength.state == COMM_TRANSACTION_FAILED);
+}
+
+static void resetChain()
+{
+    memset(&batteryData, 0, sizeof(batteryData));
+    batteryData.chainInfo.numDevs = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.packMonitorPort = PORTA;
+    batteryData.chainInfo.chainStatus = CHAIN_COMPLETE;
+    batteryData.chainInfo.availableDevices[PORTA] = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.availableDevices[PORTB] = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.currentPort = PORTA;
+
+    chainModelReset(NUM_DEVICES_IN_ACCUMULATOR, PORTA, batteryData.chainInfo.localCommandCounter);
+    resetCommPassthrough();
+    numTransfers = 0;
+}
+
+// The slave on cell monitor 2 drives the read slots of the second frame, the COMM model otherwise echoes what was written
+static void slaveResponse(uint16_t command)
+{
+    if(command != STCOMM)
+    {
+        return;
+    }
+
+    numTransfers++;
+    if(numTransfers == 2)
+    {
+        uint8_t *reg = chainModelGetRegister(CELL_MON_DEVICE(2), RDCOMM);
+        reg[0] = (reg[0] & 0xF0) | 0x1;
+        reg[1] = (reg[1] & 0x0F) | 0x20;
+        reg[2] = (reg[2] & 0xF0) | 0x3;
+        reg[3] = (reg[3] & 0x0F) | 0x40;
+    }
+}
+
+static void testChainTransfer()
+{
+    resetChain();
+    chainModel.commandHook = slaveResponse;
+
+    Comm_Transaction_S registerRead = { .bus = COMM_BUS_I2C, .txData = { 0xA0, 0x10, 0xA1 }, .numWriteBytes = 2, .numBytes = 5, .repeatedStartMask = (1 << 2) };
+    Comm_Transaction_S spiWrite = { .bus = COMM_BUS_SPI, .txData = { 0x06, 0x9A }, .numWriteBytes = 2, .numBytes = 2 };
+    CHECK(queueCommTransaction(2, &registerRead));
+    CHECK(queueCommTransaction(5, &spiWrite));
+
+    CHECK(runCommPassthrough(&batteryData, COMM_TEST_BUDGET_US) == TRANSACTION_SUCCESS);
+
+    // Both devices share the first frame, only the five byte read needs a second one
+    CHECK(chainModelCommandCount(STCOMM) == 2);
+    CHECK(registerRead.state == COMM_TRANSACTION_COMPLETE);
+    CHECK(spiWrite.state == COMM_TRANSACTION_COMPLETE);
+    CHECK(registerRead.rxData[3] == 0x12);
+    CHECK(registerRead.rxData[4] == 0x34);
+    CHECK(spiWrite.rxData[1] == 0x9A);
+
+    // Idle devices are sent no-transmit codes
+    uint8_t *idle = chainModelGetRegister(CELL_MON_DEVICE(0), RDCOMM);
+    CHECK((idle[0] >> 4) == ICOM_I2C_NO_TRANSMIT);
+}
+
+static void testFailedTransferNotResumed()
+{
+    resetChain();
+
+    Comm_Transaction_S registerRead = { .bus = COMM_BUS_I2C, .txData = { 0xA0, 0x10, 0xA1 }, .numWriteBytes = 2, .numBytes = 5, .repeatedStartMask = (1 << 2) };
+    CHECK(queueCommTransaction(2, &registerRead));
+
+    // A frame that never reaches the chain fails the transaction instead of replaying half an I2C sequence
+    chainModel.spiErrors = 100;
+    CHECK(runCommPassthrough(&batteryData, COMM_TEST_BUDGET_US) != TRANSACTION_SUCCESS);
+    chainModel.spiErrors = 0;
+    CHECK(registerRead.state == COMM_TRANSACTION_FAILED);
+
+    uint32_t transfers = chainModelCommandCount(STCOMM);
+    CHECK(runCommPassthrough(&batteryData, COMM_TEST_BUDGET_US) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(STCOMM) == transfers);
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+int main(void)
+{
+    RUN_TEST(testI2cWrite);
+    RUN_TEST(testI2cRegisterRead);
+    RUN_TEST(testI2cReadBeforeRestart);
+    RUN_TEST(testSpiFraming);
+    RUN_TEST(testQueueValidation);
+    RUN_TEST(testChainTransfer);
+    RUN_TEST(testFailedTransferNotResumed);
+
+    return (numTestFailures == 0) ? 0 : 1;
+}
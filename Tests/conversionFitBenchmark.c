@@ -0,0 +1,140 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+// The unit under test is included directly so its local functions can be timed
+#include "../Core/Src/telemetry.c"
+#include "testUtils.h"
+#include <time.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+#define ACCURACY_TRIALS     1000
+#define BENCHMARK_PASSES    20000
+#define BENCHMARK_TRIALS    5
+
+// Pack monitor clock a little off nominal, and the timestamp jitter seen on the bench
+#define TRUE_PHASE_TIME_US  255.3f
+#define CYCLE_JITTER_US     2000
+#define STAMP_DELAY_US      100
+
+// One read in fifty is stamped late by a preempting task or a retried transaction
+#define OUTLIER_ODDS        50
+#define OUTLIER_DELAY_US    3000
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+int numTestFailures = 0;
+
+static telemetryTaskData_S taskData;
+static uint32_t seed = 44;
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+static uint32_t nextRandom(uint32_t range)
+{
+    seed = (seed * 1103515245) + 12345;
+    return (seed >> 16) % range;
+}
+
+// Fill the whole counter buffer the way updateConversionStatus does, one quantized counter read per cycle
+static void fillConversionCounters(uint32_t baseTimeUs)
+{
+    float timeUs = 0.0f;
+    for(uint32_t i = 0; i < CONVERSION_BUFFER_SIZE; i++)
+    {
+        timeUs += (TELEMETRY_TASK_PERIOD_MS * MICROSECONDS_IN_MILLISECOND) + (float)nextRandom(2 * CYCLE_JITTER_US) - CYCLE_JITTER_US;
+
+        uint32_t stampDelayUs = nextRandom(STAMP_DELAY_US);
+        if(nextRandom(OUTLIER_ODDS) == 0)
+        {
+            stampDelayUs += OUTLIER_DELAY_US;
+        }
+
+        conversionCounterBuffer[COUNTER_INDEX][i] = 1000 + (uint32_t)(timeUs / TRUE_PHASE_TIME_US);
+        conversionCounterBuffer[TIMER_INDEX][i] = baseTimeUs + (uint32_t)timeUs + stampDelayUs;
+    }
+}
+
+static double elapsedNs(struct timespec *start, struct timespec *end)
+{
+    return ((end->tv_sec - start->tv_sec) * 1e9) + (end->tv_nsec - start->tv_nsec);
+}
+
+static void testFitAccuracy()
+{
+    double fitSquaredPpm = 0.0;
+    double twoPointSquaredPpm = 0.0;
+    uint32_t newestIndex = CONVERSION_BUFFER_SIZE - 1;
+
+    for(uint32_t trial = 0; trial < ACCURACY_TRIALS; trial++)
+    {
+        fillConversionCounters(nextRandom(UINT16_MAX) << 16);
+
+        // The two point difference the fit replaced, newest read against the oldest one
+        uint32_t deltaTimeUs = conversionCounterBuffer[TIMER_INDEX][newestIndex] - conversionCounterBuffer[TIMER_INDEX][0];
+        uint32_t deltaCounter = conversionCounterBuffer[COUNTER_INDEX][newestIndex] - conversionCounterBuffer[COUNTER_INDEX][0];
+        double twoPointPpm = ((((double)deltaTimeUs / deltaCounter) / TRUE_PHASE_TIME_US) - 1.0) * 1e6;
+
+        uint32_t fittedTimeUs = 0;
+        fitConversionPhase(&taskData, newestIndex, &fittedTimeUs);
+        double fitPhaseTimeUs = (taskData.packMonitor.adcConversionTimeMS * MICROSECONDS_IN_MILLISECOND) / PHASE_COUNTS_PER_CONVERSION;
+        double fitPpm = ((fitPhaseTimeUs / TRUE_PHASE_TIME_US) - 1.0) * 1e6;
+
+        fitSquaredPpm += fitPpm * fitPpm;
+        twoPointSquaredPpm += twoPointPpm * twoPointPpm;
+    }
+
+    double fitRmsPpm = sqrt(fitSquaredPpm / ACCURACY_TRIALS);
+    double twoPointRmsPpm = sqrt(twoPointSquaredPpm / ACCURACY_TRIALS);
+    printf("period error: fit %7.1f ppm rms, two point %7.1f ppm rms\n", fitRmsPpm, twoPointRmsPpm);
+
+    // The period scales every coulomb count, it has to beat the estimate it replaced by a clear margin
+    CHECK(fitRmsPpm < (twoPointRmsPpm / 2.0));
+    CHECK(fitRmsPpm < 200.0);
+}
+
+static void benchmarkFit()
+{
+    struct timespec start, end;
+    double fitNs = 1e9;
+    uint32_t newestIndex = CONVERSION_BUFFER_SIZE - 1;
+
+    fillConversionCounters(0);
+
+    // Keep the fastest of several trials so scheduler noise on the host does not swamp the result
+    for(uint32_t trial = 0; trial < BENCHMARK_TRIALS; trial++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(uint32_t i = 0; i < BENCHMARK_PASSES; i++)
+        {
+            uint32_t fittedTimeUs;
+            fitConversionPhase(&taskData, newestIndex, &fittedTimeUs);
+            __asm__ volatile("" : : "r"(&taskData), "r"(&fittedTimeUs) : "memory");
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double ns = elapsedNs(&start, &end) / BENCHMARK_PASSES;
+        fitNs = (ns < fitNs) ? (ns) : (fitNs);
+    }
+
+    // One sweep marks the filled slots, each pass sweeps for sums, centered moments and residuals, the first also rejects outliers
+    printf("fit: %8.1f ns/call on the host, %u points, 8 buffer sweeps\n", fitNs, CONVERSION_BUFFER_SIZE);
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+int main(void)
+{
+    RUN_TEST(testFitAccuracy);
+    benchmarkFit();
+
+    return (numTestFailures == 0) ? 0 : 1;
+}
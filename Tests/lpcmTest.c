@@ -0,0 +1,187 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+#include "adbms/adbms.h"
+#include "telemetryTask.h"
+#include "chainModel.h"
+#include "testUtils.h"
+#include <string.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+#define RDCMCFG     0x0059
+#define RDCMCELLT   0x005B
+#define RDCMGPIOT   0x005D
+#define RDCMFLAG    0x005F
+
+// Chain index of cell monitor n, the pack monitor sits on port A
+#define CELL_MON_DEVICE(n)  ((n) + 1)
+#define PACK_MON_DEVICE     0
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+int numTestFailures = 0;
+
+static ADBMS_BatteryData batteryData;
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+static void resetChain()
+{
+    memset(&batteryData, 0, sizeof(batteryData));
+    batteryData.chainInfo.numDevs = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.packMonitorPort = PORTA;
+    batteryData.chainInfo.chainStatus = CHAIN_COMPLETE;
+    batteryData.chainInfo.availableDevices[PORTA] = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.availableDevices[PORTB] = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.currentPort = PORTA;
+
+    chainModelReset(NUM_DEVICES_IN_ACCUMULATOR, PORTA, batteryData.chainInfo.localCommandCounter);
+}
+
+static void setThresholds(float underVoltage, float overVoltage, float deltaVoltage)
+{
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        ADBMS_LpcmThresholdCellMonitor *threshold = &batteryData.cellMonitor[i].lpcmThreshold;
+        threshold->cellUnderVoltage = underVoltage;
+        threshold->cellOverVoltage = overVoltage;
+        threshold->cellDeltaVoltage = deltaVoltage;
+        threshold->gpioUnderVoltage = 0.5f;
+        threshold->gpioOverVoltage = 2.7f;
+        threshold->gpioDeltaVoltage = 0.2f;
+    }
+}
+
+// Threshold register image, 12 bit under voltage and over voltage codes packed from bit 0, 12 bit delta code in bytes 3-4
+static bool registerMatches(uint32_t device, uint16_t command, uint16_t underCode, uint16_t overCode, uint16_t deltaCode)
+{
+    uint8_t *reg = chainModelGetRegister(device, command);
+    uint32_t thresholds = (uint32_t)underCode | ((uint32_t)overCode << 12);
+
+    return (reg[0] == (uint8_t)thresholds) &&
+           (reg[1] == (uint8_t)(thresholds >> 8)) &&
+           (reg[2] == (uint8_t)(thresholds >> 16)) &&
+           (reg[3] == (uint8_t)deltaCode) &&
+           (reg[4] == (uint8_t)(deltaCode >> 8)) &&
+           (reg[5] == 0);
+}
+
+static void testThresholdEncoding()
+{
+    resetChain();
+
+    // 2.4 mV per code with a 1.5 V offset, delta has no offset
+    setThresholds(2.5f, 4.2f, 0.1f);
+    CHECK(writeLpcmThresholds(&batteryData) == TRANSACTION_SUCCESS);
+
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        CHECK(registerMatches(CELL_MON_DEVICE(i), RDCMCELLT, 0x1A1, 0x465, 0x02A));
+        CHECK(registerMatches(CELL_MON_DEVICE(i), RDCMGPIOT, 0xE5F, 0x1F4, 0x053));
+    }
+
+    // The pack monitor has no LPCM registers and gets an empty frame
+    uint8_t empty[REGISTER_SIZE_BYTES] = {0};
+    CHECK(memcmp(chainModelGetRegister(PACK_MON_DEVICE, RDCMCELLT), empty, REGISTER_SIZE_BYTES) == 0);
+}
+
+static void testThresholdClamping()
+{
+    resetChain();
+
+    // Out of range thresholds saturate at the ends of the signed 12 bit range instead of wrapping
+    setThresholds(-5.0f, 10.0f, 20.0f);
+    writeLpcmThresholds(&batteryData);
+    CHECK(registerMatches(CELL_MON_DEVICE(0), RDCMCELLT, 0x800, 0x7FF, 0xFFF));
+
+    // A negative delta disables the delta check rather than wrapping to the maximum
+    setThresholds(2.5f, 4.2f, -1.0f);
+    writeLpcmThresholds(&batteryData);
+    CHECK(registerMatches(CELL_MON_DEVICE(0), RDCMCELLT, 0x1A1, 0x465, 0x000));
+}
+
+static void testConfigEncoding()
+{
+    resetChain();
+
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        ADBMS_LpcmConfigCellMonitor *config = &batteryData.cellMonitor[i].lpcmConfig;
+        config->monitoringPeriod = LPCM_PERIOD_8_S;
+        config->manualHeartbeat = 1;
+        config->heartbeatDirection = 0;
+        config->bottomDevice = (i == (NUM_CELL_MON_IN_ACCUMULATOR - 1)) ? (1) : (0);
+        config->numDevices = NUM_CELL_MON_IN_ACCUMULATOR;
+        config->cellMonitorMask = 0xFFFF >> i;
+        config->gpioMonitorMask = 0x3FF;
+    }
+
+    CHECK(sizeof(ADBMS_LpcmConfigCellMonitor) == REGISTER_SIZE_BYTES);
+    CHECK(writeLpcmConfig(&batteryData) == TRANSACTION_SUCCESS);
+
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        uint8_t *reg = chainModelGetRegister(CELL_MON_DEVICE(i), RDCMCFG);
+        uint8_t bottomDevice = (i == (NUM_CELL_MON_IN_ACCUMULATOR - 1)) ? (0x20) : (0x00);
+        uint16_t cellMask = 0xFFFF >> i;
+
+        // Period in bits 0-2, manual heartbeat bit 3, direction bit 4, bottom device bit 5
+        CHECK(reg[0] == (0x03 | 0x08 | bottomDevice));
+        CHECK(reg[1] == NUM_CELL_MON_IN_ACCUMULATOR);
+        CHECK(reg[2] == (uint8_t)cellMask);
+        CHECK(reg[3] == (uint8_t)(cellMask >> 8));
+        CHECK(reg[4] == 0xFF);
+        CHECK(reg[5] == 0x03);
+    }
+}
+
+static void testFlagDecoding()
+{
+    resetChain();
+
+    // Cell over voltage and heartbeat fault on one monitor, GPIO delta on another
+    chainModelGetRegister(CELL_MON_DEVICE(3), RDCMFLAG)[0] = 0x42;
+    chainModelGetRegister(CELL_MON_DEVICE(6), RDCMFLAG)[0] = 0x20;
+
+    CHECK(readLpcmFlags(&batteryData) == TRANSACTION_SUCCESS);
+
+    ADBMS_LpcmFlagsCellMonitor *flags = &batteryData.cellMonitor[3].lpcmFlags;
+    CHECK(!flags->cellUnderVoltage);
+    CHECK(flags->cellOverVoltage);
+    CHECK(!flags->cellDelta);
+    CHECK(flags->heartbeatFault);
+    CHECK(batteryData.cellMonitor[6].lpcmFlags.gpioDelta);
+    CHECK(!batteryData.cellMonitor[6].lpcmFlags.heartbeatFault);
+
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        if((i != 3) && (i != 6))
+        {
+            uint8_t raw;
+            memcpy(&raw, &batteryData.cellMonitor[i].lpcmFlags, sizeof(raw));
+            CHECK(raw == 0);
+        }
+    }
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+int main(void)
+{
+    RUN_TEST(testThresholdEncoding);
+    RUN_TEST(testThresholdClamping);
+    RUN_TEST(testConfigEncoding);
+    RUN_TEST(testFlagDecoding);
+
+    return (numTestFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,312 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+#include "adbms/adbms.h"
+#include "telemetryTask.h"
+#include "chainModel.h"
+#include "testUtils.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+#define RDSTATA     0x0030
+#define RDSTATB     0x0031
+#define RDSTATC     0x0032
+#define RDSTATD     0x0033
+#define RDSTATE     0x0034
+
+// Chain index of cell monitor n, the pack monitor sits on port A
+#define CELL_MON_DEVICE(n)  ((n) + 1)
+#define PACK_MON_DEVICE     0
+
+#define TRACE_CYCLES        1000
+#define BENCHMARK_TRIALS    5
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+int numTestFailures = 0;
+
+static ADBMS_BatteryData batteryData;
+
+static const uint16_t statusCommands[NUM_STATUS_GROUPS] =
+{
+    RDSTATA, RDSTATB, RDSTATC, RDSTATD, RDSTATE
+};
+
+static TRANSACTION_STATUS_E (*const readStatus[NUM_STATUS_GROUPS])(ADBMS_BatteryData *adbmsData) =
+{
+    readStatusA, readStatusB, readStatusC, readStatusD, readStatusE
+};
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+static void resetChain()
+{
+    memset(&batteryData, 0, sizeof(batteryData));
+    batteryData.chainInfo.numDevs = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.packMonitorPort = PORTA;
+    batteryData.chainInfo.chainStatus = CHAIN_COMPLETE;
+    batteryData.chainInfo.availableDevices[PORTA] = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.availableDevices[PORTB] = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.currentPort = PORTA;
+
+    chainModelReset(NUM_DEVICES_IN_ACCUMULATOR, PORTA, batteryData.chainInfo.localCommandCounter);
+    invalidateStatusMirror(&batteryData);
+}
+
+static void setWord(uint32_t device, uint16_t command, uint32_t byte, uint16_t value)
+{
+    uint8_t *reg = chainModelGetRegister(device, command);
+    reg[byte] = (uint8_t)value;
+    reg[byte + 1] = (uint8_t)(value >> 8);
+}
+
+static uint32_t countBits(uint32_t mask)
+{
+    return (uint32_t)__builtin_popcount(mask);
+}
+
+static void testFirstReadDecodesEverything()
+{
+    resetChain();
+
+    CHECK(readStatusA(&batteryData) == TRANSACTION_SUCCESS);
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_A] == (STATUS_CHANGED_PACK_MONITOR | 0xFF));
+}
+
+static void testUnchangedFramesSkipDecode()
+{
+    resetChain();
+    setWord(CELL_MON_DEVICE(3), RDSTATA, 0, 0x1234);
+    readStatusA(&batteryData);
+    float dieTemp = batteryData.cellMonitor[3].statusGroupA.dieTemp;
+
+    // Same bytes again, nothing is decoded
+    CHECK(readStatusA(&batteryData) == TRANSACTION_SUCCESS);
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_A] == 0);
+
+    // One device changes, only its bit is set
+    setWord(CELL_MON_DEVICE(5), RDSTATA, 2, 0x4000);
+    readStatusA(&batteryData);
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_A] == (1UL << 5));
+    CHECK(batteryData.cellMonitor[5].statusGroupA.dieTemp != dieTemp);
+}
+
+static void testCountersAlwaysDecoded()
+{
+    resetChain();
+    readStatusC(&batteryData);
+    readStatusD(&batteryData);
+
+    // Conversion and oscillator counters move every read but do not count as a change
+    setWord(CELL_MON_DEVICE(0), RDSTATC, 2, 0x3412);
+    chainModelGetRegister(CELL_MON_DEVICE(0), RDSTATD)[5] = 0x7F;
+    readStatusC(&batteryData);
+    readStatusD(&batteryData);
+
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_C] == 0);
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_D] == 0);
+    CHECK(batteryData.cellMonitor[0].statusGroupC.conversionCounter == 0x1234);
+    CHECK(batteryData.cellMonitor[0].statusGroupD.oscillatorCounter == 0x7F);
+
+    // A fault flag in the same group is decoded
+    chainModelGetRegister(CELL_MON_DEVICE(0), RDSTATD)[0] = 0x02;
+    readStatusD(&batteryData);
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_D] == 0x01);
+    CHECK(batteryData.cellMonitor[0].statusGroupD.cellOverVoltageFlags == 0x0001);
+}
+
+static void testFailedReadKeepsMirror()
+{
+    resetChain();
+    setWord(CELL_MON_DEVICE(2), RDSTATA, 0, 0x2345);
+    readStatusA(&batteryData);
+    float referenceVoltage = batteryData.cellMonitor[2].statusGroupA.referenceVoltage;
+
+    // A failed read hands back a zeroed buffer, which must not be decoded or mirrored
+    chainModel.spiErrors = 1;
+    CHECK(readStatusA(&batteryData) == TRANSACTION_SPI_ERROR);
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_A] == 0);
+    CHECK_FLOAT(batteryData.cellMonitor[2].statusGroupA.referenceVoltage, referenceVoltage, 0.0f);
+
+    // The next good read still matches the mirror
+    CHECK(readStatusA(&batteryData) == TRANSACTION_SUCCESS);
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_A] == 0);
+}
+
+static void testUnreachedDevicesNotMirrored()
+{
+    resetChain();
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        setWord(CELL_MON_DEVICE(i), RDSTATA, 0, 0x1000 + i);
+    }
+    readStatusA(&batteryData);
+
+    // Two breaks leave cell monitors 2 to 5 unreachable from either port
+    chainModel.reachableDevices[PORTA] = 3;
+    chainModel.reachableDevices[PORTB] = 2;
+    batteryData.chainInfo.chainStatus = MULTIPLE_CHAIN_BREAK;
+    batteryData.chainInfo.availableDevices[PORTA] = 3;
+    batteryData.chainInfo.availableDevices[PORTB] = 2;
+
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        setWord(CELL_MON_DEVICE(i), RDSTATA, 0, 0x2000 + i);
+    }
+    float unreachedVoltage = batteryData.cellMonitor[3].statusGroupA.referenceVoltage;
+
+    CHECK(readStatusA(&batteryData) == TRANSACTION_CHAIN_BREAK_ERROR);
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_A] == ((1UL << 0) | (1UL << 1) | (1UL << 6) | (1UL << 7)));
+    CHECK_FLOAT(batteryData.cellMonitor[3].statusGroupA.referenceVoltage, unreachedVoltage, 0.0f);
+
+    // Once reachable again the unreached devices decode their new value
+    chainModel.reachableDevices[PORTA] = NUM_DEVICES_IN_ACCUMULATOR;
+    chainModel.reachableDevices[PORTB] = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.chainStatus = CHAIN_COMPLETE;
+    batteryData.chainInfo.availableDevices[PORTA] = NUM_DEVICES_IN_ACCUMULATOR;
+    batteryData.chainInfo.availableDevices[PORTB] = NUM_DEVICES_IN_ACCUMULATOR;
+
+    readStatusA(&batteryData);
+    CHECK(batteryData.statusGroupChanged[STATUS_GROUP_A] == ((1UL << 2) | (1UL << 3) | (1UL << 4) | (1UL << 5)));
+}
+
+// Advance the modelled status registers by one telemetry cycle
+static void stepStatusTraffic(uint32_t cycle)
+{
+    for(uint32_t device = 0; device < NUM_DEVICES_IN_ACCUMULATOR; device++)
+    {
+        // Analog status words sit on a code and dither by one LSB about a quarter of the time
+        for(uint32_t group = STATUS_GROUP_A; group <= STATUS_GROUP_B; group++)
+        {
+            for(uint32_t word = 0; word < 3; word++)
+            {
+                uint16_t code = (uint16_t)(0x4000 + (device * 64) + (word * 16) + (group * 4));
+                setWord(device, statusCommands[group], word * 2, code + (uint16_t)((rand() % 4) == 0));
+            }
+        }
+
+        // Conversion and oscillator counters run, the fault flags stay clear
+        setWord(device, RDSTATC, 2, (uint16_t)cycle);
+        chainModelGetRegister(device, RDSTATD)[5] = (uint8_t)cycle;
+        chainModelGetRegister(device, RDSTATE)[4] = 0x01;
+    }
+}
+
+static void readAllStatus(bool forceDecode, uint32_t *numDecoded)
+{
+    if(forceDecode)
+    {
+        // Without the mirror every frame was decoded on every read
+        invalidateStatusMirror(&batteryData);
+    }
+
+    for(uint32_t group = 0; group < NUM_STATUS_GROUPS; group++)
+    {
+        readStatus[group](&batteryData);
+        if(numDecoded)
+        {
+            *numDecoded += countBits(batteryData.statusGroupChanged[group]);
+        }
+    }
+}
+
+static double elapsedNs(struct timespec *start, struct timespec *end)
+{
+    return ((end->tv_sec - start->tv_sec) * 1e9) + (end->tv_nsec - start->tv_nsec);
+}
+
+static double timeReplay(bool forceDecode)
+{
+    struct timespec start, end;
+    double bestNs = 1e12;
+
+    for(uint32_t trial = 0; trial < BENCHMARK_TRIALS; trial++)
+    {
+        chainModel.tracePosition = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(uint32_t cycle = 0; cycle < TRACE_CYCLES; cycle++)
+        {
+            readAllStatus(forceDecode, NULL);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        double ns = elapsedNs(&start, &end) / TRACE_CYCLES;
+        bestNs = (ns < bestNs) ? (ns) : (bestNs);
+    }
+
+    return bestNs;
+}
+
+static void benchmarkRecordedTraffic()
+{
+    static uint8_t trace[TRACE_CYCLES * NUM_STATUS_GROUPS * MAX_SPI_BUFFER];
+
+    resetChain();
+    srand(27);
+
+    // Record the status traffic once, then replay the same bytes with and without the mirror
+    chainModel.trace = trace;
+    chainModel.traceSize = sizeof(trace);
+    for(uint32_t cycle = 0; cycle < TRACE_CYCLES; cycle++)
+    {
+        stepStatusTraffic(cycle);
+        readAllStatus(false, NULL);
+    }
+    uint32_t recordedBytes = chainModel.tracePosition;
+    chainModel.traceSize = recordedBytes;
+    chainModel.replayTrace = true;
+
+    uint32_t decodedMirror = 0;
+    uint32_t decodedFull = 0;
+    chainModel.tracePosition = 0;
+    invalidateStatusMirror(&batteryData);
+    for(uint32_t cycle = 0; cycle < TRACE_CYCLES; cycle++)
+    {
+        readAllStatus(false, &decodedMirror);
+    }
+    chainModel.tracePosition = 0;
+    for(uint32_t cycle = 0; cycle < TRACE_CYCLES; cycle++)
+    {
+        readAllStatus(true, &decodedFull);
+    }
+
+    // Mirror must skip at least the static groups C, D and E
+    CHECK(decodedMirror < decodedFull);
+
+    double mirrorNs = timeReplay(false);
+    double fullNs = timeReplay(true);
+
+    printf("recorded %u cycles, %u bytes of status traffic\n", TRACE_CYCLES, recordedBytes);
+    printf("full decode:   %6u frames decoded, %8.1f ns/cycle\n", decodedFull, fullNs);
+    printf("status mirror: %6u frames decoded, %8.1f ns/cycle (%.0f%% of frames skipped)\n",
+           decodedMirror, mirrorNs, 100.0 * (decodedFull - decodedMirror) / decodedFull);
+
+    chainModel.trace = NULL;
+    chainModel.replayTrace = false;
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+int main(void)
+{
+    RUN_TEST(testFirstReadDecodesEverything);
+    RUN_TEST(testUnchangedFramesSkipDecode);
+    RUN_TEST(testCountersAlwaysDecoded);
+    RUN_TEST(testFailedReadKeepsMirror);
+    RUN_TEST(testUnreachedDevicesNotMirrored);
+    RUN_TEST(benchmarkRecordedTraffic);
+
+    return (numTestFailures == 0) ? 0 : 1;
+}
@@ -0,0 +1,346 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+#include "chainModel.h"
+#include "stm32f4xx_hal.h"
+#include "main.h"
+#include "utils.h"
+#include <string.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+#define COMMAND_PACKET_LENGTH   4
+#define REGISTER_PACKET_LENGTH  (REGISTER_SIZE_BYTES + 2)
+
+#define CRC_DATA_SEED           0x0010
+#define CRC_DATA_POLY           0x008F
+#define CRC_DATA_MASK           0x03FF
+#define COMMAND_COUNTER_BITS    6
+
+#define MAX_LOGGED_COMMANDS     128
+
+#define RSTCC                   0x002E
+
+/* ==================================================================== */
+/* ============================== STRUCTS ============================= */
+/* ==================================================================== */
+
+typedef struct
+{
+    uint16_t command;
+    uint8_t data[CHAIN_MODEL_MAX_DEVICES][REGISTER_SIZE_BYTES];
+} Model_Register_S;
+
+typedef struct
+{
+    uint16_t command;
+    uint32_t count;
+} Model_Command_Log_S;
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+// Write commands and the read command that returns what they wrote
+static const uint16_t writeToRead[][2] =
+{
+    {0x0001, 0x0002},   // WRCFGA / RDCFGA
+    {0x0024, 0x0026},   // WRCFGB / RDCFGB
+    {0x0020, 0x0022},   // WRPWMA / RDPWMA
+    {0x0021, 0x0023},   // WRPWMB / RDPWMB
+    {0x0058, 0x0059},   // WRCMCFG / RDCMCFG
+    {0x005A, 0x005B},   // WRCMCELLT / RDCMCELLT
+    {0x005C, 0x005D},   // WRCMGPIOT / RDCMGPIOT
+    {0x0721, 0x0722},   // WRCOMM / RDCOMM
+    {0x0039, 0x003A},   // WRRR / RDRR
+};
+
+static Model_Register_S registers[CHAIN_MODEL_MAX_REGISTERS];
+static uint32_t numRegisters;
+
+static Model_Command_Log_S commandLog[MAX_LOGGED_COMMANDS];
+static uint32_t numLoggedCommands;
+
+// Port whose chip select was last pulled low
+static PORT_E selectedPort = PORTA;
+
+/* ==================================================================== */
+/* ======================= EXTERNAL VARIABLES ========================= */
+/* ==================================================================== */
+
+Chain_Model_S chainModel;
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DECLARATIONS ==================== */
+/* ==================================================================== */
+
+static void answerTransaction(uint16_t command, uint8_t *txBuffer, uint8_t *rxBuffer, uint16_t size);
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+// Bitwise form of the 10 bit data PEC, the firmware uses a lookup table
+static uint16_t calculateDataPec(const uint8_t *data, uint32_t numBytes, uint8_t commandCounter)
+{
+    uint16_t crc = CRC_DATA_SEED;
+
+    for(uint32_t i = 0; i < numBytes; i++)
+    {
+        for(int32_t bit = 7; bit >= 0; bit--)
+        {
+            uint16_t feedback = ((crc >> 9) ^ (data[i] >> bit)) & 1;
+            crc = (crc << 1) & CRC_DATA_MASK;
+            crc ^= (feedback) ? (CRC_DATA_POLY) : (0);
+        }
+    }
+
+    for(int32_t bit = COMMAND_COUNTER_BITS - 1; bit >= 0; bit--)
+    {
+        uint16_t feedback = ((crc >> 9) ^ (commandCounter >> bit)) & 1;
+        crc = (crc << 1) & CRC_DATA_MASK;
+        crc ^= (feedback) ? (CRC_DATA_POLY) : (0);
+    }
+
+    return crc;
+}
+
+static Model_Register_S *findRegister(uint16_t command, bool create)
+{
+    for(uint32_t i = 0; i < numRegisters; i++)
+    {
+        if(registers[i].command == command)
+        {
+            return &registers[i];
+        }
+    }
+
+    if(!create || (numRegisters >= CHAIN_MODEL_MAX_REGISTERS))
+    {
+        return NULL;
+    }
+
+    Model_Register_S *reg = &registers[numRegisters++];
+    memset(reg, 0, sizeof(*reg));
+    reg->command = command;
+    return reg;
+}
+
+static void logCommand(uint16_t command)
+{
+    for(uint32_t i = 0; i < numLoggedCommands; i++)
+    {
+        if(commandLog[i].command == command)
+        {
+            commandLog[i].count++;
+            return;
+        }
+    }
+
+    if(numLoggedCommands < MAX_LOGGED_COMMANDS)
+    {
+        commandLog[numLoggedCommands].command = command;
+        commandLog[numLoggedCommands].count = 1;
+        numLoggedCommands++;
+    }
+}
+
+static int32_t findWriteCommand(uint16_t command)
+{
+    for(uint32_t i = 0; i < (sizeof(writeToRead) / sizeof(writeToRead[0])); i++)
+    {
+        if(writeToRead[i][0] == command)
+        {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+// Chain index of the device at a given frame position, seen from the port the transaction went out on
+static uint32_t frameDevice(PORT_E port, uint32_t frame, uint32_t numFrames, bool isWrite)
+{
+    if(port == PORTA)
+    {
+        // Reads return the closest device first, writes shift the farthest device's data in first
+        return (isWrite) ? (numFrames - frame - 1) : (frame);
+    }
+    else
+    {
+        return (isWrite) ? ((chainModel.numDevs - numFrames) + frame) : (chainModel.numDevs - frame - 1);
+    }
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+void chainModelReset(uint32_t numDevs, PORT_E packMonitorPort, uint32_t *localCommandCounter)
+{
+    memset(&chainModel, 0, sizeof(chainModel));
+    chainModel.numDevs = numDevs;
+    chainModel.packMonitorIndex = (packMonitorPort == PORTA) ? (0) : (numDevs - 1);
+    chainModel.reachableDevices[PORTA] = numDevs;
+    chainModel.reachableDevices[PORTB] = numDevs;
+    chainModel.localCommandCounter = localCommandCounter;
+
+    numRegisters = 0;
+    numLoggedCommands = 0;
+}
+
+void chainModelSetRegister(uint32_t device, uint16_t readCommand, const uint8_t *data)
+{
+    Model_Register_S *reg = findRegister(readCommand, true);
+    if(reg)
+    {
+        memcpy(reg->data[device], data, REGISTER_SIZE_BYTES);
+    }
+}
+
+uint8_t *chainModelGetRegister(uint32_t device, uint16_t readCommand)
+{
+    return findRegister(readCommand, true)->data[device];
+}
+
+uint32_t chainModelCommandCount(uint16_t command)
+{
+    for(uint32_t i = 0; i < numLoggedCommands; i++)
+    {
+        if(commandLog[i].command == command)
+        {
+            return commandLog[i].count;
+        }
+    }
+    return 0;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    if(PinState == GPIO_PIN_RESET)
+    {
+        if((GPIOx == PORTA_CS_GPIO_Port) && (GPIO_Pin == PORTA_CS_Pin))
+        {
+            selectedPort = PORTA;
+        }
+        else if((GPIOx == PORTB_CS_GPIO_Port) && (GPIO_Pin == PORTB_CS_Pin))
+        {
+            selectedPort = PORTB;
+        }
+    }
+}
+
+SPI_STATUS_E taskNotifySPI(SPI_HandleTypeDef* hspi, uint8_t* txBuffer, uint8_t* rxBuffer, uint16_t size, uint32_t timeout)
+{
+    uint16_t command = ((uint16_t)txBuffer[0] << 8) | txBuffer[1];
+
+    if(chainModel.spiErrors > 0)
+    {
+        chainModel.spiErrors--;
+        return SPI_ERROR;
+    }
+
+    chainModel.numTransactions++;
+    chainModel.numBytes += size;
+    chainModel.lastCommand = command;
+    logCommand(command);
+
+    if(chainModel.commandHook)
+    {
+        chainModel.commandHook(command);
+    }
+
+    if(chainModel.trace && chainModel.replayTrace)
+    {
+        // Replay a recorded answer, wrapping at the end of the trace
+        if((chainModel.tracePosition + size) > chainModel.traceSize)
+        {
+            chainModel.tracePosition = 0;
+        }
+        memcpy(rxBuffer, chainModel.trace + chainModel.tracePosition, size);
+        chainModel.tracePosition += size;
+        return SPI_SUCCESS;
+    }
+
+    answerTransaction(command, txBuffer, rxBuffer, size);
+
+    if(chainModel.trace && ((chainModel.tracePosition + size) <= chainModel.traceSize))
+    {
+        memcpy(chainModel.trace + chainModel.tracePosition, rxBuffer, size);
+        chainModel.tracePosition += size;
+    }
+
+    return SPI_SUCCESS;
+}
+
+static void answerTransaction(uint16_t command, uint8_t *txBuffer, uint8_t *rxBuffer, uint16_t size)
+{
+    // Nothing answers past the last reachable device
+    memset(rxBuffer, 0xFF, size);
+
+    if(command == RSTCC)
+    {
+        return;
+    }
+
+    if(size <= COMMAND_PACKET_LENGTH)
+    {
+        return;
+    }
+
+    uint32_t numFrames = (size - COMMAND_PACKET_LENGTH) / REGISTER_PACKET_LENGTH;
+    uint32_t reachable = chainModel.reachableDevices[selectedPort];
+    int32_t writeIndex = findWriteCommand(command);
+
+    if(writeIndex >= 0)
+    {
+        // Writes land in the register the matching read command returns
+        Model_Register_S *reg = findRegister(writeToRead[writeIndex][1], true);
+        for(uint32_t frame = 0; (frame < numFrames) && (frame < reachable); frame++)
+        {
+            uint32_t device = frameDevice(selectedPort, frame, numFrames, true);
+            memcpy(reg->data[device], txBuffer + COMMAND_PACKET_LENGTH + (frame * REGISTER_PACKET_LENGTH), REGISTER_SIZE_BYTES);
+        }
+        return;
+    }
+
+    Model_Register_S *reg = findRegister(command, true);
+    bool corrupt = false;
+    bool counterError = false;
+
+    if(chainModel.corruptReads > 0)
+    {
+        chainModel.corruptReads--;
+        corrupt = true;
+    }
+    else if(chainModel.counterErrorReads > 0)
+    {
+        chainModel.counterErrorReads--;
+        counterError = true;
+    }
+
+    for(uint32_t frame = 0; (frame < numFrames) && (frame < reachable); frame++)
+    {
+        uint32_t device = frameDevice(selectedPort, frame, numFrames, false);
+        uint8_t *packet = rxBuffer + COMMAND_PACKET_LENGTH + (frame * REGISTER_PACKET_LENGTH);
+
+        uint32_t deviceType = (device == chainModel.packMonitorIndex) ? (PACK_MONITOR) : (CELL_MONITOR);
+        uint8_t commandCounter = (chainModel.localCommandCounter) ? ((uint8_t)chainModel.localCommandCounter[deviceType]) : (0);
+        if(counterError)
+        {
+            commandCounter = (commandCounter % 63) + 1;
+        }
+
+        memcpy(packet, reg->data[device], REGISTER_SIZE_BYTES);
+        uint16_t pec = calculateDataPec(packet, REGISTER_SIZE_BYTES, commandCounter);
+        if(corrupt)
+        {
+            pec ^= 0x0001;
+        }
+
+        packet[REGISTER_SIZE_BYTES] = (uint8_t)((commandCounter << 2) | (pec >> 8));
+        packet[REGISTER_SIZE_BYTES + 1] = (uint8_t)pec;
+    }
+}
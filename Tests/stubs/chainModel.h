@@ -0,0 +1,76 @@
+#ifndef STUB_CHAIN_MODEL_H_
+#define STUB_CHAIN_MODEL_H_
+
+// Host side model of the isoSPI daisy chain, answers the SPI traffic the
+// firmware sends with register data, command counters and data PECs
+
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "adbms/isospi.h"
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+#define CHAIN_MODEL_MAX_DEVICES     9
+#define CHAIN_MODEL_MAX_REGISTERS   64
+
+/* ==================================================================== */
+/* ============================== STRUCTS ============================= */
+/* ==================================================================== */
+
+typedef struct
+{
+    // Devices are indexed in chain order starting at port A
+    uint32_t numDevs;
+    uint32_t packMonitorIndex;
+
+    // Number of devices each port can reach, lower it to model a chain break
+    uint32_t reachableDevices[NUM_PORTS];
+
+    // Devices echo the host command counters, set to the firmware chain info
+    uint32_t *localCommandCounter;
+
+    // Fault injection, each count is consumed by the next register reads
+    uint32_t corruptReads;
+    uint32_t counterErrorReads;
+    uint32_t spiErrors;
+
+    // Called for every transaction before it is answered, lets a test advance device state
+    void (*commandHook)(uint16_t command);
+
+    // When set, every answer is appended to the trace, or answered from it when replaying
+    uint8_t *trace;
+    uint32_t traceSize;
+    uint32_t tracePosition;
+    bool replayTrace;
+
+    // Traffic log
+    uint32_t numTransactions;
+    uint32_t numBytes;
+    uint16_t lastCommand;
+} Chain_Model_S;
+
+/* ==================================================================== */
+/* ======================= EXTERNAL VARIABLES ========================= */
+/* ==================================================================== */
+
+extern Chain_Model_S chainModel;
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DECLARATIONS =================== */
+/* ==================================================================== */
+
+void chainModelReset(uint32_t numDevs, PORT_E packMonitorPort, uint32_t *localCommandCounter);
+
+void chainModelSetRegister(uint32_t device, uint16_t readCommand, const uint8_t *data);
+
+uint8_t *chainModelGetRegister(uint32_t device, uint16_t readCommand);
+
+uint32_t chainModelCommandCount(uint16_t command);
+
+#endif /* STUB_CHAIN_MODEL_H_ */
@@ -0,0 +1,23 @@
+#ifndef STUB_CMSIS_OS_H_
+#define STUB_CMSIS_OS_H_
+
+// Host side stand in for the RTOS, ticks only advance when a test moves them
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+#define portMAX_DELAY       ((TickType_t)0xFFFFFFFF)
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+extern TickType_t stubTickCount;
+
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
+void osDelay(uint32_t ms);
+void vTaskSuspendAll(void);
+long xTaskResumeAll(void);
+
+#endif /* STUB_CMSIS_OS_H_ */
@@ -0,0 +1,61 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+#include "stm32f4xx_hal.h"
+#include "cmsis_os.h"
+#include "utils.h"
+
+/* ==================================================================== */
+/* ========================= GLOBAL VARIABLES ========================= */
+/* ==================================================================== */
+
+// Tests move the microsecond timer and the tick count directly
+TIM_HandleTypeDef htim5;
+SPI_HandleTypeDef hspi1;
+TickType_t stubTickCount = 0;
+
+GPIO_TypeDef stubGpioA, stubGpioB, stubGpioC, stubGpioD;
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return GPIO_PIN_RESET;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    return stubTickCount;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return stubTickCount;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    stubTickCount += ticks;
+}
+
+void osDelay(uint32_t ms)
+{
+    stubTickCount += ms;
+}
+
+void vTaskSuspendAll(void)
+{
+}
+
+long xTaskResumeAll(void)
+{
+    return 0;
+}
+
+void delayMicroseconds(uint32_t us)
+{
+    htim5.counter += us;
+}
@@ -0,0 +1,83 @@
+#ifndef STUB_STM32F4XX_HAL_H_
+#define STUB_STM32F4XX_HAL_H_
+
+// Host side stand in for the HAL, only the pieces the tested sources touch
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct
+{
+    uint32_t IDR;
+} GPIO_TypeDef;
+
+typedef struct
+{
+    uint32_t counter;
+} TIM_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t state;
+} SPI_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t state;
+} ADC_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t state;
+} CAN_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t state;
+} UART_HandleTypeDef;
+
+extern GPIO_TypeDef stubGpioA, stubGpioB, stubGpioC, stubGpioD;
+#define GPIOA (&stubGpioA)
+#define GPIOB (&stubGpioB)
+#define GPIOC (&stubGpioC)
+#define GPIOD (&stubGpioD)
+
+#define GPIO_PIN_0  ((uint16_t)0x0001)
+#define GPIO_PIN_1  ((uint16_t)0x0002)
+#define GPIO_PIN_2  ((uint16_t)0x0004)
+#define GPIO_PIN_3  ((uint16_t)0x0008)
+#define GPIO_PIN_4  ((uint16_t)0x0010)
+#define GPIO_PIN_5  ((uint16_t)0x0020)
+#define GPIO_PIN_6  ((uint16_t)0x0040)
+#define GPIO_PIN_7  ((uint16_t)0x0080)
+#define GPIO_PIN_8  ((uint16_t)0x0100)
+#define GPIO_PIN_9  ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+
+#define __HAL_TIM_GetCounter(htim)  ((htim)->counter)
+#define __DMB()                     __sync_synchronize()
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+uint32_t HAL_GetTick(void);
+
+#endif /* STUB_STM32F4XX_HAL_H_ */
@@ -0,0 +1,226 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+// The unit under test is included directly so its local functions can be timed
+#include "../Core/Src/telemetryStatistics.c"
+#include "testUtils.h"
+#include <stdlib.h>
+#include <time.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+#define BENCHMARK_PASSES    100000
+#define BENCHMARK_TRIALS    5
+
+/* ==================================================================== */
+/* ============================== STRUCTS ============================= */
+/* ==================================================================== */
+
+// Per BMB layout the statistics used to walk, cell data interleaved with the board level fields
+typedef struct
+{
+    float cellVoltage[NUM_CELLS_PER_CELL_MONITOR];
+    SENSOR_STATUS_E cellVoltageStatus[NUM_CELLS_PER_CELL_MONITOR];
+    bool cellBalancingActive[NUM_CELLS_PER_CELL_MONITOR];
+    float cellTemp[NUM_CELLS_PER_CELL_MONITOR];
+    SENSOR_STATUS_E cellTempStatus[NUM_CELLS_PER_CELL_MONITOR];
+
+    float boardTemp;
+    SENSOR_STATUS_E boardTempStatus;
+    float referenceVoltage;
+    SENSOR_STATUS_E referenceVoltageStatus;
+    float dieTemp;
+    SENSOR_STATUS_E dieTempStatus;
+    float digitalSupplyVoltage;
+    SENSOR_STATUS_E digitalSupplyVoltageStatus;
+    float analogSupplyVoltage;
+    SENSOR_STATUS_E analogSupplyVoltageStatus;
+    float referenceResistorVoltage;
+    SENSOR_STATUS_E referenceResistorVoltageStatus;
+
+    float maxCellVoltage;
+    float minCellVoltage;
+    float sumCellVoltage;
+    float avgCellVoltage;
+    uint32_t numBadCellVoltage;
+
+    float maxCellTemp;
+    float minCellTemp;
+    float avgCellTemp;
+    uint32_t numBadCellTemp;
+} Interleaved_Cell_Monitor_S;
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+int numTestFailures = 0;
+
+static telemetryTaskData_S taskData;
+static Interleaved_Cell_Monitor_S interleavedBmb[NUM_CELL_MON_IN_ACCUMULATOR];
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+// The per BMB statistics pass over the interleaved layout, voltage and temperature in one loop
+static void updateInterleavedStatistics(Interleaved_Cell_Monitor_S *bmb)
+{
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        Interleaved_Cell_Monitor_S* pBmb = &bmb[i];
+        float maxCellVoltage = MIN_CELLV_SENSOR_VALUE;
+        float minCellVoltage = MAX_CELLV_SENSOR_VALUE;
+        float sumVoltage = 0.0f;
+        uint32_t numGoodCellVoltage = 0;
+
+        float maxCellTemp = MIN_TEMP_SENSOR_VALUE_C;
+        float minCellTemp = MAX_TEMP_SENSOR_VALUE_C;
+        float sumCellTemp = 0.0f;
+        uint32_t numGoodCellTemp = 0;
+
+        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+        {
+            if(pBmb->cellVoltageStatus[j] == GOOD)
+            {
+                float cellV = pBmb->cellVoltage[j];
+                maxCellVoltage = (cellV > maxCellVoltage) ? (cellV) : (maxCellVoltage);
+                minCellVoltage = (cellV < minCellVoltage) ? (cellV) : (minCellVoltage);
+                numGoodCellVoltage++;
+                sumVoltage += cellV;
+            }
+
+            if(pBmb->cellTempStatus[j] == GOOD)
+            {
+                float cellTemp = pBmb->cellTemp[j];
+                maxCellTemp = (cellTemp > maxCellTemp) ? (cellTemp) : (maxCellTemp);
+                minCellTemp = (cellTemp < minCellTemp) ? (cellTemp) : (minCellTemp);
+                numGoodCellTemp++;
+                sumCellTemp += cellTemp;
+            }
+        }
+
+        if(numGoodCellVoltage > 0)
+        {
+            pBmb->maxCellVoltage = maxCellVoltage;
+            pBmb->minCellVoltage = minCellVoltage;
+            pBmb->sumCellVoltage = sumVoltage;
+            pBmb->avgCellVoltage = (sumVoltage / numGoodCellVoltage);
+        }
+        pBmb->numBadCellVoltage = NUM_CELLS_PER_CELL_MONITOR - numGoodCellVoltage;
+
+        if(numGoodCellTemp > 0)
+        {
+            pBmb->maxCellTemp = maxCellTemp;
+            pBmb->minCellTemp = minCellTemp;
+            pBmb->avgCellTemp = (sumCellTemp / numGoodCellTemp);
+        }
+        pBmb->numBadCellTemp = NUM_CELLS_PER_CELL_MONITOR - numGoodCellTemp;
+    }
+}
+
+// Fill both layouts with the same pseudo random cells, roughly one sensor in sixteen reads bad
+static void fillCells()
+{
+    srand(26);
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+        {
+            float voltage = 3.6f + (0.4f * rand() / RAND_MAX);
+            float temp = 25.0f + (20.0f * rand() / RAND_MAX);
+            SENSOR_STATUS_E voltageStatus = ((rand() % 16) == 0) ? (BAD) : (GOOD);
+            SENSOR_STATUS_E tempStatus = ((rand() % 16) == 0) ? (BAD) : (GOOD);
+
+            taskData.cells.cellVoltage[CELL_INDEX(i, j)] = voltage;
+            taskData.cells.cellTemp[CELL_INDEX(i, j)] = temp;
+            taskData.cells.cellVoltageStatus[CELL_INDEX(i, j)] = voltageStatus;
+            taskData.cells.cellTempStatus[CELL_INDEX(i, j)] = tempStatus;
+
+            interleavedBmb[i].cellVoltage[j] = voltage;
+            interleavedBmb[i].cellTemp[j] = temp;
+            interleavedBmb[i].cellVoltageStatus[j] = voltageStatus;
+            interleavedBmb[i].cellTempStatus[j] = tempStatus;
+        }
+    }
+}
+
+static double elapsedNs(struct timespec *start, struct timespec *end)
+{
+    return ((end->tv_sec - start->tv_sec) * 1e9) + (end->tv_nsec - start->tv_nsec);
+}
+
+static void testLayoutsAgree()
+{
+    fillCells();
+    updateCellMonitorStatistics(&taskData);
+    updateInterleavedStatistics(interleavedBmb);
+
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        CHECK_FLOAT(taskData.bmb[i].maxCellVoltage, interleavedBmb[i].maxCellVoltage, 0.0f);
+        CHECK_FLOAT(taskData.bmb[i].minCellVoltage, interleavedBmb[i].minCellVoltage, 0.0f);
+        CHECK_FLOAT(taskData.bmb[i].avgCellVoltage, interleavedBmb[i].avgCellVoltage, 1e-5f);
+        CHECK(taskData.bmb[i].numBadCellVoltage == interleavedBmb[i].numBadCellVoltage);
+        CHECK_FLOAT(taskData.bmb[i].maxCellTemp, interleavedBmb[i].maxCellTemp, 0.0f);
+        CHECK_FLOAT(taskData.bmb[i].minCellTemp, interleavedBmb[i].minCellTemp, 0.0f);
+        CHECK_FLOAT(taskData.bmb[i].avgCellTemp, interleavedBmb[i].avgCellTemp, 1e-4f);
+        CHECK(taskData.bmb[i].numBadCellTemp == interleavedBmb[i].numBadCellTemp);
+    }
+}
+
+static void benchmarkLayouts()
+{
+    struct timespec start, end;
+    double interleavedNs = 1e9;
+    double contiguousNs = 1e9;
+
+    fillCells();
+
+    // Keep the fastest of several trials so scheduler noise on the host does not swamp the difference
+    for(uint32_t trial = 0; trial < BENCHMARK_TRIALS; trial++)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(uint32_t i = 0; i < BENCHMARK_PASSES; i++)
+        {
+            updateInterleavedStatistics(interleavedBmb);
+            __asm__ volatile("" : : "r"(interleavedBmb) : "memory");
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double ns = elapsedNs(&start, &end) / BENCHMARK_PASSES;
+        interleavedNs = (ns < interleavedNs) ? (ns) : (interleavedNs);
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for(uint32_t i = 0; i < BENCHMARK_PASSES; i++)
+        {
+            updateCellMonitorStatistics(&taskData);
+            __asm__ volatile("" : : "r"(&taskData) : "memory");
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        ns = elapsedNs(&start, &end) / BENCHMARK_PASSES;
+        contiguousNs = (ns < contiguousNs) ? (ns) : (contiguousNs);
+    }
+
+    // Bytes the cell loops have to stream through, the interleaved layout strides over the board level fields
+    size_t interleavedSpan = sizeof(interleavedBmb) - (sizeof(Interleaved_Cell_Monitor_S) - offsetof(Interleaved_Cell_Monitor_S, boardTemp));
+    size_t contiguousSpan = sizeof(taskData.cells.cellVoltage) + sizeof(taskData.cells.cellTemp) +
+                            sizeof(taskData.cells.cellVoltageStatus) + sizeof(taskData.cells.cellTempStatus);
+
+    printf("interleaved: %8.1f ns/pass, %5zu bytes spanned, %3zu cache lines\n", interleavedNs, interleavedSpan, (interleavedSpan + 63) / 64);
+    printf("contiguous:  %8.1f ns/pass, %5zu bytes spanned, %3zu cache lines\n", contiguousNs, contiguousSpan, (contiguousSpan + 63) / 64);
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+int main(void)
+{
+    RUN_TEST(testLayoutsAgree);
+    benchmarkLayouts();
+
+    return (numTestFailures == 0) ? 0 : 1;
+}
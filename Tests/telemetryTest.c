@@ -0,0 +1,1753 @@
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+// The unit under test is included directly so its local functions and state can be reached
+#include "../Core/Src/telemetry.c"
+#include "chainModel.h"
+#include "testUtils.h"
+#include "alerts.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================================================================== */
+/* ============================= DEFINES ============================== */
+/* ==================================================================== */
+
+// Chain index of cell monitor n, the pack monitor sits on port A
+#define CELL_MON_DEVICE(n)  ((n) + 1)
+#define PACK_MON_DEVICE     0
+
+// Register read commands answered by the chain model, private to adbms.c
+#define RDCVA       0x0004
+#define RDCVB       0x0006
+#define RDCVC       0x0008
+#define RDCVD       0x000A
+#define RDCVE       0x0009
+#define RDCVF       0x000B
+#define RDACA       0x0044
+#define RDACB       0x0046
+#define RDACC       0x0048
+#define RDACD       0x004A
+#define RDACE       0x0049
+#define RDACF       0x004B
+#define RDSVA       0x0003
+#define RDSVB       0x0005
+#define RDSVC       0x0007
+#define RDSVD       0x000D
+#define RDSVE       0x000E
+#define RDSVF       0x000F
+#define RDFCA       0x0012
+#define RDFCB       0x0013
+#define RDFCC       0x0014
+#define RDFCD       0x0015
+#define RDFCE       0x0016
+#define RDFCF       0x0017
+#define RDAUXA      0x0019
+#define ADSV_OPEN_WIRE_EVEN     0x01E9
+#define ADSV_OPEN_WIRE_ODD      0x01EA
+#define RDSID       0x002C
+#define MUTE        0x0028
+#define UNMUTE      0x0029
+#define RDSTATA     0x0030
+#define RDSTATB     0x0031
+#define RDSTATC     0x0032
+#define RDSTATD     0x0033
+#define RDSTATE     0x0034
+#define WRCFGA      0x0001
+#define RDCFGA      0x0002
+#define RDCFGB      0x0026
+#define CLOVUV      0x0715
+#define CLRFLAG     0x0717
+#define WRCFGB      0x0024
+#define RSTCC       0x002E
+#define ADV         0x0430
+
+#define NUM_CELLV_REGISTERS     6
+#define VOLTAGE_16BIT_PER_REG   3
+
+// Discharge timer field of config B byte 3
+#define DTM_ENABLE              0x80
+#define DTM_LONG_RANGE_ENABLE   0x40
+#define DTM_LONG_RANGE_STEP     16
+
+#define AUX_CODE(volts)     ((int16_t)lroundf(((volts) - CELL_MON_AUX_ADC_OFFSET) / CELL_MON_AUX_ADC_GAIN))
+// Aux conversions start with ADAX, whose low bits carry the channel and open wire options
+#define IS_ADAX(command)    (((command) & 0x0710) == 0x0410)
+
+#define CELL_CODE(volts)    ((int16_t)lroundf(((volts) - CELL_MON_CELL_ADC_OFFSET) / CELL_MON_CELL_ADC_GAIN))
+
+/* ==================================================================== */
+/* ========================= LOCAL VARIABLES ========================== */
+/* ==================================================================== */
+
+int numTestFailures = 0;
+
+static telemetryTaskData_S taskData;
+
+static const uint16_t cellRegisterCodes[][NUM_CELLV_REGISTERS] =
+{
+    {RDCVA, RDCVB, RDCVC, RDCVD, RDCVE, RDCVF},
+    {RDACA, RDACB, RDACC, RDACD, RDACE, RDACF},
+    {RDFCA, RDFCB, RDFCC, RDFCD, RDFCE, RDFCF}
+};
+
+static const uint16_t redundantCellRegisterCodes[NUM_CELLV_REGISTERS] =
+{
+    RDSVA, RDSVB, RDSVC, RDSVD, RDSVE, RDSVF
+};
+
+/* ==================================================================== */
+/* =================== LOCAL FUNCTION DEFINITIONS ===================== */
+/* ==================================================================== */
+
+static void resetTelemetry()
+{
+    memset(&taskData, 0, sizeof(taskData));
+    memset(&batteryData, 0, sizeof(batteryData));
+    memset(voltageDataBuffer, 0, sizeof(voltageDataBuffer));
+    memset(auxDataBuffer, 0, sizeof(auxDataBuffer));
+    batteryData.voltageData = &voltageDataBuffer[0];
+    batteryData.auxData = &auxDataBuffer[0];
+    frontVoltageData = &voltageDataBuffer[1];
+    frontAuxData = &auxDataBuffer[1];
+    memset(commandBlockState, 0, sizeof(commandBlockState));
+    memset(currentChannelExcluded, 0, sizeof(currentChannelExcluded));
+    shuntElementTempRise = 0.0f;
+    shuntModelStarted = false;
+    prechargeState = PRECHARGE_IDLE;
+    nextPrechargeSampleTimeUs = 0;
+    telemetryRateLevel = 0;
+    restCycles = 0;
+    rateVoltageValid = false;
+    activityWakeRequested = false;
+    chainModelReset(NUM_DEVICES_IN_ACCUMULATOR, PORTA, batteryData.chainInfo.localCommandCounter);
+
+    CHECK(initChain(&taskData) == TRANSACTION_SUCCESS);
+}
+
+// Run a command block the way the telemetry cycle does, starting at its first step
+static TRANSACTION_STATUS_E runBlock(TRANSACTION_STATUS_E (*commandBlock)(telemetryTaskData_S*))
+{
+    return runCommandBlock(commandBlock, &taskData, NULL);
+}
+
+static void setRegisterWord(uint32_t device, uint16_t command, uint32_t word, int16_t value)
+{
+    uint8_t *reg = chainModelGetRegister(device, command);
+    reg[word * 2] = (uint8_t)value;
+    reg[(word * 2) + 1] = (uint8_t)((uint16_t)value >> 8);
+}
+
+// Load a cell's C-ADC result into the raw, averaged and filtered groups and its S-ADC result into the S voltage group
+static void setCellVoltage(uint32_t bmb, uint32_t cell, float cAdcVoltage, float sAdcVoltage)
+{
+    uint32_t group = cell / VOLTAGE_16BIT_PER_REG;
+    uint32_t word = cell % VOLTAGE_16BIT_PER_REG;
+
+    for(uint32_t type = 0; type < (sizeof(cellRegisterCodes) / sizeof(cellRegisterCodes[0])); type++)
+    {
+        setRegisterWord(CELL_MON_DEVICE(bmb), cellRegisterCodes[type][group], word, CELL_CODE(cAdcVoltage));
+    }
+    setRegisterWord(CELL_MON_DEVICE(bmb), redundantCellRegisterCodes[group], word, CELL_CODE(sAdcVoltage));
+}
+
+// Load every cell of one register type, 0 raw, 1 averaged, 2 filtered
+static void setCellVoltagesOfType(uint32_t type, float voltage)
+{
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+        {
+            setRegisterWord(CELL_MON_DEVICE(i), cellRegisterCodes[type][j / VOLTAGE_16BIT_PER_REG], j % VOLTAGE_16BIT_PER_REG, CELL_CODE(voltage));
+        }
+    }
+}
+
+// Pack monitor 24 bit results are stored little endian from the start of the register
+static void setPackRegister24(uint16_t command, int32_t value)
+{
+    uint8_t *reg = chainModelGetRegister(PACK_MON_DEVICE, command);
+    reg[0] = (uint8_t)value;
+    reg[1] = (uint8_t)(value >> 8);
+    reg[2] = (uint8_t)(value >> 16);
+}
+
+// Load the same shunt voltage into both current channels, IADC2 reads the shunt with inverted polarity
+static void setPackCurrentRegister(uint16_t command, int32_t value)
+{
+    uint8_t *reg = chainModelGetRegister(PACK_MON_DEVICE, command);
+    int32_t inverted = -value;
+    reg[0] = (uint8_t)value;
+    reg[1] = (uint8_t)(value >> 8);
+    reg[2] = (uint8_t)(value >> 16);
+    reg[3] = (uint8_t)inverted;
+    reg[4] = (uint8_t)(inverted >> 8);
+    reg[5] = (uint8_t)(inverted >> 16);
+}
+
+static void setAllCellVoltages(float voltage)
+{
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+        {
+            setCellVoltage(i, j, voltage, voltage);
+        }
+    }
+}
+
+// Latch the on chip C-ADC vs S-ADC comparison bit for a cell in status C
+static void setAdcMismatchFlag(uint32_t bmb, uint32_t cell, bool set)
+{
+    uint8_t *statusC = chainModelGetRegister(CELL_MON_DEVICE(bmb), RDSTATC);
+    uint8_t bit = (uint8_t)(1 << (cell % BITS_IN_BYTE));
+    statusC[cell / BITS_IN_BYTE] = (set) ? (statusC[cell / BITS_IN_BYTE] | bit) : (statusC[cell / BITS_IN_BYTE] & ~bit);
+}
+
+// Set the interleaved status D comparator bits, UV in even bits and OV in odd bits
+static void setOvUvFlags(uint32_t bmb, uint16_t underVoltageFlags, uint16_t overVoltageFlags)
+{
+    uint32_t flagBits = 0;
+    for(uint32_t j = 0; j < NUM_CELLS_PER_CELL_MONITOR; j++)
+    {
+        flagBits |= ((uint32_t)((underVoltageFlags >> j) & 1)) << (j * 2);
+        flagBits |= ((uint32_t)((overVoltageFlags >> j) & 1)) << ((j * 2) + 1);
+    }
+
+    uint8_t *statusD = chainModelGetRegister(CELL_MON_DEVICE(bmb), RDSTATD);
+    for(uint32_t byte = 0; byte < 4; byte++)
+    {
+        statusD[byte] = (uint8_t)(flagBits >> (byte * BITS_IN_BYTE));
+    }
+}
+
+static Alert_S *findTelemetryAlert(const char *name, telemetryAlertCondition *condition)
+{
+    for(uint32_t i = 0; i < NUM_TELEMETRY_ALERTS; i++)
+    {
+        if(strcmp(telemetryAlerts[i]->alertName, name) == 0)
+        {
+            *condition = telemetryAlertConditionArray[i];
+            return telemetryAlerts[i];
+        }
+    }
+    return NULL;
+}
+
+// Good cells at a common voltage with balancing enabled, the next call is due to plan
+static void setupBalancing(float voltage)
+{
+    for(uint32_t i = 0; i < NUM_CELLS_IN_ACCUMULATOR; i++)
+    {
+        taskData.cells.cellVoltage[i] = voltage;
+        taskData.cells.cellVoltageStatus[i] = GOOD;
+    }
+    taskData.minCellVoltage = voltage;
+    taskData.maxCellTemp = 25.0f;
+    taskData.balancingEnabled = true;
+    taskData.balancingFloor = 0.0f;
+    stubTickCount += BALANCING_REPLAN_PERIOD_MS;
+}
+
+static uint16_t dischargeMask(uint32_t bmb)
+{
+    uint8_t *configB = chainModelGetRegister(CELL_MON_DEVICE(bmb), RDCFGB);
+    return (uint16_t)configB[4] | ((uint16_t)configB[5] << 8);
+}
+
+// State the telemetry cycle resets before it runs its command blocks
+static void startCycle()
+{
+    cycleStartTimeUs = htim5.counter;
+    redundantCellsRead = false;
+}
+
+// The per cycle blocks that pick up and verify an on chip ADC mismatch
+static void runDiagnosticCycle()
+{
+    startCycle();
+    CHECK(updateConversionStatus(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(updatePrimaryPackTelemetry(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(runBlock(verifyAdcMismatch) == TRANSACTION_SUCCESS);
+}
+
+static void testPersistentAdcMismatchMarksCellBad()
+{
+    resetTelemetry();
+    setAllCellVoltages(3.7f);
+
+    // The S-ADC reads 200 mV high on one cell and the device flags it
+    setCellVoltage(2, 5, 3.7f, 3.9f);
+    setAdcMismatchFlag(2, 5, true);
+
+    for(uint32_t cycle = 0; cycle < REDUNDANT_ADC_FAULT_COUNT; cycle++)
+    {
+        runDiagnosticCycle();
+        CHECK(taskData.cells.cellVoltageStatus[CELL_INDEX(2, 5)] == GOOD);
+    }
+
+    // The fault is applied on the next voltage update
+    updatePrimaryPackTelemetry(&taskData);
+    CHECK(taskData.cells.cellAdcFault[CELL_INDEX(2, 5)]);
+    CHECK(taskData.cells.cellVoltageStatus[CELL_INDEX(2, 5)] == BAD);
+    CHECK(taskData.cells.cellVoltageStatus[CELL_INDEX(2, 4)] == GOOD);
+    CHECK(taskData.cells.cellVoltageStatus[CELL_INDEX(3, 5)] == GOOD);
+
+    // Once the ADCs agree again the cell recovers on the next scheduled readback
+    setCellVoltage(2, 5, 3.7f, 3.7f);
+    setAdcMismatchFlag(2, 5, false);
+    runDiagnosticCycle();
+    CHECK(taskData.cells.cellAdcFault[CELL_INDEX(2, 5)]);
+
+    startCycle();
+    CHECK(runBlock(runDeviceDiagnostics) == TRANSACTION_SUCCESS);
+    updatePrimaryPackTelemetry(&taskData);
+    CHECK(!taskData.cells.cellAdcFault[CELL_INDEX(2, 5)]);
+    CHECK(taskData.cells.cellVoltageStatus[CELL_INDEX(2, 5)] == GOOD);
+}
+
+static void testTransientAdcMismatchIgnored()
+{
+    resetTelemetry();
+    setAllCellVoltages(3.7f);
+
+    // A flagged cell whose readback agrees is not faulted
+    setAdcMismatchFlag(0, 0, true);
+    for(uint32_t cycle = 0; cycle < (2 * REDUNDANT_ADC_FAULT_COUNT); cycle++)
+    {
+        runDiagnosticCycle();
+    }
+    CHECK(!taskData.cells.cellAdcFault[CELL_INDEX(0, 0)]);
+
+    // Disagreement that clears before the count is reached is not faulted
+    for(uint32_t cycle = 0; cycle < (2 * REDUNDANT_ADC_FAULT_COUNT); cycle++)
+    {
+        setCellVoltage(0, 0, 3.7f, ((cycle % 2) == 0) ? (3.9f) : (3.7f));
+        runDiagnosticCycle();
+    }
+    CHECK(!taskData.cells.cellAdcFault[CELL_INDEX(0, 0)]);
+}
+
+static void testRateGroupPhasing()
+{
+    resetTelemetry();
+    setAllCellVoltages(3.7f);
+    taskData.chainInitialized = true;
+
+    uint32_t numCycles = 2 * STATUS_PERIOD_CYCLES;
+    uint32_t conversionStatusReads = 0;
+    for(uint32_t cycle = 0; cycle < numCycles; cycle++)
+    {
+        uint32_t statusReads = chainModelCommandCount(RDSTATA);
+        uint32_t conversionReads = chainModelCommandCount(RDSTATC);
+        uint32_t auxReads = chainModelCommandCount(RDAUXA);
+
+        // The aux open wire test holds the temperature group off while it owns the aux ADC
+        bool temperatureHeld = auxOpenWireActive;
+
+        CHECK(updateBatteryTelemetry(&taskData) == TRANSACTION_SUCCESS);
+        stubTickCount += TELEMETRY_TASK_PERIOD_MS;
+
+        bool statusRan = (chainModelCommandCount(RDSTATA) != statusReads);
+        bool temperatureRan = (chainModelCommandCount(RDAUXA) != auxReads);
+
+        CHECK(statusRan == ((cycle % STATUS_PERIOD_CYCLES) == STATUS_PHASE_CYCLES));
+        if(!temperatureHeld && !auxOpenWireActive)
+        {
+            CHECK(temperatureRan == ((cycle % TEMPERATURE_PERIOD_CYCLES) == TEMPERATURE_PHASE_CYCLES));
+        }
+
+        // The slow groups never share a cycle
+        CHECK((statusRan + temperatureRan) <= 1);
+
+        // Status C is read the same way every cycle
+        if(cycle == 0)
+        {
+            conversionStatusReads = chainModelCommandCount(RDSTATC) - conversionReads;
+        }
+        CHECK(conversionStatusReads > 0);
+        CHECK((chainModelCommandCount(RDSTATC) - conversionReads) == conversionStatusReads);
+    }
+
+    // Diagnostics run one slice every cycle
+    CHECK(taskData.rateGroupTiming[RATE_GROUP_CELL_VOLTAGE].numRuns == numCycles);
+    CHECK(taskData.rateGroupTiming[RATE_GROUP_DIAGNOSTICS].numRuns == numCycles);
+    CHECK(taskData.rateGroupTiming[RATE_GROUP_STATUS].numRuns == (numCycles / STATUS_PERIOD_CYCLES));
+
+    // A latched mismatch is read back in the cycle it is seen, outside the redundant ADC pass
+    diagnosticState = AUX_OPEN_WIRE_PULL_UP_DIAG_STATE;
+    diagnosticSlice = OPEN_WIRE_SOAK_SLICE;
+    auxOpenWireActive = true;
+    setAdcMismatchFlag(7, 15, true);
+    uint32_t redundantReads = chainModelCommandCount(RDSVA);
+    CHECK(updateBatteryTelemetry(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(RDSVA) == redundantReads + 1);
+
+    // When the redundant ADC pass reads back in the same cycle the cells are not read twice
+    diagnosticState = REDUNDANT_ADC_DIAG_STATE;
+    diagnosticSlice = REDUNDANT_CELL_READ_SLICE;
+    auxOpenWireActive = false;
+    redundantReads = chainModelCommandCount(RDSVA);
+    CHECK(updateBatteryTelemetry(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(RDSVA) == redundantReads + 1);
+}
+
+// Run diagnostic slices one cycle apart until the rotation reaches a test
+static void runDiagnosticsUntil(ADC_DIAG_STATE_E state)
+{
+    for(uint32_t cycle = 0; (cycle < 100) && (diagnosticState != state); cycle++)
+    {
+        startCycle();
+        CHECK(runBlock(runDeviceDiagnostics) == TRANSACTION_SUCCESS);
+        stubTickCount += TELEMETRY_TASK_PERIOD_MS;
+    }
+    CHECK(diagnosticState == state);
+}
+
+static void testDiagnosticSliceResume()
+{
+    resetTelemetry();
+    setAllCellVoltages(3.7f);
+    CHECK(updatePrimaryPackTelemetry(&taskData) == TRANSACTION_SUCCESS);
+
+    // The redundant pass takes a cell slice and an aux slice
+    runDiagnosticsUntil(OPEN_WIRE_EVEN_DIAG_STATE);
+    CHECK(taskData.diagnosticCoverage[REDUNDANT_ADC_DIAG_STATE].numPasses == 1);
+
+    // Start the even open wire test, then soak across cycles
+    startCycle();
+    CHECK(runBlock(runDeviceDiagnostics) == TRANSACTION_SUCCESS);
+    CHECK(cellOpenWireActive);
+    CHECK(chainModelCommandCount(ADSV_OPEN_WIRE_EVEN) == 1);
+    while(diagnosticSlice == OPEN_WIRE_SOAK_SLICE)
+    {
+        stubTickCount += TELEMETRY_TASK_PERIOD_MS;
+        startCycle();
+        CHECK(runBlock(runDeviceDiagnostics) == TRANSACTION_SUCCESS);
+    }
+    CHECK(diagnosticSlice == OPEN_WIRE_READ_SLICE);
+
+    // A failed read leaves the slice in place and the next cycle resumes it without restarting the test
+    uint32_t redundantReads = chainModelCommandCount(RDSVA);
+    chainModel.spiErrors = 100;
+    startCycle();
+    CHECK(runBlock(runDeviceDiagnostics) == TRANSACTION_SPI_ERROR);
+    chainModel.spiErrors = 0;
+    CHECK(diagnosticSlice == OPEN_WIRE_READ_SLICE);
+    CHECK(cellOpenWireActive);
+
+    startCycle();
+    CHECK(runBlock(runDeviceDiagnostics) == TRANSACTION_SUCCESS);
+    CHECK(diagnosticSlice == OPEN_WIRE_RESTORE_SLICE);
+    CHECK(chainModelCommandCount(RDSVA) == redundantReads + 1);
+    CHECK(chainModelCommandCount(ADSV_OPEN_WIRE_EVEN) == 1);
+
+    startCycle();
+    CHECK(runBlock(runDeviceDiagnostics) == TRANSACTION_SUCCESS);
+    CHECK(!cellOpenWireActive);
+    CHECK(diagnosticState == OPEN_WIRE_ODD_DIAG_STATE);
+    CHECK(taskData.diagnosticCoverage[OPEN_WIRE_EVEN_DIAG_STATE].numPasses == 1);
+}
+
+static void testCellOpenWireAssembly()
+{
+    resetTelemetry();
+    setAllCellVoltages(3.7f);
+    CHECK(updatePrimaryPackTelemetry(&taskData) == TRANSACTION_SUCCESS);
+
+    // An open wire on cell 4 drags its S-ADC reading down under the even pull down
+    runDiagnosticsUntil(OPEN_WIRE_EVEN_DIAG_STATE);
+    setCellVoltage(3, 4, 3.7f, 3.0f);
+    runDiagnosticsUntil(OPEN_WIRE_ODD_DIAG_STATE);
+    CHECK(taskData.cells.cellOpenWire[CELL_INDEX(3, 4)]);
+    CHECK(!taskData.cells.cellOpenWire[CELL_INDEX(3, 5)]);
+
+    // The odd pass finds cell 5 and keeps the even result
+    setCellVoltage(3, 4, 3.7f, 3.7f);
+    setCellVoltage(3, 5, 3.7f, 3.0f);
+    runDiagnosticsUntil(AUX_OPEN_WIRE_PULL_DOWN_DIAG_STATE);
+    CHECK(taskData.cells.cellOpenWire[CELL_INDEX(3, 4)]);
+    CHECK(taskData.cells.cellOpenWire[CELL_INDEX(3, 5)]);
+
+    // Open wire cells are not trusted
+    CHECK(updatePrimaryPackTelemetry(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(taskData.cells.cellVoltageStatus[CELL_INDEX(3, 4)] == BAD);
+    CHECK(taskData.cells.cellVoltageStatus[CELL_INDEX(3, 3)] == GOOD);
+
+    // The next even pass clears cell 4 and leaves the latest odd result in place
+    setCellVoltage(3, 5, 3.7f, 3.7f);
+    runDiagnosticsUntil(OPEN_WIRE_ODD_DIAG_STATE);
+    CHECK(!taskData.cells.cellOpenWire[CELL_INDEX(3, 4)]);
+    CHECK(taskData.cells.cellOpenWire[CELL_INDEX(3, 5)]);
+}
+
+static void testAuxOpenWireAssembly()
+{
+    resetTelemetry();
+    setAllCellVoltages(3.7f);
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        setRegisterWord(CELL_MON_DEVICE(i), RDAUXA, 1, AUX_CODE(1.2f));
+    }
+
+    // Pull down pass, an open input floats low
+    runDiagnosticsUntil(AUX_OPEN_WIRE_PULL_DOWN_DIAG_STATE);
+    setRegisterWord(CELL_MON_DEVICE(4), RDAUXA, 1, AUX_CODE(0.1f));
+    setRegisterWord(CELL_MON_DEVICE(5), RDAUXA, 1, AUX_CODE(0.1f));
+    runDiagnosticsUntil(AUX_OPEN_WIRE_PULL_UP_DIAG_STATE);
+    CHECK(!auxOpenWireActive);
+
+    // Pull up pass, the same inputs float high, monitor 5 switched mux state in between
+    setRegisterWord(CELL_MON_DEVICE(4), RDAUXA, 1, AUX_CODE(3.0f));
+    setRegisterWord(CELL_MON_DEVICE(5), RDAUXA, 1, AUX_CODE(3.0f));
+    batteryData.cellMonitor[5].configGroupA.gpo10State = 1;
+    runDiagnosticsUntil(REDUNDANT_ADC_DIAG_STATE);
+
+    CHECK(taskData.cells.cellTempOpenWire[CELL_INDEX(4, 2)]);
+    CHECK(!taskData.cells.cellTempOpenWire[CELL_INDEX(4, 0)]);
+    CHECK(!taskData.cells.cellTempOpenWire[CELL_INDEX(4, 3)]);
+
+    // Readings taken on different mux states are not paired
+    CHECK(!taskData.cells.cellTempOpenWire[CELL_INDEX(5, 2)]);
+    CHECK(!taskData.cells.cellTempOpenWire[CELL_INDEX(5, 3)]);
+}
+
+// Deterministic jitter in [-range, range]
+static int32_t jitterUs(uint32_t *seed, int32_t range)
+{
+    *seed = (*seed * 1103515245) + 12345;
+    return (int32_t)((*seed >> 16) % (uint32_t)((2 * range) + 1)) - range;
+}
+
+static void testWakePrediction()
+{
+    resetTelemetry();
+
+    // Uncalibrated, the task falls back to its fixed period
+    predictNextConversion(&taskData);
+    CHECK(getTelemetryWakeDelayMs() == 0);
+
+    // A pack monitor converting every 1.02 ms, 255 us per phase count
+    const float conversionTimeMs = 1.02f;
+    const uint32_t phaseCountUs = 255;
+    const uint32_t windowUs = ACCUMULATION_WINDOW_PHASE_COUNTS * phaseCountUs;
+    batteryData.packMonitor.statusGroupE.revisionCode = 1;
+    taskData.packMonitor.adcConversionTimeMS = conversionTimeMs;
+
+    // Start close to the htim5 wrap so the prediction has to cross it
+    const uint32_t timerBase = 0xFFFF0000;
+    uint32_t seed = 1;
+    uint32_t timeUs = 3000;
+
+    for(uint32_t cycle = 0; cycle < 200; cycle++)
+    {
+        // Cycle start jitter and up to 100 us between the freeze and the timestamp
+        timeUs += (TELEMETRY_TASK_PERIOD_MS * MICROSECONDS_IN_MILLISECOND) + jitterUs(&seed, 2000);
+        snapshotTimeUs = timerBase + timeUs + jitterUs(&seed, 100);
+        taskData.packMonitor.adcConversionPhaseCounter = timeUs / phaseCountUs;
+
+        // The prediction is anchored on the pack monitor phase, here the raw snapshot time without a fit
+        packMonitorPhase.timeUs = snapshotTimeUs;
+
+        // The rest of the cycle runs before the prediction, occasionally past the window end
+        uint32_t cycleTimeUs = ((cycle % 16) == 0) ? (windowUs + 3000) : (4000);
+        htim5.counter = snapshotTimeUs + cycleTimeUs;
+
+        predictNextConversion(&taskData);
+
+        // Window ends fall on multiples of the window length from the pack monitor reset
+        int32_t wakeErrorUs = (int32_t)(((nextWakeTimeUs - timerBase) - CONVERSION_WAKE_MARGIN_US) % windowUs);
+        if(wakeErrorUs > (int32_t)(windowUs / 2))
+        {
+            wakeErrorUs -= windowUs;
+        }
+
+        // Past the window end by the margin, give or take the timestamp jitter and one phase count
+        CHECK(wakeErrorUs >= -100);
+        CHECK(wakeErrorUs <= (int32_t)(100 + phaseCountUs));
+
+        // The first such wake still ahead, an overrun skips to the window after
+        CHECK((int32_t)(nextWakeTimeUs - htim5.counter) > 0);
+        CHECK((int32_t)((nextWakeTimeUs - windowUs) - htim5.counter) <= 0);
+
+        // The delay rounds up to whole ticks and is capped
+        uint32_t remainingUs = nextWakeTimeUs - htim5.counter;
+        uint32_t delayMs = getTelemetryWakeDelayMs();
+        CHECK(delayMs <= MAX_WAKE_DELAY_MS);
+        if(remainingUs <= (MAX_WAKE_DELAY_MS * MICROSECONDS_IN_MILLISECOND))
+        {
+            CHECK((delayMs * MICROSECONDS_IN_MILLISECOND) >= remainingUs);
+            CHECK((delayMs * MICROSECONDS_IN_MILLISECOND) < (remainingUs + MICROSECONDS_IN_MILLISECOND));
+        }
+    }
+
+    // A chain init drops back to the fixed period until the conversion time is recalibrated
+    CHECK(initChain(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(getTelemetryWakeDelayMs() == 0);
+}
+
+static void testHardwareThresholdEncoding()
+{
+    resetTelemetry();
+
+    // Config B holds the UV code in bits 0-11 and the OV code in bits 12-23, 2.4 mV per code from 1.5 V
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        uint8_t *configB = chainModelGetRegister(CELL_MON_DEVICE(i), RDCFGB);
+        CHECK(configB[0] == 0x71);
+        CHECK(configB[1] == 0xB2);
+        CHECK(configB[2] == 0x49);
+    }
+}
+
+static void testCellOvUvFlagDecoding()
+{
+    resetTelemetry();
+
+    setOvUvFlags(0, 0x0001, 0x0000);
+    setOvUvFlags(4, 0x0000, 0x8020);
+    setOvUvFlags(7, 0x4000, 0x4000);
+
+    uint32_t clearsBefore = chainModelCommandCount(CLOVUV);
+    CHECK(runBlock(pollHardwareFaults) == TRANSACTION_SUCCESS);
+
+    CHECK(taskData.bmb[0].cellUnderVoltageFlags == 0x0001);
+    CHECK(taskData.bmb[0].cellOverVoltageFlags == 0x0000);
+    CHECK(taskData.bmb[4].cellUnderVoltageFlags == 0x0000);
+    CHECK(taskData.bmb[4].cellOverVoltageFlags == 0x8020);
+    CHECK(taskData.bmb[7].cellUnderVoltageFlags == 0x4000);
+    CHECK(taskData.bmb[7].cellOverVoltageFlags == 0x4000);
+    CHECK(taskData.bmb[1].cellUnderVoltageFlags == 0);
+    CHECK(taskData.bmb[1].cellOverVoltageFlags == 0);
+    CHECK(chainModelCommandCount(CLOVUV) == clearsBefore + 1);
+
+    // Flags are accumulated across polls and only cleared on the device when one was set
+    setOvUvFlags(0, 0x0000, 0x0000);
+    setOvUvFlags(4, 0x0000, 0x0000);
+    setOvUvFlags(7, 0x0000, 0x0000);
+    CHECK(runBlock(pollHardwareFaults) == TRANSACTION_SUCCESS);
+    CHECK(taskData.bmb[4].cellOverVoltageFlags == 0x8020);
+    CHECK(chainModelCommandCount(CLOVUV) == clearsBefore + 1);
+}
+
+static void testHardwareOvervoltageAlertLatency()
+{
+    resetTelemetry();
+
+    telemetryAlertCondition hardwareCondition;
+    telemetryAlertCondition softwareCondition;
+    Alert_S *hardwareAlert = findTelemetryAlert("HardwareOvervoltageFault", &hardwareCondition);
+    Alert_S *softwareAlert = findTelemetryAlert("OvervoltageFault", &softwareCondition);
+    CHECK(hardwareAlert && softwareAlert);
+    if(!hardwareAlert || !softwareAlert)
+    {
+        return;
+    }
+
+    // Alert timers start counting from now
+    configureTimer(&hardwareAlert->alertTimer, hardwareAlert->setTime_MS);
+    configureTimer(&softwareAlert->alertTimer, softwareAlert->setTime_MS);
+
+    // A cell crossing the comparator threshold between filtered voltage updates
+    taskData.maxCellVoltage = MAX_BRICK_FAULT_VOLTAGE + 0.01f;
+    taskData.bmb[3].cellOverVoltageFlags = 0x0100;
+
+    uint32_t elapsedMs = 0;
+    while((getAlertStatus(hardwareAlert) != ALERT_SET) && (elapsedMs <= OVERVOLTAGE_FAULT_ALERT_SET_TIME_MS))
+    {
+        hardwareAlert->alertConditionPresent = hardwareCondition(&taskData);
+        softwareAlert->alertConditionPresent = softwareCondition(&taskData);
+        runAlertMonitor(hardwareAlert);
+        runAlertMonitor(softwareAlert);
+        stubTickCount += TELEMETRY_TASK_PERIOD_MS;
+        elapsedMs += TELEMETRY_TASK_PERIOD_MS;
+    }
+
+    // The hardware path trips within a few cycles while the debounced software alert is still pending
+    CHECK(getAlertStatus(hardwareAlert) == ALERT_SET);
+    CHECK(elapsedMs <= (HARDWARE_OVERVOLTAGE_FAULT_ALERT_SET_TIME_MS + (2 * TELEMETRY_TASK_PERIOD_MS)));
+    CHECK(getAlertStatus(softwareAlert) == ALERT_CLEARED);
+}
+
+static void testOvercurrentThresholdEncoding()
+{
+    // Rounds to the nearest code of the selected gain
+    CHECK(encodeOvercurrentThreshold(25.0f, OVERCURRENT_GAIN_2_5_mV) == 10);
+    CHECK(encodeOvercurrentThreshold(26.2f, OVERCURRENT_GAIN_2_5_mV) == 10);
+    CHECK(encodeOvercurrentThreshold(26.3f, OVERCURRENT_GAIN_2_5_mV) == 11);
+    CHECK(encodeOvercurrentThreshold(25.0f, OVERCURRENT_GAIN_5_mV) == 5);
+    CHECK(encodeOvercurrentThreshold(1.2f, OVERCURRENT_GAIN_2_5_mV) == 0);
+    CHECK(encodeOvercurrentThreshold(1.3f, OVERCURRENT_GAIN_2_5_mV) == 1);
+
+    // Clamps to the 7 bit field and never encodes a negative threshold
+    CHECK(encodeOvercurrentThreshold(317.5f, OVERCURRENT_GAIN_2_5_mV) == 0x7F);
+    CHECK(encodeOvercurrentThreshold(318.75f, OVERCURRENT_GAIN_2_5_mV) == 0x7F);
+    CHECK(encodeOvercurrentThreshold(1000.0f, OVERCURRENT_GAIN_5_mV) == 0x7F);
+    CHECK(encodeOvercurrentThreshold(0.0f, OVERCURRENT_GAIN_2_5_mV) == 0);
+    CHECK(encodeOvercurrentThreshold(-25.0f, OVERCURRENT_GAIN_2_5_mV) == 0);
+
+    // The chain is programmed with the discharge limit across the reference shunt, 250 A * 100 uOhm = 25 mV
+    resetTelemetry();
+    uint8_t *configB = chainModelGetRegister(PACK_MON_DEVICE, RDCFGB);
+    CHECK(configB[0] == 10);
+    CHECK(configB[1] == 10);
+    CHECK(configB[2] == 10);
+}
+
+static void testOvercurrentFaultPoll()
+{
+    resetTelemetry();
+    CHECK(runBlock(pollHardwareFaults) == TRANSACTION_SUCCESS);
+    CHECK(!taskData.packMonitor.overcurrent1Fault);
+
+    // OC1 in status C byte 0 bit 0, OC2 in byte 1 bit 0
+    uint8_t *statusC = chainModelGetRegister(PACK_MON_DEVICE, RDSTATC);
+    statusC[0] = 0x01;
+    statusC[1] = 0x01;
+
+    uint32_t clearsBefore = chainModelCommandCount(CLRFLAG);
+    CHECK(runBlock(pollHardwareFaults) == TRANSACTION_SUCCESS);
+    CHECK(taskData.packMonitor.overcurrent1Fault);
+    CHECK(taskData.packMonitor.overcurrent2Fault);
+    CHECK(!taskData.packMonitor.overcurrent3Fault);
+    CHECK(chainModelCommandCount(CLRFLAG) == clearsBefore + 1);
+
+    // Once the device clears them no further clear is sent, the cycle keeps what it saw
+    statusC[0] = 0x00;
+    statusC[1] = 0x00;
+    CHECK(runBlock(pollHardwareFaults) == TRANSACTION_SUCCESS);
+    CHECK(!batteryData.packMonitor.statusGroupC.overcurrent1Fault);
+    CHECK(taskData.packMonitor.overcurrent1Fault);
+    CHECK(chainModelCommandCount(CLRFLAG) == clearsBefore + 1);
+}
+
+static void testDischargeNeed()
+{
+    CHECK(calculateDischargeMinutes(3.70f, 3.70f) == 0);
+    CHECK(calculateDischargeMinutes(3.60f, 3.70f) == 0);
+
+    // Charge between the two OCV points drained through the balancing resistor, rounded up
+    float dischargeMah = (lookup(3.80f, &socByOcvTable) - lookup(3.75f, &socByOcvTable)) * CELL_CAPACITY_MAH * NUM_PARALLEL_CELLS;
+    float dischargeMa = (3.80f / BALANCING_RESISTANCE_OHM) * MILLIAMPS_IN_AMP;
+    uint32_t minutes = calculateDischargeMinutes(3.80f, 3.75f);
+    CHECK(minutes == (uint32_t)ceilf((dischargeMah / dischargeMa) * MINUTES_IN_HOUR));
+    CHECK(minutes > 0);
+
+    // More charge to remove takes longer
+    CHECK(calculateDischargeMinutes(3.85f, 3.75f) > minutes);
+    CHECK(calculateDischargeMinutes(3.78f, 3.75f) <= minutes);
+}
+
+static void testPlanSizedToSmallestNeed()
+{
+    resetTelemetry();
+    setupBalancing(3.70f);
+    taskData.cells.cellVoltage[CELL_INDEX(0, 0)] = 3.80f;
+    taskData.cells.cellVoltage[CELL_INDEX(0, 1)] = 3.78f;
+    taskData.cells.cellVoltage[CELL_INDEX(5, 9)] = 3.76f;
+
+    CHECK(updateBalancingSwitches(&taskData) == TRANSACTION_SUCCESS);
+
+    // Only cells above the floor discharge, 50 mV over the lowest cell
+    CHECK_FLOAT(taskData.balancingFloor, 3.75f, 1e-6f);
+    CHECK(dischargeMask(0) == 0x0003);
+    CHECK(dischargeMask(5) == (1 << 9));
+    CHECK(dischargeMask(1) == 0);
+    CHECK(taskData.cells.cellBalancingActive[CELL_INDEX(0, 0)]);
+    CHECK(!taskData.cells.cellBalancingActive[CELL_INDEX(0, 2)]);
+
+    // One timer per device sized to its cell closest to the floor, programmed in long range steps
+    uint32_t minutes = calculateDischargeMinutes(3.78f, 3.75f);
+    uint32_t steps = (minutes + (DTM_LONG_RANGE_STEP / 2)) / DTM_LONG_RANGE_STEP;
+    CHECK(minutes > 63);
+    CHECK(chainModelGetRegister(CELL_MON_DEVICE(0), RDCFGB)[3] == (DTM_ENABLE | DTM_LONG_RANGE_ENABLE | steps));
+    CHECK(batteryData.cellMonitor[0].configGroupB.dischargeTimeoutMinutes == steps * DTM_LONG_RANGE_STEP);
+    CHECK(chainModelGetRegister(CELL_MON_DEVICE(1), RDCFGB)[3] == 0);
+
+    // Between plans nothing is written
+    uint32_t writes = chainModelCommandCount(WRCFGB);
+    stubTickCount += TELEMETRY_TASK_PERIOD_MS;
+    CHECK(updateBalancingSwitches(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(WRCFGB) == writes);
+
+    // The published state follows the device once its timer runs out
+    stubTickCount += (steps * DTM_LONG_RANGE_STEP * SECONDS_IN_MINUTE * MILLISECONDS_IN_SECOND);
+    taskData.balancingEnabled = false;
+    CHECK(updateBalancingSwitches(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(!taskData.cells.cellBalancingActive[CELL_INDEX(0, 0)]);
+    CHECK(!taskData.cells.cellBalancingActive[CELL_INDEX(5, 9)]);
+}
+
+static void testFailedPlanWriteRetried()
+{
+    resetTelemetry();
+    setupBalancing(3.70f);
+    taskData.cells.cellVoltage[CELL_INDEX(3, 4)] = 3.80f;
+    CHECK(updateBalancingSwitches(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(dischargeMask(3) == (1 << 4));
+
+    // An over temperature stop whose write fails
+    stubTickCount += TELEMETRY_TASK_PERIOD_MS;
+    taskData.maxCellTemp = 60.0f;
+    chainModel.spiErrors = 100;
+    CHECK(updateBalancingSwitches(&taskData) != TRANSACTION_SUCCESS);
+    chainModel.spiErrors = 0;
+    CHECK(dischargeMask(3) == (1 << 4));
+
+    // The temperature recovers straight away but the stop is still written on the next cycle
+    stubTickCount += TELEMETRY_TASK_PERIOD_MS;
+    taskData.maxCellTemp = 25.0f;
+    uint32_t writes = chainModelCommandCount(WRCFGB);
+    CHECK(updateBalancingSwitches(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(WRCFGB) == writes + 1);
+    CHECK(dischargeMask(3) == 0);
+    CHECK(!taskData.cells.cellBalancingActive[CELL_INDEX(3, 4)]);
+}
+
+static void testConfigBVerifiedBetweenPlans()
+{
+    resetTelemetry();
+    setupBalancing(3.70f);
+    CHECK(updateBalancingSwitches(&taskData) == TRANSACTION_SUCCESS);
+
+    // Matching thresholds are only read back
+    uint32_t writes = chainModelCommandCount(WRCFGB);
+    uint32_t reads = chainModelCommandCount(RDCFGB);
+    stubTickCount += CONFIG_B_VERIFY_PERIOD_MS;
+    CHECK(updateBalancingSwitches(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(RDCFGB) == reads + 1);
+    CHECK(chainModelCommandCount(WRCFGB) == writes);
+
+    // A device that lost its OV/UV thresholds is rewritten
+    uint8_t *configB = chainModelGetRegister(CELL_MON_DEVICE(6), RDCFGB);
+    configB[0] = 0;
+    configB[1] = 0;
+    configB[2] = 0;
+    stubTickCount += CONFIG_B_VERIFY_PERIOD_MS;
+    CHECK(updateBalancingSwitches(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(WRCFGB) == writes + 1);
+    CHECK(configB[0] == 0x71);
+    CHECK(configB[1] == 0xB2);
+    CHECK(configB[2] == 0x49);
+
+    // So is a pack monitor that lost its overcurrent thresholds
+    chainModelGetRegister(PACK_MON_DEVICE, RDCFGB)[1] = 0;
+    stubTickCount += CONFIG_B_VERIFY_PERIOD_MS;
+    CHECK(updateBalancingSwitches(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(WRCFGB) == writes + 2);
+    CHECK(chainModelGetRegister(PACK_MON_DEVICE, RDCFGB)[1] == 10);
+}
+
+static void testIdleReadsAveragedWindow()
+{
+    resetTelemetry();
+    taskData.packMonitor.shuntResistanceMicroOhms = 100.0f;
+
+    // Distinct raw, averaged and filtered cell results
+    setCellVoltagesOfType(0, 3.20f);
+    setCellVoltagesOfType(1, 3.60f);
+    setCellVoltagesOfType(2, 3.40f);
+
+    // The pack monitor answers the averaged cell reads with its accumulators, IACC1 in 1 uV and VBACC1 in 100 uV codes
+    setPackCurrentRegister(RDCVA, 5000);
+    setPackCurrentRegister(RDACA, ACCUMULATION_REGISTER_COUNT * 2000);
+    setPackRegister24(RDACB, ACCUMULATION_REGISTER_COUNT * 20000);
+
+    CHECK(updatePrimaryPackTelemetry(&taskData) == TRANSACTION_SUCCESS);
+
+    // Idle cells and pack values come from the same accumulation window
+    CHECK_FLOAT(taskData.cells.cellVoltage[CELL_INDEX(0, 0)], 3.60f, 1e-3f);
+    CHECK_FLOAT(taskData.cells.cellVoltage[CELL_INDEX(7, 15)], 3.60f, 1e-3f);
+    CHECK_FLOAT(taskData.packMonitor.packCurrent, 20.0f, 1e-3f);
+    CHECK_FLOAT(taskData.packMonitor.packVoltage, 2.0f * VBAT_DIVIDER_INV_GAIN, 1e-2f);
+    CHECK(frontVoltageData->packMonitor.currentAdc1uV == 5000);
+
+    // Balancing reads the raw results and the instantaneous current
+    taskData.balancingEnabled = true;
+    CHECK(updatePrimaryPackTelemetry(&taskData) == TRANSACTION_SUCCESS);
+    CHECK_FLOAT(taskData.cells.cellVoltage[CELL_INDEX(4, 8)], 3.20f, 1e-3f);
+    CHECK_FLOAT(taskData.packMonitor.packCurrent, 50.0f, 1e-3f);
+    CHECK(frontVoltageData->packMonitor.currentAdcAccumulator1uV == ACCUMULATION_REGISTER_COUNT * 2000);
+}
+
+// Counter errors injected on the next reads of one command
+static uint16_t counterErrorCommand;
+static uint32_t counterErrorsLeft;
+
+static void injectCounterErrors(uint16_t command)
+{
+    if((command == counterErrorCommand) && (counterErrorsLeft > 0))
+    {
+        counterErrorsLeft--;
+        chainModel.counterErrorReads = 1;
+    }
+}
+
+static void testRetryResumesAtCheckpoint()
+{
+    resetTelemetry();
+    Command_Block_Retry_S retry = {0};
+
+    // Status D answers with a bad command counter once, A and B were already verified by their own reads
+    counterErrorCommand = RDSTATD;
+    counterErrorsLeft = 1;
+    chainModel.commandHook = injectCounterErrors;
+
+    CHECK(runCommandBlock(updateDeviceStatus, &taskData, &retry) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(RDSTATA) == 1);
+    CHECK(chainModelCommandCount(RDSTATB) == 1);
+    CHECK(chainModelCommandCount(RDSTATD) == 2);
+    CHECK(chainModelCommandCount(RDSTATE) == 1);
+
+    // Only the steps from the checkpoint on are counted as retried
+    CHECK(retry.numRetries == 1);
+    CHECK(retry.numStepsRetried == 2);
+
+    // The next run of the block starts from its first step again
+    chainModel.commandHook = NULL;
+    CHECK(runCommandBlock(updateDeviceStatus, &taskData, &retry) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(RDSTATA) == 2);
+    CHECK(retry.numRetries == 1);
+}
+
+static void testRetryLimit()
+{
+    resetTelemetry();
+    Command_Block_Retry_S retry = {0};
+
+    // A counter error on every attempt gives up after the retry limit without touching the earlier steps again
+    counterErrorCommand = RDSTATB;
+    counterErrorsLeft = NUM_COMMAND_BLOCK_RETRYS;
+    chainModel.commandHook = injectCounterErrors;
+
+    CHECK(runCommandBlock(updateDeviceStatus, &taskData, &retry) == TRANSACTION_COMMAND_COUNTER_ERROR);
+    CHECK(chainModelCommandCount(RDSTATA) == 1);
+    CHECK(chainModelCommandCount(RDSTATB) == NUM_COMMAND_BLOCK_RETRYS);
+    CHECK(chainModelCommandCount(RDSTATD) == 0);
+    CHECK(retry.numRetries == (NUM_COMMAND_BLOCK_RETRYS - 1));
+
+    chainModel.commandHook = NULL;
+}
+
+static void testFailedReadKeepsLastGoodData()
+{
+    resetTelemetry();
+    taskData.packMonitor.shuntResistanceMicroOhms = 100.0f;
+
+    setCellVoltagesOfType(1, 3.60f);
+    setPackCurrentRegister(RDACA, ACCUMULATION_REGISTER_COUNT * 2000);
+    CHECK(updatePrimaryPackTelemetry(&taskData) == TRANSACTION_SUCCESS);
+    ADBMS_VoltageData *goodData = frontVoltageData;
+    uint32_t sequence = voltageDataSequence;
+
+    // The next read fails on its last register, after the earlier ones were decoded into the back buffer
+    setCellVoltagesOfType(1, 3.90f);
+    setPackCurrentRegister(RDACA, ACCUMULATION_REGISTER_COUNT * 3000);
+    counterErrorCommand = cellRegisterCodes[1][NUM_CELLV_REGISTERS - 1];
+    counterErrorsLeft = 1;
+    chainModel.commandHook = injectCounterErrors;
+    CHECK(updatePrimaryPackTelemetry(&taskData) == TRANSACTION_COMMAND_COUNTER_ERROR);
+    chainModel.commandHook = NULL;
+    CHECK_FLOAT(batteryData.voltageData->cellMonitor[0].cellVoltage[0], 3.90f, 1e-3f);
+
+    // Nothing was flipped, the front and everything translated from it still hold the last good read
+    CHECK(frontVoltageData == goodData);
+    CHECK(voltageDataSequence == sequence);
+    CHECK_FLOAT(frontVoltageData->cellMonitor[0].cellVoltage[0], 3.60f, 1e-3f);
+    CHECK_FLOAT(taskData.cells.cellVoltage[CELL_INDEX(0, 0)], 3.60f, 1e-3f);
+    CHECK_FLOAT(taskData.packMonitor.packCurrent, 20.0f, 1e-3f);
+
+    // The repeated read is published whole with a pointer flip
+    CHECK(updatePrimaryPackTelemetry(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(frontVoltageData != goodData);
+    CHECK(batteryData.voltageData == goodData);
+    CHECK(voltageDataSequence == (sequence + 1));
+    CHECK_FLOAT(taskData.cells.cellVoltage[CELL_INDEX(7, 15)], 3.90f, 1e-3f);
+    CHECK_FLOAT(taskData.packMonitor.packCurrent, 30.0f, 1e-3f);
+
+    ADBMS_VoltageData copy;
+    CHECK(getBatteryVoltageData(&copy) == (sequence + 1));
+    CHECK(memcmp(&copy, frontVoltageData, sizeof(copy)) == 0);
+}
+
+static void testBalancingSettleOverlap()
+{
+    resetTelemetry();
+    taskData.balancingEnabled = true;
+
+    // Reads overlapped with the settle window only leave the remainder to wait out
+    htim5.counter = 1000;
+    CHECK(runBlock(prepareReadCycle) == TRANSACTION_SUCCESS);
+    htim5.counter += 600;
+    CHECK(runBlock(startNewReadCycle) == TRANSACTION_SUCCESS);
+    CHECK(taskData.balancingSettleTimeUs == BALANCING_MUTE_SETTLE_US);
+    CHECK(chainModelCommandCount(UNMUTE) == 1);
+
+    // Reads that outlast the window add no wait
+    CHECK(runBlock(prepareReadCycle) == TRANSACTION_SUCCESS);
+    htim5.counter += BALANCING_MUTE_SETTLE_US + 500;
+    CHECK(runBlock(startNewReadCycle) == TRANSACTION_SUCCESS);
+    CHECK(taskData.balancingSettleTimeUs == BALANCING_MUTE_SETTLE_US + 500);
+
+    // A snapshot retaken after the unmute mutes again and settles for the full window
+    uint32_t mutesBefore = chainModelCommandCount(MUTE);
+    CHECK(runBlock(prepareReadCycle) == TRANSACTION_SUCCESS);
+    htim5.counter += 1500;
+    counterErrorCommand = RDSID;
+    counterErrorsLeft = 1;
+    chainModel.commandHook = injectCounterErrors;
+    CHECK(runBlock(startNewReadCycle) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(MUTE) == mutesBefore + 2);
+    CHECK(taskData.balancingSettleTimeUs == BALANCING_MUTE_SETTLE_US);
+
+    chainModel.commandHook = NULL;
+}
+
+// Write samples firstIndex up to lastIndex as the sampler would, one per millisecond with current equal to the index
+static void fillCurrentSamples(uint32_t firstIndex, uint32_t lastIndex)
+{
+    for(uint32_t i = firstIndex; i != lastIndex; i++)
+    {
+        currentSampleBuffer[i % CURRENT_SAMPLE_BUFFER_SIZE] = (Current_Sample_S){ .timeUs = i * 1000, .instantCurrent = (float)i };
+    }
+    currentSampleWriteIndex = lastIndex;
+}
+
+static void testCurrentSamplesInOrder()
+{
+    fillCurrentSamples(0, 10);
+
+    Current_Sample_S samples[CURRENT_SAMPLE_BUFFER_SIZE];
+    uint32_t readIndex = 2;
+    CHECK(getCurrentSamples(samples, 4, &readIndex) == 4);
+    CHECK(readIndex == 6);
+    CHECK_FLOAT(samples[0].instantCurrent, 2.0f, 0.0f);
+    CHECK_FLOAT(samples[3].instantCurrent, 5.0f, 0.0f);
+
+    CHECK(getCurrentSamples(samples, CURRENT_SAMPLE_BUFFER_SIZE, &readIndex) == 4);
+    CHECK(readIndex == 10);
+    CHECK(getCurrentSamples(samples, CURRENT_SAMPLE_BUFFER_SIZE, &readIndex) == 0);
+}
+
+static void testCurrentSamplesLappedReader()
+{
+    // A reader a whole buffer behind gets every slot except the one the next sample overwrites
+    fillCurrentSamples(0, 1000);
+
+    Current_Sample_S samples[CURRENT_SAMPLE_BUFFER_SIZE];
+    uint32_t readIndex = 0;
+    CHECK(getCurrentSamples(samples, CURRENT_SAMPLE_BUFFER_SIZE, &readIndex) == (CURRENT_SAMPLE_BUFFER_SIZE - 1));
+    CHECK(readIndex == 1000);
+    CHECK_FLOAT(samples[0].instantCurrent, (float)(1000 - CURRENT_SAMPLE_BUFFER_SIZE + 1), 0.0f);
+    CHECK_FLOAT(samples[CURRENT_SAMPLE_BUFFER_SIZE - 2].instantCurrent, 999.0f, 0.0f);
+}
+
+static void testCurrentSamplesIndexWrap()
+{
+    // The write index wrapping through zero must not look like a lapped reader
+    uint32_t firstIndex = UINT32_MAX - 3;
+    fillCurrentSamples(firstIndex, 4);
+
+    Current_Sample_S samples[CURRENT_SAMPLE_BUFFER_SIZE];
+    uint32_t readIndex = firstIndex;
+    CHECK(getCurrentSamples(samples, CURRENT_SAMPLE_BUFFER_SIZE, &readIndex) == 8);
+    CHECK(readIndex == 4);
+    CHECK_FLOAT(samples[7].instantCurrent, 3.0f, 0.0f);
+}
+
+static void testCurrentSampleGrid()
+{
+    resetTelemetry();
+    currentSampleWriteIndex = 0;
+    currentSamplingEnabled = true;
+    htim5.counter = 5000;
+    nextCurrentSampleTimeUs = 5000;
+
+    // A due sample is taken and the sampler asks to sleep until the next grid point
+    CHECK(sampleHighRateCurrent() == HIGH_RATE_CURRENT_PERIOD_US);
+    CHECK(currentSampleWriteIndex == 1);
+    CHECK(currentSampleBuffer[0].timeUs == 5000);
+
+    // Woken early it only reports the time left, without touching the bus
+    uint32_t transactionsBefore = chainModel.numTransactions;
+    htim5.counter += 400;
+    CHECK(sampleHighRateCurrent() == HIGH_RATE_CURRENT_PERIOD_US - 400);
+    CHECK(chainModel.numTransactions == transactionsBefore);
+    CHECK(currentSampleWriteIndex == 1);
+
+    // After a long read cycle the grid restarts rather than bursting catch up samples
+    htim5.counter += 10 * HIGH_RATE_CURRENT_PERIOD_US;
+    CHECK(sampleHighRateCurrent() == HIGH_RATE_CURRENT_PERIOD_US);
+    CHECK(sampleHighRateCurrent() == HIGH_RATE_CURRENT_PERIOD_US);
+    CHECK(currentSampleWriteIndex == 2);
+
+    // A bus error stops sampling until the next read cycle
+    chainModel.spiErrors = 1;
+    htim5.counter += HIGH_RATE_CURRENT_PERIOD_US;
+    CHECK(sampleHighRateCurrent() == 0);
+    CHECK(!currentSamplingEnabled);
+    CHECK(currentSampleWriteIndex == 2);
+    chainModel.spiErrors = 0;
+}
+
+static void testCurrentAtTime()
+{
+    fillCurrentSamples(0, 200);
+    float current = 0.0f;
+
+    // Between two samples the current is interpolated
+    CHECK(getCurrentAtTime(150500, &current));
+    CHECK_FLOAT(current, 150.5f, 1e-3f);
+
+    // Past the newest sample it is held within the gap limit, then refused
+    CHECK(getCurrentAtTime(199000 + CURRENT_INTERPOLATION_MAX_GAP_US, &current));
+    CHECK_FLOAT(current, 199.0f, 0.0f);
+    CHECK(!getCurrentAtTime(199000 + CURRENT_INTERPOLATION_MAX_GAP_US + 1, &current));
+
+    // Once the buffer has wrapped the oldest slot is never used, earlier times hold the next oldest within the gap limit
+    fillCurrentSamples(0, 1000);
+    uint32_t oldestIndex = 1000 - CURRENT_SAMPLE_BUFFER_SIZE + 1;
+    CHECK(getCurrentAtTime((oldestIndex * 1000) - CURRENT_INTERPOLATION_MAX_GAP_US, &current));
+    CHECK_FLOAT(current, (float)oldestIndex, 0.0f);
+    CHECK(!getCurrentAtTime((oldestIndex * 1000) - CURRENT_INTERPOLATION_MAX_GAP_US - 1, &current));
+}
+
+static void testConversionEndTime()
+{
+    Conversion_Phase_S phase = {0};
+
+    // Without a calibration data is stamped with its capture time
+    snapshotTimeUs = 10000;
+    updateConversionPhase(&phase, 8);
+    CHECK(getConversionEndTimeUs(&phase, 10250, 4) == 10250);
+
+    // 8 phase counts in 800 us calibrates 100 us per count
+    snapshotTimeUs = 10800;
+    updateConversionPhase(&phase, 16);
+    CHECK_FLOAT(phase.phaseTimeUs, 100.0f, 1e-3f);
+
+    // 2.5 counts after a boundary steps back to it, including across the 13 bit counter rollover
+    CHECK(getConversionEndTimeUs(&phase, 11050, 4) == 10800);
+    CHECK(getConversionEndTimeUs(&phase, 11250, 4) == 11200);
+
+    snapshotTimeUs = 11600;
+    updateConversionPhase(&phase, (16 + 8) & MAX_13BIT_UINT);
+    phase.phaseCount = MAX_13BIT_UINT - 1;
+    snapshotTimeUs = 12400;
+    updateConversionPhase(&phase, 6);
+    CHECK_FLOAT(phase.phaseTimeUs, 100.0f, 1e-3f);
+    CHECK(getConversionEndTimeUs(&phase, 12450, 4) == 12200);
+}
+
+static uint32_t muxWriteTimeUs;
+static uint32_t auxStartTimeUs[2];
+static uint32_t numAuxStarts;
+static uint32_t auxReadTimeUs;
+
+static void recordMuxSequence(uint16_t command)
+{
+    if(command == WRCFGA)
+    {
+        muxWriteTimeUs = htim5.counter;
+    }
+    else if(IS_ADAX(command))
+    {
+        if(numAuxStarts < 2)
+        {
+            auxStartTimeUs[numAuxStarts] = htim5.counter;
+        }
+        numAuxStarts++;
+    }
+    else if((command == RDAUXA) && (numAuxStarts == 1))
+    {
+        auxReadTimeUs = htim5.counter;
+    }
+
+    injectCounterErrors(command);
+}
+
+static void testAlternateTemperatureSequence()
+{
+    resetTelemetry();
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        nextMuxState[i] = i & 1;
+    }
+
+    htim5.counter = 1000;
+    numAuxStarts = 0;
+    counterErrorCommand = RDCFGA;
+    counterErrorsLeft = 0;
+    chainModel.commandHook = recordMuxSequence;
+    uint32_t muxWritesBefore = chainModelCommandCount(WRCFGA);
+
+    Command_Block_Retry_S retry = {0};
+    CHECK(runCommandBlock(updateAlternateTemperatures, &taskData, &retry) == TRANSACTION_SUCCESS);
+
+    // One mux write to the half missing from the snapshot
+    CHECK(chainModelCommandCount(WRCFGA) == muxWritesBefore + 1);
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        CHECK(((chainModelGetRegister(CELL_MON_DEVICE(i), RDCFGA)[4] >> 1) & 1) == nextMuxState[i]);
+    }
+
+    // The conversion waits out the mux settle time, and the read waits out the conversion
+    CHECK(numAuxStarts == 2);
+    CHECK((auxStartTimeUs[0] - muxWriteTimeUs) >= TEMP_MUX_SETTLE_US);
+    CHECK(taskData.tempMuxSettleTimeUs == (auxStartTimeUs[0] - muxWriteTimeUs));
+    CHECK((auxReadTimeUs - auxStartTimeUs[0]) >= AUX_CONVERSION_TIME_US);
+
+    // Only the alternate half is stamped with the live conversion
+    for(uint32_t i = 0; i < NUM_CELL_MON_IN_ACCUMULATOR; i++)
+    {
+        for(uint32_t j = 0; j < NUM_CELL_TEMP_ADCS; j++)
+        {
+            CHECK(taskData.cells.cellTempSampleTimeUs[CELL_INDEX(i, (j * 2) + nextMuxState[i])] == auxStartTimeUs[0]);
+            CHECK(taskData.cells.cellTempSampleTimeUs[CELL_INDEX(i, (j * 2) + !nextMuxState[i])] == 0);
+        }
+    }
+
+    // A failed verify retries from the restarted conversion, without switching the mux or reading the half again
+    numAuxStarts = 0;
+    counterErrorsLeft = 1;
+    uint32_t readsBefore = chainModelCommandCount(RDCFGA);
+    uint32_t auxReadsBefore = chainModelCommandCount(RDAUXA);
+    CHECK(runCommandBlock(updateAlternateTemperatures, &taskData, &retry) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(WRCFGA) == muxWritesBefore + 2);
+    CHECK(chainModelCommandCount(RDAUXA) == auxReadsBefore + 1);
+    CHECK(numAuxStarts == 3);
+    CHECK(chainModelCommandCount(RDCFGA) == readsBefore + 2);
+    CHECK(retry.numRetries == 1);
+    CHECK(retry.numStepsRetried == 2);
+
+    chainModel.commandHook = NULL;
+}
+
+static uint32_t findCommandBlock(TRANSACTION_STATUS_E (*commandBlock)(telemetryTaskData_S*))
+{
+    for(uint32_t i = 0; i < NUM_COMMAND_BLOCKS; i++)
+    {
+        if(commandBlocks[i].commandBlock == commandBlock)
+        {
+            return i;
+        }
+    }
+    return NUM_COMMAND_BLOCKS;
+}
+
+static void testGovernorDeferral()
+{
+    resetTelemetry();
+    uint32_t diagnosticsBlock = findCommandBlock(runDeviceDiagnostics);
+    CHECK(diagnosticsBlock < NUM_COMMAND_BLOCKS);
+    CHECK(commandBlocks[diagnosticsBlock].optional);
+
+    bool rateGroupScheduled[NUM_RATE_GROUPS] = { false };
+    rateGroupScheduled[RATE_GROUP_CELL_VOLTAGE] = true;
+    rateGroupScheduled[commandBlocks[diagnosticsBlock].rateGroup] = true;
+
+    commandBlockState[diagnosticsBlock].costEstimateUs = 2000;
+    cycleStartTimeUs = 1000000;
+
+    // Plenty of budget left
+    htim5.counter = cycleStartTimeUs + 5000;
+    CHECK(!deferOptionalBlock(diagnosticsBlock, rateGroupScheduled));
+
+    // The required blocks still to come are reserved ahead of the optional one
+    uint32_t laterRequiredBlock = findCommandBlock(updateBalancingSwitches);
+    CHECK(laterRequiredBlock > diagnosticsBlock);
+    CHECK(!commandBlocks[laterRequiredBlock].optional);
+    commandBlockState[laterRequiredBlock].costEstimateUs = CYCLE_BUDGET_US - 5000;
+    CHECK(deferOptionalBlock(diagnosticsBlock, rateGroupScheduled));
+
+    // A deferred block is owed a run even when its rate group is not scheduled
+    rateGroupScheduled[commandBlocks[diagnosticsBlock].rateGroup] = false;
+    CHECK(!blockScheduled(diagnosticsBlock, rateGroupScheduled));
+    commandBlockState[diagnosticsBlock].deferred = true;
+    CHECK(blockScheduled(diagnosticsBlock, rateGroupScheduled));
+
+    // Deferral is capped so a persistently slow cycle cannot starve the block
+    commandBlockState[diagnosticsBlock].consecutiveDeferrals = MAX_CONSECUTIVE_DEFERRALS - 1;
+    CHECK(deferOptionalBlock(diagnosticsBlock, rateGroupScheduled));
+    commandBlockState[diagnosticsBlock].consecutiveDeferrals = MAX_CONSECUTIVE_DEFERRALS;
+    CHECK(!deferOptionalBlock(diagnosticsBlock, rateGroupScheduled));
+}
+
+static void testGovernorCycle()
+{
+    resetTelemetry();
+    setAllCellVoltages(3.7f);
+    taskData.chainInitialized = true;
+
+    uint32_t diagnosticsBlock = findCommandBlock(runDeviceDiagnostics);
+    uint32_t statisticsBlock = findCommandBlock(updatePackStatistics);
+
+    // Keep the idle pack from parking part way through
+    lastParkActivityTick = HAL_GetTick();
+
+    // A required block expected to fill the budget pushes diagnostics out until the deferral cap
+    for(uint32_t cycle = 0; cycle < MAX_CONSECUTIVE_DEFERRALS; cycle++)
+    {
+        commandBlockState[statisticsBlock].costEstimateUs = CYCLE_BUDGET_US;
+        CHECK(updateBatteryTelemetry(&taskData) == TRANSACTION_SUCCESS);
+        stubTickCount += TELEMETRY_TASK_PERIOD_MS;
+        CHECK(commandBlockState[diagnosticsBlock].deferred);
+        CHECK(commandBlockState[diagnosticsBlock].consecutiveDeferrals == cycle + 1);
+    }
+    CHECK(taskData.cycleBudget.numDeferredBlocks == MAX_CONSECUTIVE_DEFERRALS);
+
+    // Required blocks are never deferred, and the capped block then runs anyway
+    commandBlockState[statisticsBlock].costEstimateUs = CYCLE_BUDGET_US;
+    CHECK(updateBatteryTelemetry(&taskData) == TRANSACTION_SUCCESS);
+    CHECK(!commandBlockState[diagnosticsBlock].deferred);
+    CHECK(commandBlockState[diagnosticsBlock].consecutiveDeferrals == 0);
+    CHECK(taskData.cycleBudget.numDeferredBlocks == MAX_CONSECUTIVE_DEFERRALS);
+
+    // The cycle time is recorded against the period
+    CHECK(taskData.cycleBudget.worstCycleTimeUs >= taskData.cycleBudget.lastCycleTimeUs);
+    CHECK(taskData.cycleBudget.numOverruns == 0);
+}
+
+static void testBlockCostEstimate()
+{
+    // Increases are tracked at once, decreases relax by a fraction per cycle
+    Command_Block_State_S blockState = { 0 };
+    updateBlockCost(&blockState, 1000);
+    CHECK(blockState.costEstimateUs == 1000);
+    updateBlockCost(&blockState, 200);
+    CHECK(blockState.costEstimateUs == (1000 - (800 >> BLOCK_COST_DECAY_SHIFT)));
+}
+
+// Fill the counter buffer with one read per cycle at 250 us per phase count, a few us of timer jitter and two late or early reads
+static void fillConversionCounters(uint32_t numPoints, uint32_t baseTimeUs)
+{
+    memset(conversionCounterBuffer, 0, sizeof(conversionCounterBuffer));
+    for(uint32_t i = 0; i < numPoints; i++)
+    {
+        uint32_t counter = 1000 + (100 * i);
+        int32_t jitterUs = (int32_t)((i * 37) % 21) - 10;
+        jitterUs += (i == 20) ? (3000) : ((i == 60) ? (-2500) : (0));
+
+        conversionCounterBuffer[COUNTER_INDEX][i] = counter;
+        conversionCounterBuffer[TIMER_INDEX][i] = baseTimeUs + ((counter - 1000) * 250) + jitterUs;
+    }
+}
+
+static void testConversionFitOutliers()
+{
+    resetTelemetry();
+
+    // The timer wraps part way through the buffer
+    uint32_t baseTimeUs = UINT32_MAX - 1000000;
+    uint32_t newestIndex = CONVERSION_BUFFER_SIZE - 1;
+    fillConversionCounters(CONVERSION_BUFFER_SIZE, baseTimeUs);
+
+    uint32_t fittedTimeUs = 0;
+    fitConversionPhase(&taskData, newestIndex, &fittedTimeUs);
+
+    // The two outliers are rejected and the period and newest read time come from the inliers
+    CHECK_FLOAT(taskData.packMonitor.adcConversionTimeMS, (250.0f * PHASE_COUNTS_PER_CONVERSION) / MICROSECONDS_IN_MILLISECOND, 1e-4f);
+    CHECK_FLOAT(taskData.packMonitor.adcPhaseFitConfidence, (float)(CONVERSION_BUFFER_SIZE - 2) / CONVERSION_BUFFER_SIZE, 1e-6f);
+    CHECK(taskData.packMonitor.adcPhaseFitResidualUs < 10.0f);
+
+    uint32_t expectedTimeUs = baseTimeUs + (newestIndex * 100 * 250);
+    CHECK(abs((int32_t)(fittedTimeUs - expectedTimeUs)) <= 5);
+
+    // Too few points leave the previous calibration alone
+    taskData.packMonitor.adcConversionTimeMS = 2.0f;
+    fillConversionCounters(CONVERSION_FIT_MIN_POINTS - 1, baseTimeUs);
+    fittedTimeUs = 0;
+    fitConversionPhase(&taskData, CONVERSION_FIT_MIN_POINTS - 2, &fittedTimeUs);
+    CHECK_FLOAT(taskData.packMonitor.adcConversionTimeMS, 2.0f, 0.0f);
+    CHECK(fittedTimeUs == 0);
+}
+
+// Run the fusion stage until the divergence filter settles, with the overcurrent ADC reading referenceA
+static void runCurrentFusion(float current1A, float current2A, float referenceA)
+{
+    float shuntResistance = SHUNT_REF_RESISTANCE_UOHM;
+    taskData.packMonitor.shuntResistanceMicroOhms = shuntResistance;
+    taskData.packMonitor.currentChannelDivergence = 0.0f;
+    frontVoltageData->packMonitor.overcurrentStatusGroup.overCurrentAdc1 = (referenceA * shuntResistance) / MICROVOLTS_PER_MILLIVOLT;
+
+    for(uint32_t i = 0; i < 100; i++)
+    {
+        updateCurrentFusion(&taskData, current1A * shuntResistance, current2A * shuntResistance);
+    }
+}
+
+static void testCurrentFusionAgreeing()
+{
+    resetTelemetry();
+    runCurrentFusion(100.0f, 101.0f, 100.0f);
+    CHECK(taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_1] == GOOD);
+    CHECK(taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_2] == GOOD);
+    CHECK_FLOAT(fuseCurrentChannels(100.0f, 102.0f), 101.0f, 1e-3f);
+}
+
+static void testCurrentFusionTieBreak()
+{
+    resetTelemetry();
+
+    // Far enough apart for the overcurrent ADC to tell which channel drifted
+    runCurrentFusion(100.0f, 200.0f, 100.0f);
+    CHECK(taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_1] == GOOD);
+    CHECK(taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_2] == BAD);
+    CHECK_FLOAT(fuseCurrentChannels(100.0f, 200.0f), 100.0f, 0.0f);
+
+    // Charge current reads negative on every channel
+    runCurrentFusion(-200.0f, -100.0f, -100.0f);
+    CHECK(taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_1] == BAD);
+    CHECK(taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_2] == GOOD);
+    CHECK_FLOAT(fuseCurrentChannels(-200.0f, -100.0f), -100.0f, 0.0f);
+}
+
+static void testCurrentFusionWithinReferenceResolution()
+{
+    resetTelemetry();
+
+    // Closer than one overcurrent ADC count, neither channel is picked and both are flagged
+    runCurrentFusion(100.0f, 110.0f, 100.0f);
+    CHECK(taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_1] == BAD);
+    CHECK(taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_2] == BAD);
+    CHECK_FLOAT(fuseCurrentChannels(100.0f, 110.0f), 105.0f, 1e-3f);
+}
+
+static void testCurrentFusionNoiseAndDrift()
+{
+    resetTelemetry();
+    float shuntResistance = SHUNT_REF_RESISTANCE_UOHM;
+    taskData.packMonitor.shuntResistanceMicroOhms = shuntResistance;
+    frontVoltageData->packMonitor.overcurrentStatusGroup.overCurrentAdc1 = (50.0f * shuntResistance) / MICROVOLTS_PER_MILLIVOLT;
+
+    // Independent noise on each channel, averaging agreeing channels roughly halves the noise power
+    uint32_t seed = 45;
+    float channelSquaredError = 0.0f;
+    float fusedSquaredError = 0.0f;
+    for(uint32_t i = 0; i < 1000; i++)
+    {
+        float current1 = 50.0f + (float)jitterUs(&seed, 200) / 100.0f;
+        float current2 = 50.0f + (float)jitterUs(&seed, 200) / 100.0f;
+        updateCurrentFusion(&taskData, current1 * shuntResistance, current2 * shuntResistance);
+        CHECK(taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_1] == GOOD);
+
+        float fused = fuseCurrentChannels(current1, current2);
+        channelSquaredError += (current1 - 50.0f) * (current1 - 50.0f);
+        fusedSquaredError += (fused - 50.0f) * (fused - 50.0f);
+    }
+    CHECK(fusedSquaredError < (0.6f * channelSquaredError));
+
+    // A slow drift on channel 2 first flags both channels, then is excluded once the overcurrent ADC can resolve it
+    bool suspect = false;
+    bool excluded = false;
+    float driftA = 0.0f;
+    for(uint32_t i = 0; (i < 2000) && !excluded; i++)
+    {
+        driftA += 0.05f;
+        updateCurrentFusion(&taskData, 50.0f * shuntResistance, (50.0f + driftA) * shuntResistance);
+        bool channel1Bad = (taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_1] == BAD);
+        bool channel2Bad = (taskData.packMonitor.currentChannelStatus[CURRENT_CHANNEL_2] == BAD);
+        suspect |= (channel1Bad && channel2Bad);
+        excluded = (!channel1Bad && channel2Bad);
+    }
+    CHECK(suspect);
+    CHECK(excluded);
+    CHECK(driftA > ((HW_OVERCURRENT_ADC_LSB_MV * MICROVOLTS_PER_MILLIVOLT) / shuntResistance));
+    CHECK_FLOAT(fuseCurrentChannels(50.0f, 50.0f + driftA), 50.0f, 0.0f);
+}
+
+// Step the shunt thermal model once per telemetry period with a constant pack current
+static void stepShuntThermalModel(float packCurrent, uint32_t numSteps, uint32_t periodUs)
+{
+    taskData.packMonitor.packCurrent = packCurrent;
+    for(uint32_t i = 0; i < numSteps; i++)
+    {
+        snapshotTimeUs += periodUs;
+        updateShuntThermalModel(&taskData);
+    }
+}
+
+static void testShuntThermalStepResponse()
+{
+    resetTelemetry();
+    uint32_t periodUs = TELEMETRY_TASK_PERIOD_MS * MICROSECONDS_IN_MILLISECOND;
+    uint32_t stepsPerTimeConstant = (uint32_t)((SHUNT_THERMAL_TIME_CONSTANT_S * MICROSECONDS_IN_MILLISECOND * MILLISECONDS_IN_SECOND) / periodUs);
+
+    // With no current the element sits at the mean of the good sensors
+    taskData.packMonitor.shuntTemp1 = 30.0f;
+    taskData.packMonitor.shuntTemp1Status = GOOD;
+    taskData.packMonitor.shuntTemp2 = 34.0f;
+    taskData.packMonitor.shuntTemp2Status = GOOD;
+    snapshotTimeUs = 0xFFFF0000;
+    stepShuntThermalModel(0.0f, 1, 0);
+    CHECK_FLOAT(taskData.packMonitor.shuntElementTemp, 32.0f, 1e-3f);
+    CHECK_FLOAT(taskData.packMonitor.shuntResistanceMicroOhms, SHUNT_REF_RESISTANCE_UOHM + (SHUNT_RESISTANCE_GAIN_UOHM * 7.0f), 1e-4f);
+
+    // A current step settles first order, the timer wrapping on the way
+    float stepCurrent = 500.0f;
+    stepShuntThermalModel(stepCurrent, stepsPerTimeConstant, periodUs);
+    float finalRise = ((stepCurrent * stepCurrent * taskData.packMonitor.shuntResistanceMicroOhms) / MICROWATTS_PER_WATT) * SHUNT_THERMAL_RESISTANCE_C_PER_W;
+    float riseAtTimeConstant = taskData.packMonitor.shuntElementTemp - 32.0f;
+    CHECK((riseAtTimeConstant > (0.60f * finalRise)) && (riseAtTimeConstant < (0.66f * finalRise)));
+
+    stepShuntThermalModel(stepCurrent, 9 * stepsPerTimeConstant, periodUs);
+    float steadyTemp = taskData.packMonitor.shuntElementTemp;
+    CHECK_FLOAT(steadyTemp - 32.0f, finalRise, 0.01f * finalRise);
+    CHECK_FLOAT(taskData.packMonitor.shuntResistanceMicroOhms, SHUNT_REF_RESISTANCE_UOHM + (SHUNT_RESISTANCE_GAIN_UOHM * (steadyTemp - SHUNT_REF_TEMP_C)), 1e-4f);
+
+    // Removing the current cools the element back toward the sensors
+    stepShuntThermalModel(0.0f, stepsPerTimeConstant, periodUs);
+    CHECK_FLOAT(taskData.packMonitor.shuntElementTemp - 32.0f, 0.37f * finalRise, 0.03f * finalRise);
+
+    // A long gap such as returning from park settles in one step instead of overshooting
+    stepShuntThermalModel(stepCurrent, 1, 60 * MICROSECONDS_IN_MILLISECOND * MILLISECONDS_IN_SECOND);
+    CHECK(taskData.packMonitor.shuntElementTemp <= (32.0f + finalRise + 0.1f));
+    CHECK(taskData.packMonitor.shuntElementTemp > (32.0f + (0.9f * finalRise)));
+
+    // Without a good sensor the element is referenced to the calibration temperature
+    taskData.packMonitor.shuntTemp1Status = BAD;
+    taskData.packMonitor.shuntTemp2Status = BAD;
+    stepShuntThermalModel(0.0f, 20 * stepsPerTimeConstant, periodUs);
+    CHECK_FLOAT(taskData.packMonitor.shuntElementTemp, SHUNT_REF_TEMP_C, 0.01f);
+}
+
+// Link voltage of an RC precharge from 0 V towards the pack
+static float prechargeLinkVoltage(float packVoltage, float timeConstantS, uint32_t elapsedUs)
+{
+    return packVoltage * (1.0f - expf(-((float)elapsedUs / MICROSECONDS_IN_SECOND) / timeConstantS));
+}
+
+static void testPrechargeFit()
+{
+    resetTelemetry();
+    float packVoltage = 400.0f;
+    float timeConstantS = 0.2f;
+
+    // A discharged link against a valid pack arms detection, the bleed down is followed without starting
+    updatePrechargeState(packVoltage, 3.0f, 0);
+    CHECK(prechargeState == PRECHARGE_ARMED);
+    updatePrechargeState(packVoltage, 1.0f, PRECHARGE_IDLE_PERIOD_US);
+    CHECK(prechargeState == PRECHARGE_ARMED);
+    CHECK_FLOAT(prechargeBaselineVoltage, 1.0f, 0.0f);
+
+    // Sample the RC rise at the V ADC rate until the link is a few time constants along
+    uint32_t startUs = 100000;
+    uint32_t elapsedUs = 0;
+    for(elapsedUs = 0; elapsedUs < 300000; elapsedUs += PACK_VOLTAGE_CONVERSION_TIME_US)
+    {
+        updatePrechargeState(packVoltage, prechargeLinkVoltage(packVoltage, timeConstantS, elapsedUs), startUs + elapsedUs);
+    }
+    CHECK(prechargeState == PRECHARGE_ACTIVE);
+
+    // The log fit recovers the time constant and the time left to the complete threshold
+    float linkVoltage = prechargeLinkVoltage(packVoltage, timeConstantS, elapsedUs - PACK_VOLTAGE_CONVERSION_TIME_US);
+    float expectedRemainingS = timeConstantS * logf((packVoltage - linkVoltage) / ((1.0f - PRECHARGE_COMPLETE_RATIO) * packVoltage));
+    CHECK_FLOAT(prechargeTimeConstantS, timeConstantS, 0.01f * timeConstantS);
+    CHECK_FLOAT(prechargeTimeRemainingS, expectedRemainingS, 0.005f);
+
+    // The complete event is latched on the first sample past the threshold
+    uint32_t completeTimeUs = 0;
+    uint32_t completeCount = getPrechargeCompleteCount(&completeTimeUs);
+    for(; prechargeState == PRECHARGE_ACTIVE; elapsedUs += PACK_VOLTAGE_CONVERSION_TIME_US)
+    {
+        updatePrechargeState(packVoltage, prechargeLinkVoltage(packVoltage, timeConstantS, elapsedUs), startUs + elapsedUs);
+    }
+    uint32_t expectedCompleteUs = (uint32_t)(-timeConstantS * logf(1.0f - PRECHARGE_COMPLETE_RATIO) * MICROSECONDS_IN_SECOND);
+    CHECK(prechargeState == PRECHARGE_COMPLETE);
+    CHECK(getPrechargeCompleteCount(&completeTimeUs) == completeCount + 1);
+    CHECK((completeTimeUs - startUs) >= expectedCompleteUs);
+    CHECK((completeTimeUs - startUs) <= (expectedCompleteUs + PACK_VOLTAGE_CONVERSION_TIME_US));
+    CHECK_FLOAT(prechargeTimeRemainingS, 0.0f, 0.0f);
+}
+
+static void testPrechargeStateMachine()
+{
+    resetTelemetry();
+    float packVoltage = 400.0f;
+
+    // Nothing arms without a valid pack or with a link that is already up
+    updatePrechargeState(PRECHARGE_MIN_PACK_VOLTAGE_V, 0.0f, 0);
+    CHECK(prechargeState == PRECHARGE_IDLE);
+    updatePrechargeState(packVoltage, 0.6f * packVoltage, 0);
+    CHECK(prechargeState == PRECHARGE_IDLE);
+
+    // Losing the pack while armed drops back to idle
+    updatePrechargeState(packVoltage, 0.0f, 0);
+    CHECK(prechargeState == PRECHARGE_ARMED);
+    updatePrechargeState(0.0f, 0.0f, 0);
+    CHECK(prechargeState == PRECHARGE_IDLE);
+
+    // A rise under the start threshold is not a precharge
+    updatePrechargeState(packVoltage, 0.0f, 0);
+    updatePrechargeState(packVoltage, PRECHARGE_START_RISE_V - 1.0f, 1000);
+    CHECK(prechargeState == PRECHARGE_ARMED);
+
+    // A precharge that stalls re-arms after the timeout from the stalled link voltage
+    updatePrechargeState(packVoltage, 50.0f, 2000);
+    CHECK(prechargeState == PRECHARGE_ACTIVE);
+    updatePrechargeState(packVoltage, 60.0f, 2000 + PRECHARGE_TIMEOUT_US);
+    CHECK(prechargeState == PRECHARGE_ACTIVE);
+    updatePrechargeState(packVoltage, 60.0f, 3000 + PRECHARGE_TIMEOUT_US);
+    CHECK(prechargeState == PRECHARGE_ARMED);
+    CHECK_FLOAT(prechargeBaselineVoltage, 60.0f, 0.0f);
+
+    // A link that drops back under the baseline mid precharge was opened again
+    updatePrechargeState(packVoltage, 100.0f, 4000 + PRECHARGE_TIMEOUT_US);
+    CHECK(prechargeState == PRECHARGE_ACTIVE);
+    updatePrechargeState(packVoltage, 20.0f, 5000 + PRECHARGE_TIMEOUT_US);
+    CHECK(prechargeState == PRECHARGE_ARMED);
+
+    // A completed precharge re-arms once the link has discharged again
+    updatePrechargeState(packVoltage, 100.0f, 6000 + PRECHARGE_TIMEOUT_US);
+    updatePrechargeState(packVoltage, PRECHARGE_COMPLETE_RATIO * packVoltage, 7000 + PRECHARGE_TIMEOUT_US);
+    CHECK(prechargeState == PRECHARGE_COMPLETE);
+    updatePrechargeState(packVoltage, packVoltage, 8000 + PRECHARGE_TIMEOUT_US);
+    CHECK(prechargeState == PRECHARGE_COMPLETE);
+    updatePrechargeState(packVoltage, 0.0f, 9000 + PRECHARGE_TIMEOUT_US);
+    CHECK(prechargeState == PRECHARGE_ARMED);
+}
+
+static void testPrechargeLinkConversionVerified()
+{
+    resetTelemetry();
+    uint16_t linkConversion = (uint16_t)(ADV | PACK_V2_V4_V6);
+    uint32_t sampleTimeUs = 10 * PACK_VOLTAGE_CONVERSION_TIME_US;
+    htim5.counter = sampleTimeUs;
+
+    // The restart is held off while the all channel conversion can still be running
+    packVoltageStartTimeUs = sampleTimeUs - (PACK_VOLTAGE_CONVERSION_TIME_US / 2);
+    CHECK(samplePrechargeVoltages(sampleTimeUs) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(linkConversion) == 0);
+
+    // A counter mismatch on the read right after the ADV sends it again
+    packVoltageStartTimeUs = 0;
+    counterErrorCommand = linkConversion;
+    counterErrorsLeft = 1;
+    chainModel.commandHook = injectCounterErrors;
+    CHECK(samplePrechargeVoltages(sampleTimeUs) == TRANSACTION_SUCCESS);
+    CHECK(chainModelCommandCount(linkConversion) == 2);
+    CHECK(chainModelCommandCount(RSTCC) == 1);
+    CHECK(packVoltageStartTimeUs == sampleTimeUs);
+
+    // A second loss in a row is left to the next read cycle
+    sampleTimeUs += PRECHARGE_IDLE_PERIOD_US;
+    htim5.counter = sampleTimeUs;
+    counterErrorsLeft = LINK_CONVERSION_ATTEMPTS;
+    CHECK(samplePrechargeVoltages(sampleTimeUs) == TRANSACTION_COMMAND_COUNTER_ERROR);
+    CHECK(chainModelCommandCount(linkConversion) == 2 + LINK_CONVERSION_ATTEMPTS);
+
+    chainModel.commandHook = NULL;
+}
+
+// One telemetry cycle of rate controller input at the given pack current
+static void runTelemetryRate(float packCurrentA)
+{
+    taskData.packMonitor.packCurrent = packCurrentA;
+    taskData.packMonitor.peakPackCurrent = packCurrentA;
+    taskData.packMonitor.currentSampleTimeUs += getTelemetryPeriodMs() * MICROSECONDS_IN_MILLISECOND;
+    updateTelemetryRate(&taskData);
+}
+
+static void testTelemetryRateHysteresis()
+{
+    resetTelemetry();
+    taskData.packMonitor.packVoltage = 500.0f;
+    taskData.maxCellVoltage = 0.5f * (MAX_BRICK_WARNING_VOLTAGE + MIN_BRICK_WARNING_VOLTAGE);
+    taskData.minCellVoltage = taskData.maxCellVoltage;
+    taskData.maxCellTemp = 25.0f;
+
+    // Rest has to hold for the qualify count before each step down
+    for(uint32_t i = 0; i < (REST_QUALIFY_CYCLES - 1); i++)
+    {
+        runTelemetryRate(0.0f);
+    }
+    CHECK(telemetryRateLevel == 0);
+    runTelemetryRate(0.0f);
+    CHECK(telemetryRateLevel == 1);
+    CHECK(taskData.telemetryPeriodMs == (TELEMETRY_TASK_PERIOD_MS << 1));
+
+    // Between the thresholds the rate holds and the rest count starts over
+    for(uint32_t i = 0; i < (REST_QUALIFY_CYCLES - 1); i++)
+    {
+        runTelemetryRate(0.0f);
+    }
+    runTelemetryRate(0.5f * (REST_CURRENT_THRES_A + ACTIVITY_CURRENT_THRES_A));
+    CHECK(telemetryRateLevel == 1);
+    runTelemetryRate(0.0f);
+    CHECK(telemetryRateLevel == 1);
+
+    // The rate never drops below the slowest level, and the wake delay cap stretches with it
+    for(uint32_t i = 0; i < ((TELEMETRY_RATE_MAX_LEVEL + 2) * REST_QUALIFY_CYCLES); i++)
+    {
+        runTelemetryRate(0.0f);
+    }
+    CHECK(telemetryRateLevel == TELEMETRY_RATE_MAX_LEVEL);
+    CHECK(taskData.telemetryPeriodMs == (TELEMETRY_TASK_PERIOD_MS << TELEMETRY_RATE_MAX_LEVEL));
+
+    // A pack voltage slewing while the current rests is activity too
+    taskData.packMonitor.packVoltage += 2.0f * ACTIVITY_PACK_DVDT_THRES_V_S * (getTelemetryPeriodMs() / 1000.0f);
+    runTelemetryRate(0.0f);
+    CHECK(telemetryRateLevel == 0);
+
+    // Activity returns to full rate at once
+    for(uint32_t i = 0; i < REST_QUALIFY_CYCLES; i++)
+    {
+        runTelemetryRate(0.0f);
+    }
+    CHECK(telemetryRateLevel == 1);
+    runTelemetryRate(-2.0f * ACTIVITY_CURRENT_THRES_A);
+    CHECK(telemetryRateLevel == 0);
+    CHECK(taskData.telemetryPeriodMs == TELEMETRY_TASK_PERIOD_MS);
+}
+
+/* ==================================================================== */
+/* =================== GLOBAL FUNCTION DEFINITIONS ==================== */
+/* ==================================================================== */
+
+int main(void)
+{
+    RUN_TEST(testPersistentAdcMismatchMarksCellBad);
+    RUN_TEST(testTransientAdcMismatchIgnored);
+    RUN_TEST(testRateGroupPhasing);
+    RUN_TEST(testDiagnosticSliceResume);
+    RUN_TEST(testCellOpenWireAssembly);
+    RUN_TEST(testAuxOpenWireAssembly);
+    RUN_TEST(testWakePrediction);
+    RUN_TEST(testHardwareThresholdEncoding);
+    RUN_TEST(testCellOvUvFlagDecoding);
+    RUN_TEST(testHardwareOvervoltageAlertLatency);
+    RUN_TEST(testOvercurrentThresholdEncoding);
+    RUN_TEST(testOvercurrentFaultPoll);
+    RUN_TEST(testDischargeNeed);
+    RUN_TEST(testPlanSizedToSmallestNeed);
+    RUN_TEST(testFailedPlanWriteRetried);
+    RUN_TEST(testConfigBVerifiedBetweenPlans);
+    RUN_TEST(testIdleReadsAveragedWindow);
+    RUN_TEST(testRetryResumesAtCheckpoint);
+    RUN_TEST(testRetryLimit);
+    RUN_TEST(testFailedReadKeepsLastGoodData);
+    RUN_TEST(testBalancingSettleOverlap);
+    RUN_TEST(testCurrentSamplesInOrder);
+    RUN_TEST(testCurrentSamplesLappedReader);
+    RUN_TEST(testCurrentSamplesIndexWrap);
+    RUN_TEST(testCurrentSampleGrid);
+    RUN_TEST(testCurrentAtTime);
+    RUN_TEST(testConversionEndTime);
+    RUN_TEST(testAlternateTemperatureSequence);
+    RUN_TEST(testGovernorDeferral);
+    RUN_TEST(testGovernorCycle);
+    RUN_TEST(testBlockCostEstimate);
+    RUN_TEST(testConversionFitOutliers);
+    RUN_TEST(testCurrentFusionAgreeing);
+    RUN_TEST(testCurrentFusionTieBreak);
+    RUN_TEST(testCurrentFusionWithinReferenceResolution);
+    RUN_TEST(testCurrentFusionNoiseAndDrift);
+    RUN_TEST(testShuntThermalStepResponse);
+    RUN_TEST(testPrechargeFit);
+    RUN_TEST(testPrechargeStateMachine);
+    RUN_TEST(testPrechargeLinkConversionVerified);
+    RUN_TEST(testTelemetryRateHysteresis);
+
+    return (numTestFailures == 0) ? 0 : 1;
+}
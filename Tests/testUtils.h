@@ -0,0 +1,46 @@
+#ifndef TESTS_TEST_UTILS_H_
+#define TESTS_TEST_UTILS_H_
+
+/* ==================================================================== */
+/* ============================= INCLUDES ============================= */
+/* ==================================================================== */
+
+#include <stdio.h>
+#include <math.h>
+
+/* ==================================================================== */
+/* ============================== MACROS ============================== */
+/* ==================================================================== */
+
+// Failed checks are counted and reported, the test keeps running so one run shows every failure
+extern int numTestFailures;
+
+#define CHECK(condition) \
+    do \
+    { \
+        if(!(condition)) \
+        { \
+            printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            numTestFailures++; \
+        } \
+    } while(0)
+
+#define CHECK_FLOAT(actual, expected, tolerance) \
+    do \
+    { \
+        if(fabsf((float)(actual) - (float)(expected)) > (tolerance)) \
+        { \
+            printf("%s:%d: CHECK_FLOAT failed: %s = %f, expected %f\n", __FILE__, __LINE__, #actual, (double)(actual), (double)(expected)); \
+            numTestFailures++; \
+        } \
+    } while(0)
+
+#define RUN_TEST(test) \
+    do \
+    { \
+        int failuresBefore = numTestFailures; \
+        test(); \
+        printf("%s %s\n", (numTestFailures == failuresBefore) ? "PASS" : "FAIL", #test); \
+    } while(0)
+
+#endif /* TESTS_TEST_UTILS_H_ */